@@ -107,6 +107,17 @@ CONF_mString(process_full_gc_size, "20%");
 // If false, cancel query when the memory used exceeds exec_mem_limit, same as before.
 CONF_mBool(enable_query_memroy_overcommit, "true");
 
+// If true, sort, aggregation and scanners reserve memory from their query, workload group and
+// the process before using it, and spill or shrink instead when the reservation is denied.
+// Memtables of loads reserve from the process and are flushed early when denied.
+CONF_Bool(enable_mem_reservation, "false");
+// The memory which can be reserved by all queries, a percentage of the process memory limit
+// or an absolute size.
+CONF_String(mem_reservation_limit, "60%");
+// Workload groups may reserve more than their fair shares, which are proportional to their
+// cpu shares, until this percentage of mem_reservation_limit is reserved.
+CONF_mInt32(mem_reservation_fair_share_watermark_percent, "80");
+
 // The maximum time a thread waits for a full GC. Currently only query will wait for full gc.
 CONF_mInt32(thread_wait_gc_max_milliseconds, "1000");
 
@@ -162,6 +173,8 @@ CONF_mInt32(max_download_speed_kbps, "50000");
 CONF_mInt32(download_low_speed_limit_kbps, "50");
 // download low speed time(seconds)
 CONF_mInt32(download_low_speed_time, "300");
+// the max number of files of a tablet downloaded concurrently by clone
+CONF_mInt32(clone_download_files_parallelism, "4");
 // sleep time for one second
 CONF_Int32(sleep_one_second, "1");
 
@@ -235,6 +248,11 @@ CONF_mInt64(column_dictionary_key_ratio_threshold, "0");
 CONF_mInt64(column_dictionary_key_size_threshold, "0");
 // memory_limitation_per_thread_for_schema_change_bytes unit bytes
 CONF_mInt64(memory_limitation_per_thread_for_schema_change_bytes, "2147483648");
+// the max number of sorted runs of a schema change sorted and written concurrently
+CONF_mInt32(schema_change_sort_parallelism, "4");
+// the memory of the blocks held by all sorting schema changes of the BE,
+// could be a percentage of mem_limit or a number of bytes
+CONF_mString(schema_change_sort_mem_limit, "20%");
 CONF_mInt64(memory_limitation_per_thread_for_storage_migration_bytes, "100000000");
 
 // the clean interval of file descriptor cache and segment cache
@@ -269,6 +287,12 @@ CONF_mInt32(trash_file_expire_time_sec, "259200");
 CONF_Int32(min_file_descriptor_number, "60000");
 CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_String(row_cache_mem_limit, "20%");
+// Memory limit of the cache for the output blocks of cacheable sub-plans per tablet, 0 to disable.
+// The cache is only used by the scans of queries with session variable
+// enable_intermediate_result_cache set.
+CONF_String(intermediate_result_cache_mem_limit, "0");
+// The output of a sub-plan on one tablet larger than this is not put into the cache
+CONF_mInt64(intermediate_result_cache_max_entry_bytes, "67108864");
 
 // Cache for storage page size
 CONF_String(storage_page_cache_limit, "20%");
@@ -280,6 +304,12 @@ CONF_Int32(storage_page_cache_shard_size, "16");
 CONF_Int32(index_page_cache_percentage, "10");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "false");
+// Number of threads reading data pages of segments into the storage page cache ahead of
+// segment iterators, 0 means data pages are only read by the scanner threads
+CONF_Int32(segment_page_prefetch_thread_num, "0");
+CONF_Int32(segment_page_prefetch_queue_size, "4096");
+// Max bytes of data pages one segment iterator prefetches ahead of the rows it reads
+CONF_mInt64(segment_page_prefetch_max_bytes, "8388608");
 // whether to disable row cache feature in storage
 CONF_Bool(disable_storage_row_cache, "true");
 
@@ -301,6 +331,13 @@ CONF_mInt32(vertical_compaction_num_columns_per_group, "5");
 CONF_Int32(vertical_compaction_max_row_source_memory_mb, "200");
 // In vertical compaction, max dest segment file size
 CONF_mInt64(vertical_compaction_max_segment_size, "268435456");
+// In vertical compaction, thread number of the pool merging value column groups ahead of
+// the writer, 0 means value column groups are merged one by one in the compaction thread
+CONF_Int32(vertical_compaction_group_merge_threads, "4");
+// In vertical compaction, max value column groups merged concurrently for one compaction
+CONF_mInt32(vertical_compaction_max_parallel_groups, "2");
+// In vertical compaction, max memory of merged blocks buffered for one value column group
+CONF_mInt64(vertical_compaction_group_buffer_bytes, "67108864");
 
 // In ordered data compaction, min segment size for input rowset
 CONF_mInt32(ordered_data_compaction_min_segment_size, "10485760");
@@ -452,6 +489,9 @@ CONF_mInt32(olap_table_sink_send_interval_ms, "1");
 CONF_Int32(fragment_pool_thread_num_min, "64");
 CONF_Int32(fragment_pool_thread_num_max, "512");
 CONF_Int32(fragment_pool_queue_size, "2048");
+// the max number of descriptor tables cached by their digests set by FE (see FE config
+// enable_desc_tbl_digest), 0 to disable the cache
+CONF_Int32(fragment_desc_tbl_cache_capacity, "1024");
 
 // Control the number of disks on the machine.  If 0, this comes from the system settings.
 CONF_Int32(num_disks, "0");
@@ -486,6 +526,10 @@ CONF_Int32(min_chunk_reserved_bytes, "1024");
 // Jemalloc or google tcmalloc have core cache, Chunk Allocator may no longer be needed after replacing
 // gperftools tcmalloc.
 CONF_mBool(disable_chunk_allocator_in_vec, "false");
+// The max bytes of free chunks cached by each thread in front of the Chunk Allocator, which are
+// allocated and freed without contention. The chunks cached by all threads are counted in
+// chunk_reserved_bytes_limit together with the Chunk Allocator. 0 means no thread cache.
+CONF_mInt64(chunk_allocator_thread_cache_bytes, "0");
 
 // The probing algorithm of partitioned hash table.
 // Enable quadratic probing hash table
@@ -629,6 +673,16 @@ CONF_Int64(brpc_socket_max_unwritten_bytes, "1073741824");
 // Controller Attachment and send it through http brpc when the length of the Tuple/Block data
 // is greater than 1.8G. This is to avoid the error of Request length overflow (2G).
 CONF_mBool(transfer_large_data_by_brpc, "false");
+// Whether to send the column values of a broadcasted block as brpc attachment. The attachment
+// is shared by the requests to all receivers, so the column values are not copied into every
+// serialized request.
+CONF_mBool(transfer_broadcast_block_by_attachment, "true");
+// One of every N rows of a hash shuffle is sampled to find the partition keys which take
+// a large share of the rows, they are reported in the profile of the sender. 0 disables it.
+// Skewed keys are only reported, not split across receivers.
+CONF_mInt32(shuffle_skew_sample_interval, "0");
+// Min fraction of the sampled rows for a partition key to be reported as skewed.
+CONF_mDouble(shuffle_skew_key_min_fraction, "0.1");
 
 // max number of txns for every txn_partition_map in txn manager
 // this is a self protection to avoid too many txns saving in manager
@@ -649,6 +703,13 @@ CONF_Int32(txn_shard_size, "1024");
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_load_tablet_failure, "false");
 
+// Number of threads to parse and load tablet metas of each data dir when BE starts.
+CONF_Int32(load_tablet_threads_per_data_dir, "8");
+
+// If true, rowsets of tablets are not created when BE starts. A tablet is initialized when
+// it's accessed for the first time, or by a background thread after BE starts.
+CONF_Bool(lazy_load_tablets, "false");
+
 // Whether to continue to start be when load tablet from header failed.
 CONF_mBool(ignore_rowset_stale_unconsistent_delete, "false");
 
@@ -739,6 +800,9 @@ CONF_mInt32(external_table_connect_timeout_sec, "30");
 
 // Global bitmap cache capacity for aggregation cache, size in bytes
 CONF_Int64(delete_bitmap_agg_cache_capacity, "104857600");
+// Whether to fold the delete bitmap versions of merge-on-write tablets which can no
+// longer be read separately, after stale rowsets are swept.
+CONF_mBool(enable_delete_bitmap_version_fold, "true");
 
 // s3 config
 CONF_mInt32(max_remote_storage_count, "10");
@@ -897,6 +961,11 @@ CONF_Int32(segcompaction_threshold_segment_num, "10");
 // The segment whose row number above the threshold will be compacted during segcompaction
 CONF_Int32(segcompaction_small_threshold, "1048576");
 
+// Pack all segment and inverted index files of a newly written local rowset into one file,
+// if the total size of these files doesn't exceed packed_segment_file_max_bytes.
+CONF_mBool(enable_packed_segment_file, "false");
+CONF_mInt64(packed_segment_file_max_bytes, "67108864");
+
 // enable java udf and jdbc scannode
 CONF_Bool(enable_java_support, "true");
 
@@ -906,6 +975,23 @@ CONF_Bool(enable_fuzzy_mode, "false");
 CONF_Int32(pipeline_executor_size, "0");
 CONF_mInt16(pipeline_short_query_timeout_s, "20");
 
+// Number of threads sorting runs of full sorts in parallel, the number of cores is used if
+// it's not greater than 0.
+CONF_Int32(parallel_sort_thread_num, "0");
+// Buffered rows of a full sort are split into runs of at least this many rows which are
+// sorted in parallel, 0 means runs are always sorted by the query thread.
+CONF_mInt32(parallel_sort_min_rows_per_run, "131072");
+// Number of threads merging and finalizing the aggregate states of partitioned aggregation hash
+// tables in parallel, the number of cores is used if it's not greater than 0.
+CONF_Int32(parallel_agg_thread_num, "0");
+// Blocks merged into a partitioned aggregation hash table are split by sub table into tasks of
+// at least this many rows which merge the states in parallel, and the results are finalized by
+// tasks of a batch each. 0 means the states are always merged and finalized by the query thread.
+CONF_mInt32(parallel_agg_min_rows_per_task, "1024");
+// Sort blocks by multiple columns with radix sort on normalized keys of the leading sort
+// columns, see NormalizedSortKeys.
+CONF_mBool(enable_normalized_key_sort, "true");
+
 // Temp config. True to use optimization for bitmap_index apply predicate except leaf node of the and node.
 // Will remove after fully test.
 CONF_Bool(enable_index_apply_preds_except_leafnode_of_andnode, "true");
@@ -944,6 +1030,11 @@ CONF_Int32(inverted_index_read_buffer_size, "4096");
 CONF_Int32(max_depth_in_bkd_tree, "32");
 // use num_broadcast_buffer blocks as buffer to do broadcast
 CONF_Int32(num_broadcast_buffer, "32");
+// A broadcast hash join whose build side grows over this many bytes on one instance is
+// recorded in the profile and the log, which means the planner misestimated the build side.
+// Without the pipeline engine, the instances of the join on a BE then share one hash table
+// instead of each building a copy. 0 disables the check.
+CONF_mInt64(broadcast_join_build_bytes_threshold, "1073741824");
 // semi-structure configs
 CONF_Bool(enable_parse_multi_dimession_array, "true");
 
@@ -78,6 +78,10 @@ Status SchemaRowsetsScanner::_get_all_rowsets() {
     std::vector<TabletSharedPtr> tablets =
             StorageEngine::instance()->tablet_manager()->get_all_tablet();
     for (const auto& tablet : tablets) {
+        // the tablet may be loaded lazily
+        if (!tablet->init().ok()) {
+            continue;
+        }
         // all rowset
         std::vector<std::pair<Version, RowsetSharedPtr>> all_rowsets;
         {
@@ -17,6 +17,7 @@
 
 #include "http/http_client.h"
 
+#include <fmt/format.h>
 #include <glog/logging.h>
 #include <unistd.h>
 
@@ -24,6 +25,7 @@
 #include <ostream>
 
 #include "common/config.h"
+#include "http/http_status.h"
 #include "util/stack_util.h"
 
 namespace doris {
@@ -176,7 +178,7 @@ Status HttpClient::execute(const std::function<bool(const void* data, size_t len
     return Status::OK();
 }
 
-Status HttpClient::download(const std::string& local_path) {
+Status HttpClient::download(const std::string& local_path, size_t offset) {
     // set method to GET
     set_method(GET);
 
@@ -187,13 +189,34 @@ Status HttpClient::download(const std::string& local_path) {
     curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE, config::max_download_speed_kbps * 1024);
 
     auto fp_closer = [](FILE* fp) { fclose(fp); };
-    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), "w"), fp_closer);
+    std::unique_ptr<FILE, decltype(fp_closer)> fp(
+            fopen(local_path.c_str(), offset > 0 ? "r+" : "w"), fp_closer);
     if (fp == nullptr) {
         LOG(WARNING) << "open file failed, file=" << local_path;
         return Status::InternalError("open file failed");
     }
+    if (offset > 0) {
+        if (ftruncate(fileno(fp.get()), offset) != 0 || fseek(fp.get(), offset, SEEK_SET) != 0) {
+            LOG(WARNING) << "failed to seek file, file=" << local_path << ", offset=" << offset;
+            return Status::InternalError("failed to seek file when download");
+        }
+        // unlike CURLOPT_RESUME_FROM, a range doesn't fail the request if the server ignores
+        // it and sends the whole file
+        curl_easy_setopt(_curl, CURLOPT_RANGE, fmt::format("{}-", offset).c_str());
+    }
     Status status;
-    auto callback = [&status, &fp, &local_path](const void* data, size_t length) {
+    bool range_checked = offset == 0;
+    auto callback = [this, &status, &fp, &local_path, &range_checked](const void* data,
+                                                                       size_t length) {
+        if (!range_checked) {
+            range_checked = true;
+            // the server ignored the range and sends the whole file
+            if (get_http_status() != HttpStatus::PARTIAL_CONTENT &&
+                (ftruncate(fileno(fp.get()), 0) != 0 || fseek(fp.get(), 0, SEEK_SET) != 0)) {
+                status = Status::InternalError("failed to seek file when download");
+                return false;
+            }
+        }
         auto res = fwrite(data, length, 1, fp.get());
         if (res != 1) {
             LOG(WARNING) << "fail to write data to file, file=" << local_path
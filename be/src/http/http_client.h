@@ -128,8 +128,9 @@ public:
     }
 
     // helper function to download a file, you can call this function to download
-    // a file to local_path
-    Status download(const std::string& local_path);
+    // a file to local_path. If offset > 0, the download resumes from offset, the first
+    // offset bytes of local_path are kept if the server sends the rest of the file only.
+    Status download(const std::string& local_path, size_t offset = 0);
 
     Status execute_post_request(const std::string& payload, std::string* response);
 
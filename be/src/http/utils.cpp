@@ -18,6 +18,7 @@
 #include "http/utils.h"
 
 #include <fcntl.h>
+#include <fmt/format.h>
 #include <stdint.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -29,6 +30,7 @@
 #include "common/logging.h"
 #include "common/status.h"
 #include "common/utils.h"
+#include "gutil/strings/numbers.h"
 #include "http/http_channel.h"
 #include "http/http_headers.h"
 #include "http/http_method.h"
@@ -120,6 +122,16 @@ std::string get_content_type(const std::string& file_name) {
     return "";
 }
 
+bool parse_range_start(const std::string& range, int64_t* start) {
+    static const std::string prefix = "bytes=";
+    if (range.size() <= prefix.size() + 1 || range.compare(0, prefix.size(), prefix) != 0 ||
+        range.back() != '-') {
+        return false;
+    }
+    std::string value = range.substr(prefix.size(), range.size() - prefix.size() - 1);
+    return safe_strto64(value, start) && *start >= 0;
+}
+
 void do_file_response(const std::string& file_path, HttpRequest* req) {
     if (file_path.find("..") != std::string::npos) {
         LOG(WARNING) << "Not allowed to read relative path: " << file_path;
@@ -146,12 +158,6 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
     int64_t file_size = st.st_size;
 
     // TODO(lingbin): process "IF_MODIFIED_SINCE" header
-    // TODO(lingbin): process "RANGE" header
-    const std::string& range_header = req->header(HttpHeaders::RANGE);
-    if (!range_header.empty()) {
-        // analyse range header
-    }
-
     req->add_output_header(HttpHeaders::CONTENT_TYPE, get_content_type(file_path).c_str());
 
     if (req->method() == HttpMethod::HEAD) {
@@ -161,6 +167,25 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
         return;
     }
 
+    // send the rest of the file for a resumed download, other ranges are ignored and the
+    // whole file is sent
+    int64_t start = 0;
+    const std::string& range_header = req->header(HttpHeaders::RANGE);
+    if (!range_header.empty() && parse_range_start(range_header, &start)) {
+        if (start >= file_size) {
+            close(fd);
+            req->add_output_header(HttpHeaders::CONTENT_RANGE,
+                                   fmt::format("bytes */{}", file_size).c_str());
+            HttpChannel::send_error(req, HttpStatus::REQUESTED_RANGE_NOT_SATISFIED);
+            return;
+        }
+        req->add_output_header(
+                HttpHeaders::CONTENT_RANGE,
+                fmt::format("bytes {}-{}/{}", start, file_size - 1, file_size).c_str());
+        HttpChannel::send_file(req, fd, start, file_size - start, HttpStatus::PARTIAL_CONTENT);
+        return;
+    }
+
     HttpChannel::send_file(req, fd, 0, file_size);
 }
 
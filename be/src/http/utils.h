@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <string>
 
 #include "common/utils.h"
@@ -34,6 +36,10 @@ bool parse_basic_auth(const HttpRequest& req, std::string* user, std::string* pa
 
 bool parse_basic_auth(const HttpRequest& req, AuthInfo* auth);
 
+// parse a range header of the form "bytes=<start>-", which is sent by a resumed download.
+// return false for other forms of ranges.
+bool parse_range_start(const std::string& range, int64_t* start);
+
 void do_file_response(const std::string& dir_path, HttpRequest* req);
 
 void do_dir_response(const std::string& dir_path, HttpRequest* req);
@@ -179,11 +179,17 @@ Status StreamLoadPipe::_read_next_buffer(std::unique_ptr<uint8_t[]>* data, size_
         return Status::OK();
     }
     auto buf = _buf_queue.front();
-    *length = buf->remaining();
-    data->reset(new uint8_t[*length]);
-    buf->get_bytes((char*)(data->get()), *length);
     _buf_queue.pop_front();
     _buffered_bytes -= buf->limit;
+    *length = buf->remaining();
+    if (buf->pos == 0 && buf.use_count() == 1) {
+        // a whole buffer only referenced by the pipe, e.g. a kafka message, hand it over to
+        // the reader instead of copying it
+        *data = buf->release();
+    } else {
+        data->reset(new uint8_t[*length]);
+        buf->get_bytes((char*)(data->get()), *length);
+    }
     if (_use_proto) {
         auto row_ptr = std::move(_data_row_ptrs.front());
         _proto_buffered_bytes -= (sizeof(PDataRow*) + row_ptr->GetCachedSize());
@@ -22,11 +22,14 @@
 #include <gen_cpp/olap_file.pb.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <atomic>
 // IWYU pragma: no_include <bits/chrono.h>
 #include <chrono> // IWYU pragma: keep
 #include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <set>
 #include <sstream>
@@ -59,7 +62,9 @@
 #include "olap/utils.h" // for check_dir_existed
 #include "service/backend_options.h"
 #include "util/doris_metrics.h"
+#include "util/stopwatch.hpp"
 #include "util/string_util.h"
+#include "util/threadpool.h"
 #include "util/uid_util.h"
 
 using strings::Substitute;
@@ -365,22 +370,42 @@ Status DataDir::load() {
     // necessarily check incompatible old format. when there are old metas, it may load to data missing
     _check_incompatible_old_format_tablet();
 
+    // rowset metas are parsed and tablets are loaded on a thread pool, the meta env is
+    // still traversed by this thread
+    int num_threads = std::max(config::load_tablet_threads_per_data_dir, 1);
+    std::unique_ptr<ThreadPool> load_pool;
+    ThreadPoolBuilder("LoadTabletThreadPool")
+            .set_min_threads(num_threads)
+            .set_max_threads(num_threads)
+            .build(&load_pool);
+    auto run_load_task = [&load_pool](std::function<void()>&& task) {
+        if (load_pool == nullptr || !load_pool->submit_func(task).ok()) {
+            task();
+        }
+    };
+    MonotonicStopWatch watch;
+    watch.start();
+
+    std::mutex load_lock;
     std::vector<RowsetMetaSharedPtr> dir_rowset_metas;
     LOG(INFO) << "begin loading rowset from meta";
-    auto load_rowset_func = [&dir_rowset_metas, &local_fs = fs()](
+    auto load_rowset_func = [&dir_rowset_metas, &load_lock, &run_load_task, &local_fs = fs()](
                                     TabletUid tablet_uid, RowsetId rowset_id,
                                     const std::string& meta_str) -> bool {
-        RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
-        bool parsed = rowset_meta->init(meta_str);
-        if (!parsed) {
-            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
-            // return false will break meta iterator, return true to skip this error
-            return true;
-        }
-        if (rowset_meta->is_local()) {
-            rowset_meta->set_fs(local_fs);
-        }
-        dir_rowset_metas.push_back(rowset_meta);
+        run_load_task([&dir_rowset_metas, &load_lock, &local_fs, rowset_id, meta_str]() {
+            RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
+            bool parsed = rowset_meta->init(meta_str);
+            if (!parsed) {
+                LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
+                // skip this error
+                return;
+            }
+            if (rowset_meta->is_local()) {
+                rowset_meta->set_fs(local_fs);
+            }
+            std::lock_guard l(load_lock);
+            dir_rowset_metas.push_back(rowset_meta);
+        });
         return true;
     };
     Status load_rowset_status = RowsetMetaManager::traverse_rowset_metas(_meta, load_rowset_func);
@@ -396,36 +421,45 @@ Status DataDir::load() {
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](
+    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids, &load_lock, &run_load_task](
                                     int64_t tablet_id, int32_t schema_hash,
                                     const std::string& value) -> bool {
-        Status status = _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value,
-                                                               false, false, false, false);
-        if (!status.ok() && !status.is<TABLE_ALREADY_DELETED_ERROR>() &&
-            !status.is<ENGINE_INSERT_OLD_TABLET>()) {
-            // load_tablet_from_meta() may return Status::Error<TABLE_ALREADY_DELETED_ERROR>()
-            // which means the tablet status is DELETED
-            // This may happen when the tablet was just deleted before the BE restarted,
-            // but it has not been cleared from rocksdb. At this time, restarting the BE
-            // will read the tablet in the DELETE state from rocksdb. These tablets have been
-            // added to the garbage collection queue and will be automatically deleted afterwards.
-            // Therefore, we believe that this situation is not a failure.
-
-            // Besides, load_tablet_from_meta() may return Status::Error<ENGINE_INSERT_OLD_TABLET>()
-            // when BE is restarting and the older tablet have been added to the
-            // garbage collection queue but not deleted yet.
-            // In this case, since the data_dirs are parallel loaded, a later loaded tablet
-            // may be older than previously loaded one, which should not be acknowledged as a
-            // failure.
-            LOG(WARNING) << "load tablet from header failed. status:" << status
-                         << ", tablet=" << tablet_id << "." << schema_hash;
-            failed_tablet_ids.insert(tablet_id);
-        } else {
-            tablet_ids.insert(tablet_id);
-        }
+        run_load_task([this, &tablet_ids, &failed_tablet_ids, &load_lock, tablet_id, schema_hash,
+                       value]() {
+            Status status = _tablet_manager->load_tablet_from_meta(
+                    this, tablet_id, schema_hash, value, false, false, false, false,
+                    config::lazy_load_tablets);
+            std::lock_guard l(load_lock);
+            if (!status.ok() && !status.is<TABLE_ALREADY_DELETED_ERROR>() &&
+                !status.is<ENGINE_INSERT_OLD_TABLET>()) {
+                // load_tablet_from_meta() may return Status::Error<TABLE_ALREADY_DELETED_ERROR>()
+                // which means the tablet status is DELETED
+                // This may happen when the tablet was just deleted before the BE restarted,
+                // but it has not been cleared from rocksdb. At this time, restarting the BE
+                // will read the tablet in the DELETE state from rocksdb. These tablets have been
+                // added to the garbage collection queue and will be automatically deleted afterwards.
+                // Therefore, we believe that this situation is not a failure.
+
+                // Besides, load_tablet_from_meta() may return Status::Error<ENGINE_INSERT_OLD_TABLET>()
+                // when BE is restarting and the older tablet have been added to the
+                // garbage collection queue but not deleted yet.
+                // In this case, since the data_dirs are parallel loaded, a later loaded tablet
+                // may be older than previously loaded one, which should not be acknowledged as a
+                // failure.
+                LOG(WARNING) << "load tablet from header failed. status:" << status
+                             << ", tablet=" << tablet_id << "." << schema_hash;
+                failed_tablet_ids.insert(tablet_id);
+            } else {
+                tablet_ids.insert(tablet_id);
+            }
+        });
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    if (load_pool != nullptr) {
+        load_pool->wait();
+    }
+    int64_t load_meta_ns = watch.elapsed_time();
     if (failed_tablet_ids.size() != 0) {
         LOG(WARNING) << "load tablets from header failed"
                      << ", loaded tablet: " << tablet_ids.size()
@@ -444,13 +478,17 @@ Status DataDir::load() {
                   << ", error tablet: " << failed_tablet_ids.size() << ", path: " << _path;
     }
 
-    for (int64_t tablet_id : tablet_ids) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id);
-        if (tablet && tablet->set_tablet_schema_into_rowset_meta()) {
+    // get_tablet() initializes lazily loaded tablets, which is not needed here
+    auto loaded_tablets = _tablet_manager->get_all_tablet([this, &tablet_ids](Tablet* t) {
+        return t->data_dir() == this && tablet_ids.count(t->tablet_id()) > 0;
+    });
+    for (auto& tablet : loaded_tablets) {
+        if (tablet->set_tablet_schema_into_rowset_meta()) {
             TabletMetaManager::save(this, tablet->tablet_id(), tablet->schema_hash(),
                                     tablet->tablet_meta());
         }
     }
+    int64_t save_schema_ns = watch.elapsed_time() - load_meta_ns;
 
     // traverse rowset
     // 1. add committed rowset to txn map
@@ -458,7 +496,8 @@ Status DataDir::load() {
     // ignore any errors when load tablet or rowset, because fe will repair them after report
     int64_t invalid_rowset_counter = 0;
     for (auto rowset_meta : dir_rowset_metas) {
-        TabletSharedPtr tablet = _tablet_manager->get_tablet(rowset_meta->tablet_id());
+        // don't init lazily loaded tablets, their visible rowsets are added once they're inited
+        TabletSharedPtr tablet = _tablet_manager->get_tablet_without_init(rowset_meta->tablet_id());
         // tablet maybe dropped, but not drop related rowset meta
         if (tablet == nullptr) {
             VLOG_NOTICE << "could not find tablet id: " << rowset_meta->tablet_id()
@@ -505,7 +544,7 @@ Status DataDir::load() {
                 RowsetMetaManager::save(_meta, rowset_meta->tablet_uid(), rowset_meta->rowset_id(),
                                         rowset_meta->get_rowset_pb());
             }
-            Status publish_status = tablet->add_rowset(rowset);
+            Status publish_status = tablet->add_rowset_on_load(rowset);
             if (!publish_status && !publish_status.is<PUSH_VERSION_ALREADY_EXIST>()) {
                 LOG(WARNING) << "add visible rowset to tablet failed rowset_id:"
                              << rowset->rowset_id() << " tablet id: " << rowset_meta->tablet_id()
@@ -527,9 +566,14 @@ Status DataDir::load() {
     // At startup, we only count these invalid rowset, but do not actually delete it.
     // The actual delete operation is in StorageEngine::_clean_unused_rowset_metas,
     // which is cleaned up uniformly by the background cleanup thread.
+    int64_t load_rowset_ns = watch.elapsed_time() - load_meta_ns - save_schema_ns;
     LOG(INFO) << "finish to load tablets from " << _path
               << ", total rowset meta: " << dir_rowset_metas.size()
-              << ", invalid rowset num: " << invalid_rowset_counter;
+              << ", invalid rowset num: " << invalid_rowset_counter
+              << ", lazy: " << config::lazy_load_tablets
+              << ", load meta cost(ms): " << load_meta_ns / 1000000
+              << ", save schema cost(ms): " << save_schema_ns / 1000000
+              << ", load rowset cost(ms): " << load_rowset_ns / 1000000;
 
     return Status::OK();
 }
@@ -867,6 +911,8 @@ void DataDir::perform_remote_rowset_gc() {
         for (int i = 0; i < gc_pb.num_segments(); ++i) {
             seg_paths.push_back(BetaRowset::remote_segment_path(gc_pb.tablet_id(), rowset_id, i));
         }
+        // the rowset may be uploaded as a packed segment file
+        seg_paths.push_back(BetaRowset::remote_packed_file_path(gc_pb.tablet_id(), rowset_id));
         LOG(INFO) << "delete remote rowset. root_path=" << fs->root_path()
                   << ", rowset_id=" << rowset_id;
         auto st = std::static_pointer_cast<io::RemoteFileSystem>(fs)->batch_delete(seg_paths);
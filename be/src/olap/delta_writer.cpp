@@ -53,6 +53,7 @@
 #include "olap/txn_manager.h"
 #include "runtime/exec_env.h"
 #include "runtime/load_channel_mgr.h"
+#include "runtime/memory/mem_reservation.h"
 #include "runtime/memory/mem_tracker.h"
 #include "service/backend_options.h"
 #include "util/brpc_client_cache.h"
@@ -64,6 +65,10 @@
 namespace doris {
 using namespace ErrorCode;
 
+// a denied reservation does not flush a memtable smaller than this, which would only make
+// tiny segments
+static constexpr int64_t MIN_FLUSH_MEMTABLE_BYTES = 1024 * 1024;
+
 Status DeltaWriter::open(WriteRequest* req, DeltaWriter** writer, const UniqueId& load_id) {
     *writer = new DeltaWriter(req, StorageEngine::instance(), load_id);
     return Status::OK();
@@ -189,6 +194,7 @@ Status DeltaWriter::init() {
     bool should_serial = _tablet->keys_type() == KeysType::UNIQUE_KEYS;
     RETURN_NOT_OK(_storage_engine->memtable_flush_executor()->create_flush_token(
             &_flush_token, _rowset_writer->type(), should_serial, _req.is_high_priority));
+    _mem_reservation.init(MemReservation::process_reservation(), nullptr);
 
     _is_init = true;
     return Status::OK();
@@ -228,7 +234,10 @@ Status DeltaWriter::write(const vectorized::Block* block, const std::vector<int>
     if (UNLIKELY(_mem_table->need_agg())) {
         _mem_table->shrink_memtable_by_agg();
     }
-    if (UNLIKELY(_mem_table->need_flush())) {
+    // the memtables being flushed are counted too, they are released when the flush finishes
+    bool reservation_denied = !_mem_reservation.reserve_to(mem_consumption(MemType::ALL)) &&
+                              _mem_table->memory_usage() >= MIN_FLUSH_MEMTABLE_BYTES;
+    if (UNLIKELY(_mem_table->need_flush() || reservation_denied)) {
         auto s = _flush_memtable_async();
         _reset_mem_table();
         if (UNLIKELY(!s.ok())) {
@@ -371,6 +380,7 @@ Status DeltaWriter::close_wait(const PSlaveTabletNodes& slave_tablet_nodes,
     uint64_t wait_time_ns = timer.elapsed_time();
 
     _mem_table.reset();
+    _mem_reservation.reserve_to(0);
 
     if (_rowset_writer->num_rows() + _merged_rows != _total_received_rows) {
         LOG(WARNING) << "the rows number written doesn't match, rowset num rows written to file: "
@@ -459,6 +469,7 @@ Status DeltaWriter::cancel_with_status(const Status& st) {
         // cancel and wait all memtables in flush queue to be finished
         _flush_token->cancel();
     }
+    _mem_reservation.reserve_to(0);
     _is_cancelled = true;
     _cancel_status = st;
     return Status::OK();
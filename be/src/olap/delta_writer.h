@@ -35,6 +35,7 @@
 #include "olap/tablet.h"
 #include "olap/tablet_meta.h"
 #include "olap/tablet_schema.h"
+#include "runtime/memory/mem_reservation.h"
 #include "util/spinlock.h"
 #include "util/uid_util.h"
 
@@ -174,6 +175,8 @@ private:
     std::vector<std::shared_ptr<MemTracker>> _mem_table_flush_trackers;
     SpinLock _mem_table_tracker_lock;
     std::atomic<uint32_t> _mem_table_num = 1;
+    // memory of the memtables reserved from the process, a denial flushes the memtable early
+    OperatorMemReservation _mem_reservation;
 
     std::mutex _lock;
 
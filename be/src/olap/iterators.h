@@ -23,6 +23,7 @@
 #include "io/io_common.h"
 #include "olap/block_column_predicate.h"
 #include "olap/column_predicate.h"
+#include "olap/late_arrival_predicates.h"
 #include "olap/olap_common.h"
 #include "olap/tablet_schema.h"
 #include "runtime/runtime_state.h"
@@ -95,6 +96,9 @@ public:
     bool record_rowids = false;
     // flag for enable topn opt
     bool use_topn_opt = false;
+    // predicates of runtime filters arrived after the scan started, used to prune rows
+    // not read yet
+    LateArrivalPredicatesSPtr late_arrival_predicates;
     // used for special optimization for query : ORDER BY key DESC LIMIT n
     bool read_orderby_key_reverse = false;
     // columns for orderby keys
@@ -0,0 +1,64 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "olap/column_predicate.h"
+
+namespace doris {
+
+// Column predicates built from runtime filters which arrive after a scan has started.
+// The scanner appends predicates while segment iterators of the same reader are reading,
+// the segment iterators pick up the new ones between batches and use them to prune the
+// rows they have not read yet.
+class LateArrivalPredicates {
+public:
+    // take the ownership of predicates
+    void append(const std::vector<ColumnPredicate*>& predicates) {
+        std::lock_guard l(_lock);
+        for (auto* predicate : predicates) {
+            _predicates.emplace_back(predicate);
+        }
+        _size.store(_predicates.size(), std::memory_order_release);
+    }
+
+    size_t size() const { return _size.load(std::memory_order_acquire); }
+
+    // Get predicates appended after the first `start` ones, return the number of
+    // predicates appended so far.
+    size_t get(size_t start, std::vector<const ColumnPredicate*>* predicates) const {
+        std::lock_guard l(_lock);
+        for (size_t i = start; i < _predicates.size(); ++i) {
+            predicates->push_back(_predicates[i].get());
+        }
+        return _predicates.size();
+    }
+
+private:
+    mutable std::mutex _lock;
+    std::vector<std::unique_ptr<ColumnPredicate>> _predicates;
+    std::atomic<size_t> _size {0};
+};
+
+using LateArrivalPredicatesSPtr = std::shared_ptr<LateArrivalPredicates>;
+
+} // namespace doris
@@ -22,8 +22,11 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <ostream>
 #include <shared_mutex>
@@ -44,7 +47,10 @@
 #include "olap/storage_engine.h"
 #include "olap/tablet.h"
 #include "olap/utils.h"
+#include "runtime/thread_context.h"
+#include "util/defer_op.h"
 #include "util/slice.h"
+#include "util/threadpool.h"
 #include "util/trace.h"
 #include "vec/core/block.h"
 #include "vec/olap/block_reader.h"
@@ -53,6 +59,114 @@
 
 namespace doris {
 
+namespace {
+
+void init_vertical_reader_params(TabletSharedPtr tablet, ReaderType reader_type,
+                                 TabletSchemaSPtr tablet_schema, bool is_key,
+                                 const std::vector<uint32_t>& column_group,
+                                 const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+                                 const Version& version, TabletReader::ReaderParams* reader_params) {
+    reader_params->is_key_column_group = is_key;
+    reader_params->tablet = tablet;
+    reader_params->reader_type = reader_type;
+    reader_params->rs_readers = src_rowset_readers;
+    reader_params->version = version;
+
+    TabletSchemaSPtr merge_tablet_schema = std::make_shared<TabletSchema>();
+    merge_tablet_schema->copy_from(*tablet_schema);
+    {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        auto delete_preds = tablet->delete_predicates();
+        std::copy(delete_preds.cbegin(), delete_preds.cend(),
+                  std::inserter(reader_params->delete_predicates,
+                                reader_params->delete_predicates.begin()));
+
+        for (auto& del_pred_rs : reader_params->delete_predicates) {
+            merge_tablet_schema->merge_dropped_columns(
+                    tablet->tablet_schema(del_pred_rs->version()));
+        }
+    }
+    reader_params->tablet_schema = merge_tablet_schema;
+
+    reader_params->return_columns = column_group;
+    reader_params->origin_return_columns = &reader_params->return_columns;
+}
+
+// State of a value column group merged on the vertical compaction thread pool. The worker
+// pushes merged blocks into `blocks` and the compaction thread pops them and writes them
+// to the rowset writer, so groups are still written in order.
+struct ValueGroupMergeContext {
+    const std::vector<uint32_t>* column_group = nullptr;
+    std::unique_ptr<vectorized::RowSourcesBuffer> row_sources;
+    std::vector<RowsetReaderSharedPtr> rs_readers;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    // merged blocks and their allocated bytes
+    std::deque<std::pair<vectorized::Block, size_t>> blocks;
+    size_t buffered_bytes = 0;
+    bool started = false;
+    bool finished = false;
+    bool cancelled = false;
+    Status status;
+};
+
+void merge_value_group(TabletSharedPtr tablet, ReaderType reader_type,
+                       TabletSchemaSPtr tablet_schema, Version version,
+                       ValueGroupMergeContext* ctx) {
+    {
+        std::lock_guard l(ctx->lock);
+        // the compaction thread has merged this group by itself
+        if (ctx->cancelled) {
+            ctx->finished = true;
+            ctx->cv.notify_all();
+            return;
+        }
+        ctx->started = true;
+    }
+    auto st = [&]() -> Status {
+        vectorized::VerticalBlockReader reader(ctx->row_sources.get());
+        TabletReader::ReaderParams reader_params;
+        init_vertical_reader_params(tablet, reader_type, tablet_schema, false, *ctx->column_group,
+                                    ctx->rs_readers, version, &reader_params);
+        RETURN_NOT_OK(reader.init(reader_params));
+
+        size_t buffer_bytes = config::vertical_compaction_group_buffer_bytes;
+        bool eof = false;
+        while (!eof) {
+            if (StorageEngine::instance()->stopped()) {
+                LOG(INFO) << "tablet " << tablet->full_name()
+                          << " failed to do compaction, engine stopped";
+                return Status::Error<INTERNAL_ERROR>();
+            }
+            vectorized::Block block = tablet_schema->create_block(*ctx->column_group);
+            RETURN_NOT_OK_LOG(reader.next_block_with_aggregation(&block, &eof),
+                              "failed to read next block when merging rowsets of tablet " +
+                                      tablet->full_name());
+            if (block.rows() == 0) {
+                continue;
+            }
+            size_t bytes = block.allocated_bytes();
+            std::unique_lock l(ctx->lock);
+            ctx->cv.wait(l, [&] { return ctx->cancelled || ctx->buffered_bytes < buffer_bytes; });
+            if (ctx->cancelled) {
+                return Status::Cancelled("value column group merge cancelled");
+            }
+            ctx->buffered_bytes += bytes;
+            ctx->blocks.emplace_back(std::move(block), bytes);
+            ctx->cv.notify_all();
+        }
+        return Status::OK();
+    }();
+
+    std::lock_guard l(ctx->lock);
+    ctx->status = st;
+    ctx->finished = true;
+    ctx->cv.notify_all();
+}
+
+} // namespace
+
 Status Merger::vmerge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                               TabletSchemaSPtr cur_tablet_schema,
                               const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
@@ -191,34 +305,13 @@ Status Merger::vertical_compact_one_group(
     VLOG_NOTICE << "vertical compact one group, max_rows_per_segment=" << max_rows_per_segment;
     vectorized::VerticalBlockReader reader(row_source_buf);
     TabletReader::ReaderParams reader_params;
-    reader_params.is_key_column_group = is_key;
-    reader_params.tablet = tablet;
-    reader_params.reader_type = reader_type;
-    reader_params.rs_readers = src_rowset_readers;
-    reader_params.version = dst_rowset_writer->version();
-
-    TabletSchemaSPtr merge_tablet_schema = std::make_shared<TabletSchema>();
-    merge_tablet_schema->copy_from(*tablet_schema);
-    {
-        std::shared_lock rdlock(tablet->get_header_lock());
-        auto delete_preds = tablet->delete_predicates();
-        std::copy(delete_preds.cbegin(), delete_preds.cend(),
-                  std::inserter(reader_params.delete_predicates,
-                                reader_params.delete_predicates.begin()));
-
-        for (auto& del_pred_rs : reader_params.delete_predicates) {
-            merge_tablet_schema->merge_dropped_columns(
-                    tablet->tablet_schema(del_pred_rs->version()));
-        }
-    }
-    reader_params.tablet_schema = merge_tablet_schema;
+    init_vertical_reader_params(tablet, reader_type, tablet_schema, is_key, column_group,
+                                src_rowset_readers, dst_rowset_writer->version(), &reader_params);
 
     if (is_key && stats_output && stats_output->rowid_conversion) {
         reader_params.record_rowids = true;
     }
 
-    reader_params.return_columns = column_group;
-    reader_params.origin_return_columns = &reader_params.return_columns;
     RETURN_NOT_OK(reader.init(reader_params));
 
     if (reader_params.record_rowids) {
@@ -324,10 +417,110 @@ Status Merger::vertical_compact_one_group(TabletSharedPtr tablet, ReaderType rea
     return Status::OK();
 }
 
+// Merge value column groups after the key group. Up to vertical_compaction_max_parallel_groups
+// groups are read and merged at the same time on the vertical compaction thread pool, each
+// with its own row source reader, and the calling thread writes them to the rowset writer one
+// by one. The groups run under the compaction permits held by the compaction, a group which is
+// not started yet is merged by the calling thread when reached.
+Status Merger::vertical_merge_value_groups(
+        TabletSharedPtr tablet, ReaderType reader_type, TabletSchemaSPtr tablet_schema,
+        const std::vector<std::vector<uint32_t>>& column_groups,
+        vectorized::RowSourcesBuffer* row_sources_buf,
+        const std::vector<RowsetReaderSharedPtr>& src_rowset_readers,
+        RowsetWriter* dst_rowset_writer, int64_t max_rows_per_segment, Statistics* stats_output) {
+    ThreadPool* thread_pool = StorageEngine::instance()->vertical_compaction_thread_pool();
+    size_t max_parallel_groups = std::max(config::vertical_compaction_max_parallel_groups, 1);
+
+    // column_groups[0] is the key group which is already compacted
+    size_t num_groups = column_groups.size() - 1;
+    std::vector<std::unique_ptr<ValueGroupMergeContext>> contexts(num_groups);
+    // workers reference the contexts, wait for all of them before returning
+    Defer defer {[&]() {
+        for (auto& ctx : contexts) {
+            if (ctx == nullptr) {
+                continue;
+            }
+            std::unique_lock l(ctx->lock);
+            ctx->cancelled = true;
+            ctx->cv.notify_all();
+            ctx->cv.wait(l, [&] { return ctx->finished; });
+        }
+    }};
+
+    // the workers count their memory to the compaction, like the groups merged by this thread
+    auto mem_tracker = thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker();
+    size_t next_submit = 0;
+    for (size_t i = 0; i < num_groups; ++i) {
+        const auto& column_group = column_groups[i + 1];
+        next_submit = std::max(next_submit, i + 1);
+        while (next_submit < num_groups && next_submit < i + max_parallel_groups) {
+            auto ctx = std::make_unique<ValueGroupMergeContext>();
+            ctx->column_group = &column_groups[next_submit + 1];
+            RETURN_IF_ERROR(row_sources_buf->clone_for_read(&ctx->row_sources));
+            for (auto& rs_reader : src_rowset_readers) {
+                ctx->rs_readers.push_back(rs_reader->clone());
+            }
+            auto st = thread_pool->submit_func([tablet, reader_type, tablet_schema, mem_tracker,
+                                           version = dst_rowset_writer->version(),
+                                           ctx_ptr = ctx.get()]() {
+                SCOPED_ATTACH_TASK(mem_tracker);
+                merge_value_group(tablet, reader_type, tablet_schema, version, ctx_ptr);
+            });
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to submit value column group merge task, tablet="
+                             << tablet->full_name() << ", st=" << st;
+                break;
+            }
+            contexts[next_submit++] = std::move(ctx);
+        }
+
+        auto* ctx = contexts[i].get();
+        bool merge_in_place = (ctx == nullptr);
+        if (ctx != nullptr) {
+            std::lock_guard l(ctx->lock);
+            // the task is still queued, don't wait for it
+            if (!ctx->started) {
+                ctx->cancelled = true;
+                merge_in_place = true;
+            }
+        }
+        if (merge_in_place) {
+            RETURN_IF_ERROR(vertical_compact_one_group(
+                    tablet, reader_type, tablet_schema, false, column_group, row_sources_buf,
+                    src_rowset_readers, dst_rowset_writer, max_rows_per_segment, stats_output));
+            RETURN_IF_ERROR(row_sources_buf->seek_to_begin());
+            continue;
+        }
+
+        while (true) {
+            vectorized::Block block;
+            {
+                std::unique_lock l(ctx->lock);
+                ctx->cv.wait(l, [&] { return !ctx->blocks.empty() || ctx->finished; });
+                if (ctx->blocks.empty()) {
+                    RETURN_IF_ERROR(ctx->status);
+                    break;
+                }
+                block = std::move(ctx->blocks.front().first);
+                ctx->buffered_bytes -= ctx->blocks.front().second;
+                ctx->blocks.pop_front();
+                ctx->cv.notify_all();
+            }
+            RETURN_NOT_OK_LOG(
+                    dst_rowset_writer->add_columns(&block, column_group, false,
+                                                   max_rows_per_segment),
+                    "failed to write block when merging rowsets of tablet " + tablet->full_name());
+        }
+        RETURN_IF_ERROR(dst_rowset_writer->flush_columns(false));
+    }
+    return Status::OK();
+}
+
 // steps to do vertical merge:
 // 1. split columns into column groups
 // 2. compact groups one by one, generate a row_source_buf when compact key group
-// and use this row_source_buf to compact value column groups
+// and use this row_source_buf to compact value column groups, value column groups
+// may be merged in parallel, see vertical_merge_value_groups
 // 3. build output rowset
 Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_type,
                                       TabletSchemaSPtr tablet_schema,
@@ -340,6 +533,9 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
 
     vectorized::RowSourcesBuffer row_sources_buf(tablet->tablet_id(), tablet->tablet_path(),
                                                  reader_type);
+    bool parallel = StorageEngine::instance()->vertical_compaction_thread_pool() != nullptr &&
+                    config::vertical_compaction_max_parallel_groups > 1 &&
+                    column_groups.size() > 2;
     // compact group one by one
     for (auto i = 0; i < column_groups.size(); ++i) {
         VLOG_NOTICE << "row source size: " << row_sources_buf.total_size();
@@ -351,6 +547,12 @@ Status Merger::vertical_merge_rowsets(TabletSharedPtr tablet, ReaderType reader_
             row_sources_buf.flush();
         }
         row_sources_buf.seek_to_begin();
+        if (is_key && parallel) {
+            RETURN_IF_ERROR(vertical_merge_value_groups(
+                    tablet, reader_type, tablet_schema, column_groups, &row_sources_buf,
+                    src_rowset_readers, dst_rowset_writer, max_rows_per_segment, stats_output));
+            break;
+        }
     }
 
     // finish compact, build output rowset
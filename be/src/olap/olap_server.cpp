@@ -76,6 +76,13 @@ using io::Path;
 volatile uint32_t g_schema_change_active_threads = 0;
 
 Status StorageEngine::start_bg_threads() {
+    if (config::lazy_load_tablets) {
+        RETURN_IF_ERROR(Thread::create(
+                "StorageEngine", "tablet_init_thread", [this]() { this->_tablet_init_callback(); },
+                &_tablet_init_thread));
+        LOG(INFO) << "tablet init thread started";
+    }
+
     RETURN_IF_ERROR(Thread::create(
             "StorageEngine", "unused_rowset_monitor_thread",
             [this]() { this->_unused_rowset_monitor_thread_callback(); },
@@ -118,6 +125,12 @@ Status StorageEngine::start_bg_threads() {
             .set_min_threads(config::cold_data_compaction_thread_num)
             .set_max_threads(config::cold_data_compaction_thread_num)
             .build(&_cold_data_compaction_thread_pool);
+    if (config::vertical_compaction_group_merge_threads > 0) {
+        ThreadPoolBuilder("VerticalCompactionGroupThreadPool")
+                .set_min_threads(config::vertical_compaction_group_merge_threads)
+                .set_max_threads(config::vertical_compaction_group_merge_threads)
+                .build(&_vertical_compaction_thread_pool);
+    }
 
     // compaction tasks producer thread
     RETURN_IF_ERROR(Thread::create(
@@ -231,6 +244,14 @@ void StorageEngine::_fd_cache_clean_callback() {
     }
 }
 
+void StorageEngine::_tablet_init_callback() {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    _tablet_manager->init_all_tablets(
+            [this]() { return _stop_background_threads_latch.count() == 0; });
+}
+
 void StorageEngine::_start_clean_lookup_cache() {
     while (!_stop_background_threads_latch.wait_for(
             std::chrono::seconds(config::tablet_lookup_cache_clean_interval))) {
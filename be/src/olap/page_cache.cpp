@@ -19,6 +19,7 @@
 
 #include <glog/logging.h>
 
+#include <functional>
 #include <ostream>
 
 namespace doris {
@@ -78,6 +79,27 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
     *handle = PageCacheHandle(cache, lru_handle);
 }
 
+bool StoragePageCache::begin_read(const CacheKey& key) {
+    std::string encoded_key = key.encode();
+    auto& shard = _inflight_reads[std::hash<std::string>()(encoded_key) % kNumInflightReadShards];
+    std::unique_lock l(shard.lock);
+    if (shard.keys.insert(encoded_key).second) {
+        return true;
+    }
+    shard.cv.wait(l, [&] { return shard.keys.count(encoded_key) == 0; });
+    return false;
+}
+
+void StoragePageCache::end_read(const CacheKey& key) {
+    std::string encoded_key = key.encode();
+    auto& shard = _inflight_reads[std::hash<std::string>()(encoded_key) % kNumInflightReadShards];
+    {
+        std::lock_guard l(shard.lock);
+        shard.keys.erase(encoded_key);
+    }
+    shard.cv.notify_all();
+}
+
 void StoragePageCache::prune(segment_v2::PageTypePB page_type) {
     auto cache = _get_page_cache(page_type);
     cache->prune();
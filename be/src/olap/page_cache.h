@@ -22,8 +22,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 #include "olap/lru_cache.h"
@@ -94,6 +97,19 @@ public:
         return _get_page_cache(page_type) != nullptr;
     }
 
+    // Pages missing in the cache are read by one reader at a time. begin_read() returns true
+    // if the caller should read the page, it must call end_read() once the page is inserted
+    // or the read failed. It returns false after waiting for another reader of the page,
+    // the page should be looked up again then. This keeps a scanner from reading a page
+    // which is being read by the page prefetcher.
+    bool begin_read(const CacheKey& key);
+    void end_read(const CacheKey& key);
+
+    // Whether the readers of data pages call begin_read() and end_read(), only enabled
+    // with the page prefetcher to keep the tracking off the read path otherwise.
+    bool dedupe_inflight_reads() const { return _dedupe_inflight_reads; }
+    void set_dedupe_inflight_reads(bool dedupe) { _dedupe_inflight_reads = dedupe; }
+
     void prune(segment_v2::PageTypePB page_type);
 
     int64_t get_page_cache_mem_consumption(segment_v2::PageTypePB page_type) {
@@ -108,6 +124,15 @@ private:
     std::unique_ptr<Cache> _data_page_cache = nullptr;
     std::unique_ptr<Cache> _index_page_cache = nullptr;
 
+    struct InflightReads {
+        std::mutex lock;
+        std::condition_variable cv;
+        std::unordered_set<std::string> keys;
+    };
+    static constexpr uint32_t kNumInflightReadShards = 16;
+    InflightReads _inflight_reads[kNumInflightReadShards];
+    bool _dedupe_inflight_reads = false;
+
     Cache* _get_page_cache(segment_v2::PageTypePB page_type) {
         switch (page_type) {
         case segment_v2::DATA_PAGE: {
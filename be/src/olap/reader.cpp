@@ -220,6 +220,10 @@ Status TabletReader::_capture_rs_readers(const ReaderParams& read_params) {
     _reader_context.tablet_schema = _tablet_schema;
     _reader_context.need_ordered_result = need_ordered_result;
     _reader_context.use_topn_opt = read_params.use_topn_opt;
+    if (read_params.reader_type == READER_QUERY) {
+        _late_arrival_predicates = std::make_shared<LateArrivalPredicates>();
+        _reader_context.late_arrival_predicates = _late_arrival_predicates;
+    }
     _reader_context.read_orderby_key_reverse = read_params.read_orderby_key_reverse;
     _reader_context.read_orderby_key_limit = read_params.read_orderby_key_limit;
     _reader_context.filter_block_vconjunct_ctx_ptr = read_params.filter_block_vconjunct_ctx_ptr;
@@ -558,6 +562,27 @@ void TabletReader::_init_conditions_param_except_leafnode_of_andnode(
     }
 }
 
+void TabletReader::append_late_arrival_filters(
+        const std::vector<std::pair<string, std::shared_ptr<BloomFilterFuncBase>>>& bloom_filters,
+        const std::vector<std::pair<string, std::shared_ptr<HybridSetBase>>>& in_filters) {
+    if (_late_arrival_predicates == nullptr) {
+        return;
+    }
+    std::vector<ColumnPredicate*> predicates;
+    for (const auto& filter : bloom_filters) {
+        if (auto* predicate = _parse_to_predicate(filter)) {
+            predicates.push_back(predicate);
+        }
+    }
+    for (const auto& filter : in_filters) {
+        if (auto* predicate = _parse_to_predicate(filter)) {
+            predicate->predicate_params()->marked_by_runtime_filter = true;
+            predicates.push_back(predicate);
+        }
+    }
+    _late_arrival_predicates->append(predicates);
+}
+
 ColumnPredicate* TabletReader::_parse_to_predicate(
         const std::pair<std::string, std::shared_ptr<BloomFilterFuncBase>>& bloom_filter) {
     int32_t index = _tablet_schema->field_index(bloom_filter.first);
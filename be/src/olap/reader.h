@@ -198,6 +198,13 @@ public:
 
     int batch_size() const { return _reader_context.batch_size; }
 
+    // Append runtime filters which arrived after the reader was inited, segment iterators
+    // use them to prune the rows they have not read yet.
+    void append_late_arrival_filters(
+            const std::vector<std::pair<string, std::shared_ptr<BloomFilterFuncBase>>>&
+                    bloom_filters,
+            const std::vector<std::pair<string, std::shared_ptr<HybridSetBase>>>& in_filters);
+
     const OlapReaderStatistics& stats() const { return _stats; }
     OlapReaderStatistics* mutable_stats() { return &_stats; }
 
@@ -261,6 +268,7 @@ protected:
     std::vector<ColumnPredicate*> _col_predicates;
     std::vector<ColumnPredicate*> _col_preds_except_leafnode_of_andnode;
     std::vector<ColumnPredicate*> _value_col_predicates;
+    LateArrivalPredicatesSPtr _late_arrival_predicates;
     DeleteHandler _delete_handler;
 
     bool _aggregation = false;
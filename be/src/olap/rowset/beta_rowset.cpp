@@ -28,14 +28,17 @@
 #include "common/logging.h"
 #include "common/status.h"
 #include "io/cache/file_cache_manager.h"
+#include "io/fs/file_reader.h"
 #include "io/fs/file_reader_options.h"
 #include "io/fs/file_system.h"
+#include "io/fs/file_writer.h"
 #include "io/fs/local_file_system.h"
 #include "io/fs/path.h"
 #include "io/fs/remote_file_system.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/rowset/beta_rowset_reader.h"
+#include "olap/rowset/packed_segment_file.h"
 #include "olap/rowset/segment_v2/inverted_index_cache.h"
 #include "olap/rowset/segment_v2/inverted_index_desc.h"
 #include "olap/tablet_schema.h"
@@ -47,6 +50,34 @@ using namespace ErrorCode;
 
 using io::FileCacheManager;
 
+namespace {
+
+Status copy_file(const io::FileSystemSPtr& src_fs, const std::string& src_path,
+                 const io::FileSystemSPtr& dst_fs, const std::string& dst_path) {
+    static const size_t k_copy_buffer_size = 1024 * 1024;
+    io::FileReaderSPtr file_reader;
+    RETURN_IF_ERROR(src_fs->open_file(src_path, &file_reader));
+    io::FileWriterPtr file_writer;
+    RETURN_IF_ERROR(dst_fs->create_file(dst_path, &file_writer));
+    std::unique_ptr<char[]> buf(new char[k_copy_buffer_size]);
+    size_t offset = 0;
+    while (offset < file_reader->size()) {
+        size_t bytes_read = 0;
+        size_t bytes_to_read = std::min(k_copy_buffer_size, file_reader->size() - offset);
+        RETURN_IF_ERROR(file_reader->read_at(offset, Slice(buf.get(), bytes_to_read), &bytes_read));
+        if (bytes_read != bytes_to_read) {
+            return Status::IOError("failed to read {}, expect {} bytes but read {}", src_path,
+                                   bytes_to_read, bytes_read);
+        }
+        RETURN_IF_ERROR(file_writer->append(Slice(buf.get(), bytes_read)));
+        offset += bytes_read;
+    }
+    RETURN_IF_ERROR(file_writer->finalize());
+    return file_writer->close();
+}
+
+} // namespace
+
 std::string BetaRowset::segment_file_path(int segment_id) {
 #ifdef BE_TEST
     if (!config::file_cache_type.empty()) {
@@ -88,6 +119,69 @@ std::string BetaRowset::remote_segment_path(int64_t tablet_id, const std::string
     return fmt::format("{}/{}_{}.dat", remote_tablet_path(tablet_id), rowset_id, segment_id);
 }
 
+std::string BetaRowset::packed_file_path(const std::string& rowset_dir,
+                                         const RowsetId& rowset_id) {
+    // {rowset_dir}/{rowset_id}_packed.dat
+    return fmt::format("{}/{}_packed.dat", rowset_dir, rowset_id.to_string());
+}
+
+std::string BetaRowset::remote_packed_file_path(int64_t tablet_id, const std::string& rowset_id) {
+    // data/{tablet_id}/{rowset_id}_packed.dat
+    return fmt::format("{}/{}_packed.dat", remote_tablet_path(tablet_id), rowset_id);
+}
+
+std::string BetaRowset::packed_file_prefix(const RowsetId& rowset_id) {
+    return rowset_id.to_string() + "_";
+}
+
+std::string BetaRowset::_packed_file_path() {
+    return packed_file_path(_rowset_dir, rowset_id());
+}
+
+Status BetaRowset::_open_packed_fs(io::FileSystemSPtr* fs) {
+    io::SegmentCachePathPolicy cache_policy;
+    // named like the cache of the segment after the last one, so it's recognized by the
+    // file cache gc as a segment cache
+    cache_policy.set_cache_path(segment_cache_path(num_segments()));
+    io::FileReaderOptions reader_options(io::cache_type_from_string(config::file_cache_type),
+                                         cache_policy);
+    std::shared_ptr<PackedSegmentFileSystem> packed_fs;
+    RETURN_IF_ERROR(PackedSegmentFileSystem::open(_rowset_meta->fs(), _packed_file_path(),
+                                                  _rowset_dir, packed_file_prefix(rowset_id()),
+                                                  reader_options, &packed_fs));
+    *fs = std::move(packed_fs);
+    return Status::OK();
+}
+
+Status BetaRowset::_unpack_files_to(const std::string& dir, const RowsetId& new_rowset_id,
+                                    size_t new_rowset_start_seg_id) {
+    io::FileSystemSPtr packed_fs;
+    RETURN_IF_ERROR(_open_packed_fs(&packed_fs));
+    io::FileSystemSPtr local_fs = io::global_local_filesystem();
+    for (int i = 0; i < num_segments(); ++i) {
+        auto src_path = segment_file_path(i);
+        auto dst_path = segment_file_path(dir, new_rowset_id, i + new_rowset_start_seg_id);
+        bool dst_path_exist = false;
+        if (!local_fs->exists(dst_path, &dst_path_exist).ok() || dst_path_exist) {
+            LOG(WARNING) << "failed to unpack file, file already exist: " << dst_path;
+            return Status::Error<FILE_ALREADY_EXIST>();
+        }
+        RETURN_IF_ERROR(copy_file(packed_fs, src_path, local_fs, dst_path));
+        for (auto& column : _schema->columns()) {
+            const TabletIndex* index_meta = _schema->get_inverted_index(column.unique_id());
+            if (index_meta) {
+                RETURN_IF_ERROR(copy_file(packed_fs,
+                                          InvertedIndexDescriptor::get_index_file_name(
+                                                  src_path, index_meta->index_id()),
+                                          local_fs,
+                                          InvertedIndexDescriptor::get_index_file_name(
+                                                  dst_path, index_meta->index_id())));
+            }
+        }
+    }
+    return Status::OK();
+}
+
 std::string BetaRowset::local_segment_path_segcompacted(const std::string& tablet_path,
                                                         const RowsetId& rowset_id, int64_t begin,
                                                         int64_t end) {
@@ -122,6 +216,9 @@ Status BetaRowset::get_segments_size(std::vector<size_t>* segments_size) {
     if (!fs || _schema == nullptr) {
         return Status::Error<INIT_FAILED>();
     }
+    if (is_packed()) {
+        RETURN_IF_ERROR(_open_packed_fs(&fs));
+    }
     for (int seg_id = 0; seg_id < num_segments(); ++seg_id) {
         auto seg_path = segment_file_path(seg_id);
         int64_t file_size;
@@ -140,6 +237,9 @@ Status BetaRowset::load_segments(int64_t seg_id_begin, int64_t seg_id_end,
     if (!fs || _schema == nullptr) {
         return Status::Error<INIT_FAILED>();
     }
+    if (is_packed()) {
+        RETURN_IF_ERROR(_open_packed_fs(&fs));
+    }
     int64_t seg_id = seg_id_begin;
     while (seg_id < seg_id_end) {
         DCHECK(seg_id >= 0);
@@ -179,7 +279,29 @@ Status BetaRowset::remove() {
     }
     bool success = true;
     Status st;
-    for (int i = 0; i < num_segments(); ++i) {
+    if (is_packed()) {
+        auto packed_path = _packed_file_path();
+        LOG(INFO) << "deleting " << packed_path;
+        st = fs->delete_file(packed_path);
+        if (!st.ok()) {
+            LOG(WARNING) << st.to_string();
+            success = false;
+        }
+        for (int i = 0; i < num_segments(); ++i) {
+            for (auto& column : _schema->columns()) {
+                const TabletIndex* index_meta = _schema->get_inverted_index(column.unique_id());
+                if (index_meta) {
+                    segment_v2::InvertedIndexSearcherCache::instance()->erase(
+                            InvertedIndexDescriptor::get_index_file_name(segment_file_path(i),
+                                                                         index_meta->index_id()));
+                }
+            }
+        }
+        if (fs->type() != io::FileSystemType::LOCAL) {
+            FileCacheManager::instance()->remove_file_cache(segment_cache_path(num_segments()));
+        }
+    }
+    for (int i = 0; !is_packed() && i < num_segments(); ++i) {
         auto seg_path = segment_file_path(i);
         LOG(INFO) << "deleting " << seg_path;
         st = fs->delete_file(seg_path);
@@ -228,6 +350,25 @@ Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id,
         return Status::InternalError("should be local file system");
     }
     io::LocalFileSystem* local_fs = (io::LocalFileSystem*)fs.get();
+    if (is_packed()) {
+        if (new_rowset_start_seg_id != 0) {
+            // segments are renumbered, which is not possible in the packed file
+            return _unpack_files_to(dir, new_rowset_id, new_rowset_start_seg_id);
+        }
+        auto dst_path = packed_file_path(dir, new_rowset_id);
+        bool dst_path_exist = false;
+        if (!fs->exists(dst_path, &dst_path_exist).ok() || dst_path_exist) {
+            LOG(WARNING) << "failed to create hard link, file already exist: " << dst_path;
+            return Status::Error<FILE_ALREADY_EXIST>();
+        }
+        auto src_path = _packed_file_path();
+        if (!local_fs->link_file(src_path, dst_path).ok()) {
+            LOG(WARNING) << "fail to create hard link. from=" << src_path << ", "
+                         << "to=" << dst_path << ", errno=" << Errno::no();
+            return Status::Error<OS_ERROR>();
+        }
+        return Status::OK();
+    }
     for (int i = 0; i < num_segments(); ++i) {
         auto dst_path = segment_file_path(dir, new_rowset_id, i + new_rowset_start_seg_id);
         bool dst_path_exist = false;
@@ -274,6 +415,15 @@ Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id,
 Status BetaRowset::copy_files_to(const std::string& dir, const RowsetId& new_rowset_id) {
     DCHECK(is_local());
     bool exists = false;
+    if (is_packed()) {
+        auto dst_path = packed_file_path(dir, new_rowset_id);
+        RETURN_IF_ERROR(io::global_local_filesystem()->exists(dst_path, &exists));
+        if (exists) {
+            LOG(WARNING) << "file already exist: " << dst_path;
+            return Status::Error<FILE_ALREADY_EXIST>();
+        }
+        return io::global_local_filesystem()->copy_dirs(_packed_file_path(), dst_path);
+    }
     for (int i = 0; i < num_segments(); ++i) {
         auto dst_path = segment_file_path(dir, new_rowset_id, i);
         RETURN_IF_ERROR(io::global_local_filesystem()->exists(dst_path, &exists));
@@ -312,7 +462,13 @@ Status BetaRowset::upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_
     local_paths.reserve(num_segments());
     std::vector<io::Path> dest_paths;
     dest_paths.reserve(num_segments());
-    for (int i = 0; i < num_segments(); ++i) {
+    if (is_packed()) {
+        // the packed file is uploaded as one object
+        dest_paths.push_back(
+                remote_packed_file_path(_rowset_meta->tablet_id(), new_rowset_id.to_string()));
+        local_paths.push_back(_packed_file_path());
+    }
+    for (int i = 0; !is_packed() && i < num_segments(); ++i) {
         // Note: Here we use relative path for remote.
         auto remote_seg_path = remote_segment_path(_rowset_meta->tablet_id(), new_rowset_id, i);
         auto local_seg_path = segment_file_path(i);
@@ -344,6 +500,9 @@ Status BetaRowset::upload_to(io::RemoteFileSystem* dest_fs, const RowsetId& new_
 }
 
 bool BetaRowset::check_path(const std::string& path) {
+    if (is_packed()) {
+        return path == _packed_file_path();
+    }
     for (int i = 0; i < num_segments(); ++i) {
         auto seg_path = segment_file_path(i);
         if (seg_path == path) {
@@ -354,6 +513,17 @@ bool BetaRowset::check_path(const std::string& path) {
 }
 
 bool BetaRowset::check_file_exist() {
+    if (is_packed()) {
+        auto fs = _rowset_meta->fs();
+        bool packed_file_exist = false;
+        if (!fs || !fs->exists(_packed_file_path(), &packed_file_exist).ok() ||
+            !packed_file_exist) {
+            LOG(WARNING) << "data file not existed: " << _packed_file_path()
+                         << " for rowset_id: " << rowset_id();
+            return false;
+        }
+        return true;
+    }
     for (int i = 0; i < num_segments(); ++i) {
         auto seg_path = segment_file_path(i);
         auto fs = _rowset_meta->fs();
@@ -375,6 +545,10 @@ bool BetaRowset::check_current_rowset_segment() {
     if (!fs) {
         return false;
     }
+    if (is_packed() && !_open_packed_fs(&fs).ok()) {
+        LOG(WARNING) << "packed file can not be opened. file=" << _packed_file_path();
+        return false;
+    }
     for (int seg_id = 0; seg_id < num_segments(); ++seg_id) {
         auto seg_path = segment_file_path(seg_id);
         std::shared_ptr<segment_v2::Segment> segment;
@@ -68,6 +68,17 @@ public:
     static std::string remote_segment_path(int64_t tablet_id, const std::string& rowset_id,
                                            int segment_id);
 
+    // {rowset_dir}/{rowset_id}_packed.dat, holds all segment and inverted index files of
+    // a packed rowset, see PackedSegmentFile
+    static std::string packed_file_path(const std::string& rowset_dir, const RowsetId& rowset_id);
+
+    static std::string remote_packed_file_path(int64_t tablet_id, const std::string& rowset_id);
+
+    // files of a rowset are named "{rowset_id}_xxx", and "xxx" in a packed file
+    static std::string packed_file_prefix(const RowsetId& rowset_id);
+
+    bool is_packed() const { return _rowset_meta->is_segments_packed(); }
+
     Status remove() override;
 
     Status link_files_to(const std::string& dir, RowsetId new_rowset_id,
@@ -107,6 +118,15 @@ protected:
     bool check_current_rowset_segment() override;
 
 private:
+    std::string _packed_file_path();
+
+    // open the packed file as a file system holding segment and inverted index files
+    Status _open_packed_fs(io::FileSystemSPtr* fs);
+
+    // copy files out of the packed file, segments are renumbered from `new_rowset_start_seg_id`
+    Status _unpack_files_to(const std::string& dir, const RowsetId& new_rowset_id,
+                            size_t new_rowset_start_seg_id);
+
     friend class RowsetFactory;
     friend class BetaRowsetReader;
 };
@@ -40,6 +40,7 @@
 #include "olap/data_dir.h"
 #include "olap/olap_define.h"
 #include "olap/rowset/beta_rowset.h"
+#include "olap/rowset/packed_segment_file.h"
 #include "olap/rowset/rowset_factory.h"
 #include "olap/rowset/segment_v2/inverted_index_cache.h"
 #include "olap/rowset/segment_v2/inverted_index_desc.h"
@@ -88,6 +89,12 @@ BetaRowsetWriter::~BetaRowsetWriter() {
         if (!fs) {
             return;
         }
+        if (_segments_packed) {
+            std::string packed_path =
+                    BetaRowset::packed_file_path(_context.rowset_dir, _context.rowset_id);
+            WARN_IF_ERROR(fs->delete_file(packed_path),
+                          strings::Substitute("Failed to delete file=$0", packed_path));
+        }
         for (int i = 0; i < _num_segment; ++i) {
             std::string seg_path =
                     BetaRowset::segment_file_path(_context.rowset_dir, _context.rowset_id, i);
@@ -436,7 +443,13 @@ Status BetaRowsetWriter::_add_block(const vectorized::Block* block,
 
 Status BetaRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
     assert(rowset->rowset_meta()->rowset_type() == BETA_ROWSET);
+    bool is_packed = std::static_pointer_cast<BetaRowset>(rowset)->is_packed();
+    if (is_packed && _num_segment > 0) {
+        return Status::NotSupported("can not add packed rowset {} to a non-empty rowset",
+                                    rowset->rowset_id().to_string());
+    }
     RETURN_NOT_OK(rowset->link_files_to(_context.rowset_dir, _context.rowset_id));
+    _segments_packed = is_packed;
     _num_rows_written += rowset->num_rows();
     _total_data_size += rowset->rowset_meta()->data_disk_size();
     _total_index_size += rowset->rowset_meta()->index_disk_size();
@@ -544,6 +557,16 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     DCHECK(_segment_writer == nullptr) << "segment must be null when build rowset";
     _build_rowset_meta(_rowset_meta);
 
+    if (!_segments_packed && config::enable_packed_segment_file) {
+        status = _pack_segment_files();
+        if (!status.ok()) {
+            // the rowset is still readable with the unpacked files
+            LOG(WARNING) << "failed to pack segment files, rowset_id=" << _context.rowset_id
+                         << ", res=" << status;
+        }
+    }
+    _rowset_meta->set_segments_packed(_segments_packed);
+
     if (_rowset_meta->newest_write_timestamp() == -1) {
         _rowset_meta->set_newest_write_timestamp(UnixSeconds());
     }
@@ -576,6 +599,48 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     return rowset;
 }
 
+Status BetaRowsetWriter::_pack_segment_files() {
+    auto fs = _rowset_meta->fs();
+    if (!fs || fs->type() != io::FileSystemType::LOCAL || _segment_start_id != 0 ||
+        _rowset_meta->num_segments() == 0 ||
+        _rowset_meta->total_disk_size() > config::packed_segment_file_max_bytes) {
+        return Status::OK();
+    }
+    std::vector<std::string> paths;
+    for (int i = 0; i < _rowset_meta->num_segments(); ++i) {
+        std::string seg_path =
+                BetaRowset::segment_file_path(_context.rowset_dir, _context.rowset_id, i);
+        paths.push_back(seg_path);
+        auto tablet_schema = _rowset_meta->tablet_schema();
+        for (auto& column : tablet_schema->columns()) {
+            const TabletIndex* index_meta = tablet_schema->get_inverted_index(column.unique_id());
+            if (index_meta) {
+                paths.push_back(InvertedIndexDescriptor::get_index_file_name(
+                        seg_path, index_meta->index_id()));
+            }
+        }
+    }
+    std::string prefix = BetaRowset::packed_file_prefix(_context.rowset_id);
+    std::vector<std::string> names;
+    names.reserve(paths.size());
+    for (auto& path : paths) {
+        names.push_back(io::Path(path).filename().native().substr(prefix.size()));
+    }
+
+    std::string packed_path = BetaRowset::packed_file_path(_context.rowset_dir, _context.rowset_id);
+    auto st = PackedSegmentFile::pack(fs, paths, names, packed_path);
+    if (!st.ok()) {
+        WARN_IF_ERROR(fs->delete_file(packed_path),
+                      strings::Substitute("Failed to delete file=$0", packed_path));
+        return st;
+    }
+    _segments_packed = true;
+    for (auto& path : paths) {
+        WARN_IF_ERROR(fs->delete_file(path), strings::Substitute("Failed to delete file=$0", path));
+    }
+    return Status::OK();
+}
+
 bool BetaRowsetWriter::_is_segment_overlapping(
         const std::vector<KeyBoundsPB>& segments_encoded_key_bounds) {
     std::string last;
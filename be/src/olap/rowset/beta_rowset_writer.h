@@ -151,6 +151,8 @@ private:
     Status _rename_compacted_segments(int64_t begin, int64_t end);
     Status _rename_compacted_segment_plain(uint64_t seg_id);
     Status _rename_compacted_indices(int64_t begin, int64_t end, uint64_t seg_id);
+    // pack segment and inverted index files of a small local rowset into one file
+    Status _pack_segment_files();
 
     void set_segment_start_id(int32_t start_id) override { _segment_start_id = start_id; }
 
@@ -201,6 +203,8 @@ protected:
 
     bool _is_pending = false;
     bool _already_built = false;
+    // files of the rowset are in a packed segment file, see PackedSegmentFile
+    bool _segments_packed = false;
 
     SegcompactionWorker _segcompaction_worker;
 
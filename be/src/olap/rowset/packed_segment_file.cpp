@@ -0,0 +1,257 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/packed_segment_file.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "io/fs/file_writer.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/faststring.h"
+
+namespace doris {
+
+static const char* k_packed_file_magic = "D0P1";
+static const uint32_t k_packed_file_magic_length = 4;
+static const size_t k_pack_buffer_size = 1024 * 1024;
+
+Status PackedSegmentFile::pack(const io::FileSystemSPtr& fs,
+                               const std::vector<std::string>& paths,
+                               const std::vector<std::string>& names,
+                               const std::string& packed_path) {
+    DCHECK_EQ(paths.size(), names.size());
+    io::FileWriterPtr file_writer;
+    RETURN_IF_ERROR(fs->create_file(packed_path, &file_writer));
+
+    segment_v2::PackedFileFooterPB footer;
+    std::unique_ptr<char[]> buf(new char[k_pack_buffer_size]);
+    for (size_t i = 0; i < paths.size(); ++i) {
+        io::FileReaderSPtr file_reader;
+        RETURN_IF_ERROR(fs->open_file(paths[i], &file_reader));
+        auto* entry = footer.add_entries();
+        entry->set_name(names[i]);
+        entry->set_offset(file_writer->bytes_appended());
+        entry->set_size(file_reader->size());
+        size_t offset = 0;
+        while (offset < file_reader->size()) {
+            size_t bytes_read = 0;
+            size_t bytes_to_read = std::min(k_pack_buffer_size, file_reader->size() - offset);
+            RETURN_IF_ERROR(
+                    file_reader->read_at(offset, Slice(buf.get(), bytes_to_read), &bytes_read));
+            if (bytes_read != bytes_to_read) {
+                return Status::IOError("failed to read {}, expect {} bytes but read {}",
+                                       paths[i], bytes_to_read, bytes_read);
+            }
+            RETURN_IF_ERROR(file_writer->append(Slice(buf.get(), bytes_read)));
+            offset += bytes_read;
+        }
+    }
+
+    std::string footer_buf;
+    if (!footer.SerializeToString(&footer_buf)) {
+        return Status::InternalError("failed to serialize packed file footer");
+    }
+    faststring fixed_buf;
+    put_fixed32_le(&fixed_buf, footer_buf.size());
+    put_fixed32_le(&fixed_buf, crc32c::Value(footer_buf.data(), footer_buf.size()));
+    fixed_buf.append(k_packed_file_magic, k_packed_file_magic_length);
+    std::vector<Slice> slices {footer_buf, fixed_buf};
+    RETURN_IF_ERROR(file_writer->appendv(&slices[0], slices.size()));
+    RETURN_IF_ERROR(file_writer->finalize());
+    return file_writer->close();
+}
+
+PackedSegmentFileSystem::PackedSegmentFileSystem(const io::FileSystemSPtr& fs,
+                                                 io::FileReaderSPtr file_reader,
+                                                 std::string prefix)
+        : io::FileSystem(io::Path(fs->root_path()), std::string(fs->id()), fs->type()),
+          _file_reader(std::move(file_reader)),
+          _prefix(std::move(prefix)) {}
+
+Status PackedSegmentFileSystem::open(const io::FileSystemSPtr& fs, const io::Path& packed_path,
+                                     const io::Path& dir, const std::string& prefix,
+                                     const io::FileReaderOptions& reader_options,
+                                     std::shared_ptr<PackedSegmentFileSystem>* packed_fs) {
+    io::FileReaderSPtr file_reader;
+    RETURN_IF_ERROR(fs->open_file(packed_path, reader_options, &file_reader));
+    std::shared_ptr<PackedSegmentFileSystem> res(
+            new PackedSegmentFileSystem(fs, std::move(file_reader), prefix));
+    res->_dir = res->absolute_path(dir);
+    RETURN_IF_ERROR(res->_parse_footer());
+    *packed_fs = std::move(res);
+    return Status::OK();
+}
+
+Status PackedSegmentFileSystem::_parse_footer() {
+    const auto& path = _file_reader->path().native();
+    size_t file_size = _file_reader->size();
+    if (file_size < 12) {
+        return Status::Corruption("Bad packed file {}: file size {} < 12", path, file_size);
+    }
+    uint8_t fixed_buf[12];
+    size_t bytes_read = 0;
+    RETURN_IF_ERROR(_file_reader->read_at(file_size - 12, Slice(fixed_buf, 12), &bytes_read));
+    DCHECK_EQ(bytes_read, 12);
+    if (memcmp(fixed_buf + 8, k_packed_file_magic, k_packed_file_magic_length) != 0) {
+        return Status::Corruption("Bad packed file {}: magic number not match", path);
+    }
+
+    uint32_t footer_length = decode_fixed32_le(fixed_buf);
+    if (file_size < 12 + footer_length) {
+        return Status::Corruption("Bad packed file {}: file size {} < {}", path, file_size,
+                                  12 + footer_length);
+    }
+    std::string footer_buf;
+    footer_buf.resize(footer_length);
+    RETURN_IF_ERROR(
+            _file_reader->read_at(file_size - 12 - footer_length, footer_buf, &bytes_read));
+    DCHECK_EQ(bytes_read, footer_length);
+    uint32_t expect_checksum = decode_fixed32_le(fixed_buf + 4);
+    uint32_t actual_checksum = crc32c::Value(footer_buf.data(), footer_buf.size());
+    if (actual_checksum != expect_checksum) {
+        return Status::Corruption(
+                "Bad packed file {}: footer checksum not match, actual={} vs expect={}", path,
+                actual_checksum, expect_checksum);
+    }
+
+    segment_v2::PackedFileFooterPB footer;
+    if (!footer.ParseFromString(footer_buf)) {
+        return Status::Corruption("Bad packed file {}: failed to parse PackedFileFooterPB", path);
+    }
+    for (const auto& entry : footer.entries()) {
+        if (entry.offset() + entry.size() > file_size - 12 - footer_length) {
+            return Status::Corruption("Bad packed file {}: entry {} out of range", path,
+                                      entry.name());
+        }
+        _entries.emplace(entry.name(), entry);
+    }
+    return Status::OK();
+}
+
+const segment_v2::PackedFileEntryPB* PackedSegmentFileSystem::_find_entry(
+        const io::Path& file) const {
+    std::string file_name = file.filename().native();
+    if (file_name.compare(0, _prefix.size(), _prefix) != 0) {
+        return nullptr;
+    }
+    auto it = _entries.find(file_name.substr(_prefix.size()));
+    return it == _entries.end() ? nullptr : &it->second;
+}
+
+Status PackedSegmentFileSystem::create_file_impl(const io::Path& file,
+                                                 io::FileWriterPtr* writer) {
+    return Status::NotSupported("packed segment file is read only");
+}
+
+Status PackedSegmentFileSystem::open_file_impl(const io::Path& file,
+                                               const io::FileReaderOptions& reader_options,
+                                               io::FileReaderSPtr* reader) {
+    const auto* entry = _find_entry(file);
+    if (entry == nullptr) {
+        return Status::NotFound("{} not found in packed file {}", file.native(),
+                                _file_reader->path().native());
+    }
+    *reader = std::make_shared<PackedEntryFileReader>(file, _file_reader, entry->offset(),
+                                                      entry->size(), shared_from_this());
+    return Status::OK();
+}
+
+Status PackedSegmentFileSystem::create_directory_impl(const io::Path& dir,
+                                                      bool failed_if_exists) {
+    return Status::NotSupported("packed segment file is read only");
+}
+
+Status PackedSegmentFileSystem::delete_file_impl(const io::Path& file) {
+    return Status::NotSupported("packed segment file is read only");
+}
+
+Status PackedSegmentFileSystem::delete_directory_impl(const io::Path& dir) {
+    return Status::NotSupported("packed segment file is read only");
+}
+
+Status PackedSegmentFileSystem::batch_delete_impl(const std::vector<io::Path>& files) {
+    return Status::NotSupported("packed segment file is read only");
+}
+
+Status PackedSegmentFileSystem::exists_impl(const io::Path& path, bool* res) const {
+    *res = path == _dir || _find_entry(path) != nullptr;
+    return Status::OK();
+}
+
+Status PackedSegmentFileSystem::file_size_impl(const io::Path& file, int64_t* file_size) const {
+    const auto* entry = _find_entry(file);
+    if (entry == nullptr) {
+        return Status::NotFound("{} not found in packed file {}", file.native(),
+                                _file_reader->path().native());
+    }
+    *file_size = entry->size();
+    return Status::OK();
+}
+
+Status PackedSegmentFileSystem::list_impl(const io::Path& dir, bool only_file,
+                                          std::vector<io::FileInfo>* files, bool* exists) {
+    *exists = dir == _dir;
+    if (!*exists) {
+        return Status::OK();
+    }
+    for (const auto& [name, entry] : _entries) {
+        files->push_back({_prefix + name, static_cast<int64_t>(entry.size()), true});
+    }
+    return Status::OK();
+}
+
+Status PackedSegmentFileSystem::rename_impl(const io::Path& orig_name,
+                                            const io::Path& new_name) {
+    return Status::NotSupported("packed segment file is read only");
+}
+
+Status PackedSegmentFileSystem::rename_dir_impl(const io::Path& orig_name,
+                                                const io::Path& new_name) {
+    return Status::NotSupported("packed segment file is read only");
+}
+
+PackedEntryFileReader::PackedEntryFileReader(io::Path path, io::FileReaderSPtr file_reader,
+                                             size_t offset, size_t size, io::FileSystemSPtr fs)
+        : _path(std::move(path)),
+          _file_reader(std::move(file_reader)),
+          _offset(offset),
+          _size(size),
+          _fs(std::move(fs)) {}
+
+Status PackedEntryFileReader::close() {
+    // the packed file is shared by other entries, it's closed when all of them are released
+    _closed.store(true, std::memory_order_release);
+    return Status::OK();
+}
+
+Status PackedEntryFileReader::read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                                           const io::IOContext* io_ctx) {
+    DCHECK(!closed());
+    if (offset > _size) {
+        return Status::IOError("offset exceeds file size(offset: {}, file size: {}, path: {})",
+                               offset, _size, _path.native());
+    }
+    size_t bytes_req = std::min(result.size, _size - offset);
+    return _file_reader->read_at(_offset + offset, Slice(result.data, bytes_req), bytes_read,
+                                 io_ctx);
+}
+
+} // namespace doris
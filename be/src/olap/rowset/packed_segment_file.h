@@ -0,0 +1,137 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <gen_cpp/segment_v2.pb.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "io/fs/file_reader.h"
+#include "io/fs/file_reader_writer_fwd.h"
+#include "io/fs/file_system.h"
+#include "io/fs/path.h"
+#include "util/slice.h"
+
+namespace doris {
+namespace io {
+class IOContext;
+} // namespace io
+
+// A packed segment file holds all segment and inverted index files of a rowset, so that a
+// small rowset takes one file on local disks and one object on remote storages.
+//
+// PackedFile := Entry*, PackedFileFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
+//
+// Entries are named by their original file names without the "{rowset_id}_" prefix, so a
+// packed file can be linked or uploaded under another rowset id as is.
+class PackedSegmentFile {
+public:
+    // Pack files of `fs` at `paths` into a new file at `packed_path`, the file at paths[i]
+    // is named names[i] in the packed file.
+    static Status pack(const io::FileSystemSPtr& fs, const std::vector<std::string>& paths,
+                       const std::vector<std::string>& names, const std::string& packed_path);
+};
+
+// A read only file system over a packed segment file. A file "{dir}/{prefix}{name}" is
+// opened as the entry `name` of the packed file, so segments and inverted indexes read
+// the packed file by their original paths. Page cache keys and inverted index caches which
+// are built from these paths stay the same as the unpacked layout.
+class PackedSegmentFileSystem final : public io::FileSystem {
+public:
+    // Open the packed file at `packed_path` of `fs`, the block file cache applies to the
+    // packed file according to `reader_options`.
+    static Status open(const io::FileSystemSPtr& fs, const io::Path& packed_path,
+                       const io::Path& dir, const std::string& prefix,
+                       const io::FileReaderOptions& reader_options,
+                       std::shared_ptr<PackedSegmentFileSystem>* packed_fs);
+
+    ~PackedSegmentFileSystem() override = default;
+
+    const std::unordered_map<std::string, segment_v2::PackedFileEntryPB>& entries() const {
+        return _entries;
+    }
+
+protected:
+    Status create_file_impl(const io::Path& file, io::FileWriterPtr* writer) override;
+    Status open_file_impl(const io::Path& file, const io::FileReaderOptions& reader_options,
+                          io::FileReaderSPtr* reader) override;
+    Status create_directory_impl(const io::Path& dir, bool failed_if_exists = false) override;
+    Status delete_file_impl(const io::Path& file) override;
+    Status delete_directory_impl(const io::Path& dir) override;
+    Status batch_delete_impl(const std::vector<io::Path>& files) override;
+    Status exists_impl(const io::Path& path, bool* res) const override;
+    Status file_size_impl(const io::Path& file, int64_t* file_size) const override;
+    Status list_impl(const io::Path& dir, bool only_file, std::vector<io::FileInfo>* files,
+                     bool* exists) override;
+    Status rename_impl(const io::Path& orig_name, const io::Path& new_name) override;
+    Status rename_dir_impl(const io::Path& orig_name, const io::Path& new_name) override;
+
+private:
+    PackedSegmentFileSystem(const io::FileSystemSPtr& fs, io::FileReaderSPtr file_reader,
+                            std::string prefix);
+
+    Status _parse_footer();
+
+    // return nullptr if `file` is not in the packed file
+    const segment_v2::PackedFileEntryPB* _find_entry(const io::Path& file) const;
+
+    io::FileReaderSPtr _file_reader;
+    io::Path _dir;
+    std::string _prefix;
+    std::unordered_map<std::string, segment_v2::PackedFileEntryPB> _entries;
+};
+
+// Reads an entry of a packed segment file by offset ranges of the packed file
+class PackedEntryFileReader final : public io::FileReader {
+public:
+    PackedEntryFileReader(io::Path path, io::FileReaderSPtr file_reader, size_t offset,
+                          size_t size, io::FileSystemSPtr fs);
+
+    ~PackedEntryFileReader() override = default;
+
+    Status close() override;
+
+    const io::Path& path() const override { return _path; }
+
+    size_t size() const override { return _size; }
+
+    bool closed() const override { return _closed.load(std::memory_order_acquire); }
+
+    io::FileSystemSPtr fs() const override { return _fs; }
+
+private:
+    Status read_at_impl(size_t offset, Slice result, size_t* bytes_read,
+                        const io::IOContext* io_ctx) override;
+
+    io::Path _path;
+    // reader of the packed file, shared by all entries
+    io::FileReaderSPtr _file_reader;
+    size_t _offset;
+    size_t _size;
+    io::FileSystemSPtr _fs;
+    std::atomic<bool> _closed = false;
+};
+
+} // namespace doris
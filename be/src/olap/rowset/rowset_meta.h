@@ -294,6 +294,10 @@ public:
         _rowset_meta_pb.set_segments_overlap_pb(segments_overlap);
     }
 
+    bool is_segments_packed() const { return _rowset_meta_pb.segments_packed(); }
+
+    void set_segments_packed(bool packed) { _rowset_meta_pb.set_segments_packed(packed); }
+
     static bool comparator(const RowsetMetaSharedPtr& left, const RowsetMetaSharedPtr& right) {
         return left->end_version() < right->end_version();
     }
@@ -20,6 +20,7 @@
 
 #include "io/io_common.h"
 #include "olap/column_predicate.h"
+#include "olap/late_arrival_predicates.h"
 #include "olap/olap_common.h"
 #include "runtime/runtime_state.h"
 #include "vec/exprs/vexpr.h"
@@ -38,6 +39,8 @@ struct RowsetReaderContext {
     TabletSchemaSPtr tablet_schema = nullptr;
     // flag for enable topn opt
     bool use_topn_opt = false;
+    // predicates of runtime filters arrived after the scan started
+    LateArrivalPredicatesSPtr late_arrival_predicates;
     // whether rowset should return ordered rows.
     bool need_ordered_result = true;
     // used for special optimization for query : ORDER BY key DESC LIMIT n
@@ -132,6 +132,8 @@ public:
 
     bool is_nullable() const { return _meta.is_nullable(); }
 
+    FieldType get_meta_type() const { return (FieldType)_meta.type(); }
+
     const EncodingInfo* encoding_info() const { return _encoding_info; }
 
     bool has_zone_map() const { return _zone_map_index_meta != nullptr; }
@@ -38,6 +38,7 @@
 #include "util/block_compression.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
+#include "util/defer_op.h"
 #include "util/faststring.h"
 #include "util/runtime_profile.h"
 
@@ -120,8 +121,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     PageCacheHandle cache_handle;
     StoragePageCache::CacheKey cache_key(opts.file_reader->path().native(),
                                          opts.page_pointer.offset);
-    if (opts.use_page_cache && cache->is_cache_available(opts.type) &&
-        cache->lookup(cache_key, &cache_handle, opts.type)) {
+    auto use_cached_page = [&]() {
         // we find page in cache, use it
         *handle = PageHandle(std::move(cache_handle));
         opts.stats->cached_pages_num++;
@@ -134,7 +134,31 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         }
         *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
         return Status::OK();
+    };
+    const bool use_page_cache = opts.use_page_cache && cache->is_cache_available(opts.type);
+    if (use_page_cache && cache->lookup(cache_key, &cache_handle, opts.type)) {
+        return use_cached_page();
     }
+    const bool dedupe_read =
+            use_page_cache && opts.type == DATA_PAGE && cache->dedupe_inflight_reads();
+    if (dedupe_read) {
+        // wait for another thread reading the page, e.g. the page prefetcher, instead of
+        // reading it again
+        while (!cache->begin_read(cache_key)) {
+            if (cache->lookup(cache_key, &cache_handle, opts.type)) {
+                return use_cached_page();
+            }
+        }
+        if (cache->lookup(cache_key, &cache_handle, opts.type)) {
+            cache->end_read(cache_key);
+            return use_cached_page();
+        }
+    }
+    Defer end_read {[&]() {
+        if (dedupe_read) {
+            cache->end_read(cache_key);
+        }
+    }};
 
     // every page contains 4 bytes footer length and 4 bytes checksum
     const uint32_t page_size = opts.page_pointer.size;
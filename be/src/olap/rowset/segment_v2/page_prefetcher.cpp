@@ -0,0 +1,131 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_prefetcher.h"
+
+#include <gen_cpp/segment_v2.pb.h>
+
+#include <algorithm>
+#include <ostream>
+
+#include "common/logging.h"
+#include "olap/olap_common.h"
+#include "olap/rowset/segment_v2/ordinal_page_index.h"
+#include "olap/rowset/segment_v2/page_handle.h"
+#include "olap/rowset/segment_v2/segment.h"
+#include "util/block_compression.h"
+#include "util/slice.h"
+#include "util/threadpool.h"
+
+namespace doris {
+namespace segment_v2 {
+
+PagePrefetcher::PagePrefetcher(std::shared_ptr<Segment> segment, const ColumnIteratorOptions& opts,
+                               ThreadPool* thread_pool, size_t max_bytes)
+        : _segment(std::move(segment)),
+          _opts(opts),
+          _thread_pool(thread_pool),
+          _max_bytes(max_bytes),
+          _cancelled(std::make_shared<std::atomic<bool>>(false)) {
+    // prefetch tasks may outlive the reader, don't keep pointers to its states
+    _opts.stats = nullptr;
+    _opts.type = DATA_PAGE;
+    _opts.io_ctx.query_id = nullptr;
+    _opts.io_ctx.file_cache_stats = nullptr;
+}
+
+PagePrefetcher::~PagePrefetcher() {
+    _cancelled->store(true, std::memory_order_relaxed);
+}
+
+void PagePrefetcher::add_column(ColumnReader* reader) {
+    DCHECK(is_scalar_type(reader->get_meta_type()));
+    _columns.push_back({reader, 0});
+}
+
+void PagePrefetcher::prefetch(rowid_t next_rowid, const roaring::Roaring& row_bitmap) {
+    while (!_pending_pages.empty() && _pending_pages.top().first < next_rowid) {
+        _pending_bytes -= _pending_pages.top().second;
+        _pending_pages.pop();
+    }
+    for (auto& column : _columns) {
+        column.next_ordinal = std::max<ordinal_t>(column.next_ordinal, next_rowid);
+    }
+
+    uint64_t num_rows = _segment->num_rows();
+    while (_pending_bytes < _max_bytes) {
+        auto column = std::min_element(_columns.begin(), _columns.end(),
+                                       [](const ColumnCursor& lhs, const ColumnCursor& rhs) {
+                                           return lhs.next_ordinal < rhs.next_ordinal;
+                                       });
+        if (column == _columns.end() || column->next_ordinal >= num_rows) {
+            return;
+        }
+
+        // skip pages without any row to read
+        roaring::api::roaring_uint32_iterator_t iter;
+        roaring::api::roaring_init_iterator(&row_bitmap.roaring, &iter);
+        if (!roaring::api::roaring_move_uint32_iterator_equalorlarger(&iter,
+                                                                     column->next_ordinal)) {
+            column->next_ordinal = num_rows;
+            continue;
+        }
+        OrdinalPageIndexIterator page_iter;
+        if (!column->reader->seek_at_or_before(iter.current_value, &page_iter).ok()) {
+            column->next_ordinal = num_rows;
+            continue;
+        }
+        const PagePointer& pp = page_iter.page();
+        auto st = _submit(column->reader, pp);
+        if (!st.ok()) {
+            // the prefetch queue is full, try again with the next batch
+            VLOG_DEBUG << "failed to submit page prefetch task, segment=" << _segment->id()
+                       << ", st=" << st;
+            return;
+        }
+        column->next_ordinal = page_iter.last_ordinal() + 1;
+        _pending_pages.emplace(page_iter.last_ordinal(), pp.size);
+        _pending_bytes += pp.size;
+    }
+}
+
+Status PagePrefetcher::_submit(ColumnReader* reader, const PagePointer& pp) {
+    // the segment owns the column reader and the file reader, keep it alive until the task ends
+    return _thread_pool->submit_func([segment = _segment, reader, pp, opts = _opts,
+                                      cancelled = _cancelled]() mutable {
+        if (cancelled->load(std::memory_order_relaxed)) {
+            return;
+        }
+        OlapReaderStatistics stats;
+        opts.stats = &stats;
+        BlockCompressionCodec* codec = nullptr;
+        PageHandle handle;
+        Slice page_body;
+        PageFooterPB footer;
+        auto st = get_block_compression_codec(reader->get_compression(), &codec);
+        if (st.ok()) {
+            st = reader->read_page(opts, pp, &handle, &page_body, &footer, codec);
+        }
+        if (!st.ok()) {
+            VLOG_DEBUG << "failed to prefetch page, segment=" << segment->id()
+                       << ", offset=" << pp.offset << ", st=" << st;
+        }
+    });
+}
+
+} // namespace segment_v2
+} // namespace doris
@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <roaring/roaring.hh>
+#include <utility>
+#include <vector>
+
+#include "common/status.h"
+#include "olap/rowset/segment_v2/column_reader.h"
+#include "olap/rowset/segment_v2/common.h"
+#include "olap/rowset/segment_v2/page_pointer.h"
+
+namespace doris {
+class ThreadPool;
+
+namespace segment_v2 {
+class Segment;
+
+// Reads data pages of a segment ahead of a segment iterator on a thread pool. Pages are
+// decompressed by the prefetch threads and inserted into the storage page cache, where the
+// column iterators find them when they reach these rows.
+//
+// Pages of all prefetched columns advance together: the column whose prefetched pages
+// cover the fewest rows is always extended first. Bytes of the pages prefetched beyond the
+// iterator's read position are bounded by `max_bytes`.
+class PagePrefetcher {
+public:
+    // `opts` is the options of the column iterators of the segment iterator
+    PagePrefetcher(std::shared_ptr<Segment> segment, const ColumnIteratorOptions& opts,
+                   ThreadPool* thread_pool, size_t max_bytes);
+    ~PagePrefetcher();
+
+    // Prefetch data pages of `reader` which must be a reader of a scalar column
+    void add_column(ColumnReader* reader);
+
+    bool has_column() const { return !_columns.empty(); }
+
+    // Prefetch pages containing rows of `row_bitmap` starting from `next_rowid`, the rows
+    // before `next_rowid` have been read by the segment iterator.
+    void prefetch(rowid_t next_rowid, const roaring::Roaring& row_bitmap);
+
+private:
+    struct ColumnCursor {
+        ColumnReader* reader;
+        // the first ordinal not covered by prefetched pages
+        ordinal_t next_ordinal = 0;
+    };
+
+    Status _submit(ColumnReader* reader, const PagePointer& pp);
+
+    std::shared_ptr<Segment> _segment;
+    ColumnIteratorOptions _opts;
+    ThreadPool* _thread_pool;
+    size_t _max_bytes;
+    std::vector<ColumnCursor> _columns;
+    // last ordinal and size of prefetched pages which are not passed by the iterator yet
+    using PendingPage = std::pair<ordinal_t, uint32_t>;
+    std::priority_queue<PendingPage, std::vector<PendingPage>, std::greater<PendingPage>>
+            _pending_pages;
+    size_t _pending_bytes = 0;
+    // set when the segment iterator is closed, queued tasks are skipped then
+    std::shared_ptr<std::atomic<bool>> _cancelled;
+};
+
+} // namespace segment_v2
+} // namespace doris
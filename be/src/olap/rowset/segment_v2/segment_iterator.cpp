@@ -39,17 +39,20 @@
 #include "olap/column_predicate.h"
 #include "olap/like_column_predicate.h"
 #include "olap/olap_common.h"
+#include "olap/page_cache.h"
 #include "olap/primary_key_index.h"
 #include "olap/rowset/segment_v2/bitmap_index_reader.h"
 #include "olap/rowset/segment_v2/column_reader.h"
 #include "olap/rowset/segment_v2/indexed_column_reader.h"
 #include "olap/rowset/segment_v2/inverted_index_reader.h"
+#include "olap/rowset/segment_v2/page_prefetcher.h"
 #include "olap/rowset/segment_v2/row_ranges.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/short_key_index.h"
 #include "olap/tablet_schema.h"
 #include "olap/types.h"
 #include "olap/utils.h"
+#include "runtime/exec_env.h"
 #include "runtime/query_context.h"
 #include "runtime/runtime_predicate.h"
 #include "runtime/runtime_state.h"
@@ -98,6 +101,15 @@ public:
 
     bool has_more_range() const { return !_eof; }
 
+    // the first row id of the next range, return false when there is no more range.
+    bool next_rowid(uint32_t* rowid) const {
+        if (_eof) {
+            return false;
+        }
+        *rowid = _buf[_buf_pos];
+        return true;
+    }
+
     // read next range into [*from, *to) whose size <= max_range_size.
     // return false when there is no more range.
     virtual bool next_range(const uint32_t max_range_size, uint32_t* from, uint32_t* to) {
@@ -280,9 +292,46 @@ Status SegmentIterator::_init() {
     } else {
         _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
     }
+    _init_page_prefetcher();
     return Status::OK();
 }
 
+void SegmentIterator::_init_page_prefetcher() {
+    ThreadPool* thread_pool = ExecEnv::GetInstance()->segment_page_prefetch_thread_pool();
+    // prefetched pages are only useful when they can be found in page cache, and the
+    // backward range iterator reads pages in descending order
+    if (thread_pool == nullptr || config::segment_page_prefetch_max_bytes <= 0 ||
+        !_opts.use_page_cache || _opts.read_orderby_key_reverse ||
+        !StoragePageCache::instance()->is_cache_available(DATA_PAGE) || _row_bitmap.isEmpty()) {
+        return;
+    }
+    ColumnIteratorOptions iter_opts;
+    iter_opts.use_page_cache = _opts.use_page_cache;
+    iter_opts.file_reader = _file_reader.get();
+    iter_opts.io_ctx = _opts.io_ctx;
+    _page_prefetcher = std::make_unique<PagePrefetcher>(
+            _segment, iter_opts, thread_pool, config::segment_page_prefetch_max_bytes);
+    for (auto cid : _schema.column_ids()) {
+        auto reader = _segment->_column_readers.find(_opts.tablet_schema->column(cid).unique_id());
+        if (reader == _segment->_column_readers.end() || reader->second->is_empty() ||
+            !is_scalar_type(reader->second->get_meta_type())) {
+            continue;
+        }
+        _page_prefetcher->add_column(reader->second.get());
+    }
+    if (!_page_prefetcher->has_column()) {
+        _page_prefetcher.reset();
+    }
+}
+
+void SegmentIterator::_prefetch_pages() {
+    uint32_t next_rowid = 0;
+    if (_page_prefetcher == nullptr || !_range_iter->next_rowid(&next_rowid)) {
+        return;
+    }
+    _page_prefetcher->prefetch(next_rowid, _row_bitmap);
+}
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     DorisMetrics::instance()->segment_row_total->increment(num_rows());
 
@@ -471,6 +520,61 @@ Status SegmentIterator::_get_row_ranges_from_conditions(RowRanges* condition_row
     return Status::OK();
 }
 
+Status SegmentIterator::_apply_late_arrival_predicates() {
+    auto& late_arrival_predicates = _opts.late_arrival_predicates;
+    if (late_arrival_predicates == nullptr ||
+        late_arrival_predicates->size() == _late_arrival_predicate_num) {
+        return Status::OK();
+    }
+    std::vector<const ColumnPredicate*> predicates;
+    _late_arrival_predicate_num = late_arrival_predicates->get(_late_arrival_predicate_num,
+                                                               &predicates);
+    // the backward range iterator can not tell which rows are not read yet
+    if (_opts.read_orderby_key_reverse) {
+        return Status::OK();
+    }
+    uint32_t next_rowid = 0;
+    if (!_range_iter->next_rowid(&next_rowid)) {
+        return Status::OK();
+    }
+
+    RowRanges bf_row_ranges = RowRanges::create_single(num_rows());
+    RowRanges zone_map_row_ranges = RowRanges::create_single(num_rows());
+    for (auto* predicate : predicates) {
+        int32_t unique_id = _schema.unique_id(predicate->column_id());
+        if (_column_iterators.count(unique_id) < 1) {
+            continue;
+        }
+        AndBlockColumnPredicate and_predicate;
+        and_predicate.add_column_predicate(new SingleColumnBlockPredicate(predicate));
+
+        RowRanges column_bf_row_ranges = RowRanges::create_single(num_rows());
+        RETURN_IF_ERROR(_column_iterators[unique_id]->get_row_ranges_by_bloom_filter(
+                &and_predicate, &column_bf_row_ranges));
+        RowRanges::ranges_intersection(bf_row_ranges, column_bf_row_ranges, &bf_row_ranges);
+
+        RowRanges column_row_ranges = RowRanges::create_single(num_rows());
+        RETURN_IF_ERROR(_column_iterators[unique_id]->get_row_ranges_by_zone_map(
+                &and_predicate, nullptr, &column_row_ranges));
+        RowRanges::ranges_intersection(zone_map_row_ranges, column_row_ranges,
+                                       &zone_map_row_ranges);
+    }
+
+    // rows before next_rowid have been read, keep the rest of _row_bitmap which may match
+    roaring::Roaring unread_bitmap = _row_bitmap;
+    unread_bitmap.removeRange(0, next_rowid);
+    size_t pre_size = unread_bitmap.cardinality();
+    unread_bitmap &= RowRanges::ranges_to_roaring(bf_row_ranges);
+    _opts.stats->rows_bf_filtered += (pre_size - unread_bitmap.cardinality());
+    pre_size = unread_bitmap.cardinality();
+    unread_bitmap &= RowRanges::ranges_to_roaring(zone_map_row_ranges);
+    _opts.stats->rows_stats_filtered += (pre_size - unread_bitmap.cardinality());
+
+    _row_bitmap = std::move(unread_bitmap);
+    _range_iter.reset(new BitmapRangeIterator(_row_bitmap));
+    return Status::OK();
+}
+
 // filter rows by evaluating column predicates using bitmap indexes.
 // upon return, predicates that've been evaluated by bitmap indexes are removed from _col_predicates.
 Status SegmentIterator::_apply_bitmap_index() {
@@ -1677,6 +1781,8 @@ Status SegmentIterator::_next_batch_internal(vectorized::Block* block) {
             }
         }
     }
+    RETURN_IF_ERROR(_apply_late_arrival_predicates());
+    _prefetch_pages();
 
     _init_current_block(block, _current_return_columns);
 
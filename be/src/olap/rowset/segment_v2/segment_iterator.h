@@ -64,6 +64,7 @@ namespace segment_v2 {
 class BitmapIndexIterator;
 class ColumnIterator;
 class InvertedIndexIterator;
+class PagePrefetcher;
 class RowRanges;
 
 struct ColumnPredicateInfo {
@@ -170,6 +171,12 @@ private:
     // calculate row ranges that satisfy requested column conditions using various column index
     [[nodiscard]] Status _get_row_ranges_by_column_conditions();
     [[nodiscard]] Status _get_row_ranges_from_conditions(RowRanges* condition_row_ranges);
+    // prune rows not read yet by zone map and bloom filter index with predicates of
+    // runtime filters arrived after the scan started
+    [[nodiscard]] Status _apply_late_arrival_predicates();
+    // read data pages of the rows to read next into page cache on the prefetch thread pool
+    void _init_page_prefetcher();
+    void _prefetch_pages();
     [[nodiscard]] Status _apply_bitmap_index();
     [[nodiscard]] Status _apply_inverted_index();
     [[nodiscard]] Status _apply_inverted_index_on_column_predicate(
@@ -338,6 +345,10 @@ private:
     std::vector<std::pair<uint32_t, uint32_t>> _split_row_ranges;
     // an iterator for `_row_bitmap` that can be used to extract row range to scan
     std::unique_ptr<BitmapRangeIterator> _range_iter;
+    // num of predicates in _opts.late_arrival_predicates which have been applied
+    size_t _late_arrival_predicate_num = 0;
+    // nullptr if data pages are not prefetched
+    std::unique_ptr<PagePrefetcher> _page_prefetcher;
     // the next rowid to read
     rowid_t _cur_rowid;
     // members related to lazy materialization read
@@ -22,6 +22,9 @@
 #include <gen_cpp/olap_file.pb.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <exception>
 #include <map>
 #include <mutex>
@@ -62,7 +65,12 @@
 #include "olap/wrapper_field.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "runtime/thread_context.h"
 #include "util/defer_op.h"
+#include "util/doris_metrics.h"
+#include "util/mem_info.h"
+#include "util/parse_util.h"
+#include "util/threadpool.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/aggregate_functions/aggregate_function_reader.h"
 #include "vec/columns/column.h"
@@ -489,6 +497,171 @@ Status VSchemaChangeDirectly::_inner_process(RowsetReaderSharedPtr rowset_reader
     return Status::OK();
 }
 
+namespace {
+
+// bytes of the blocks held by all sorting schema changes of the BE
+std::atomic<int64_t> s_sort_mem_usage {0};
+
+void update_sort_mem_usage(int64_t bytes) {
+    int64_t usage = s_sort_mem_usage.fetch_add(bytes) + bytes;
+    DorisMetrics::instance()->schema_change_sort_mem_bytes->set_value(usage);
+}
+
+} // namespace
+
+SchemaChangeRunWriter::SchemaChangeRunWriter(int num_threads, int64_t mem_limit,
+                                             int64_t total_mem_limit, MemTracker* mem_tracker,
+                                             WriteRunFunc write_run)
+        : _mem_limit(mem_limit),
+          _run_mem_limit(mem_limit),
+          _total_mem_limit(total_mem_limit),
+          _mem_tracker(mem_tracker),
+          _task_mem_tracker(thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker()),
+          _write_run_func(std::move(write_run)) {
+    if (num_threads > 1) {
+        static_cast<void>(ThreadPoolBuilder("SchemaChangeSortThreadPool")
+                                  .set_min_threads(0)
+                                  .set_max_threads(num_threads)
+                                  .build(&_pool));
+        // the runs being written and the run being read
+        _run_mem_limit = mem_limit / (num_threads + 1);
+    }
+}
+
+SchemaChangeRunWriter::~SchemaChangeRunWriter() {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_status.ok()) {
+            _status = Status::Cancelled("schema change is cancelled");
+        }
+    }
+    if (_pool != nullptr) {
+        _pool->wait();
+    }
+    _blocks.clear();
+    _mem_tracker->release(_blocks_bytes);
+    update_sort_mem_usage(-_blocks_bytes);
+    // remove the runs written before a failure
+    for (auto& rowset : _rowsets) {
+        if (rowset != nullptr) {
+            StorageEngine::instance()->add_unused_rowset(rowset);
+        }
+    }
+}
+
+int64_t SchemaChangeRunWriter::total_mem_usage() {
+    return s_sort_mem_usage.load();
+}
+
+bool SchemaChangeRunWriter::_exceeds_mem_limit(int64_t bytes) const {
+    return _mem_tracker->consumption() + bytes > _mem_limit ||
+           (_total_mem_limit > 0 && s_sort_mem_usage.load() + bytes > _total_mem_limit);
+}
+
+Status SchemaChangeRunWriter::add_block(std::unique_ptr<vectorized::Block> block) {
+    int64_t bytes = block->allocated_bytes();
+    if (!_blocks.empty() && _blocks_bytes + bytes > _run_mem_limit) {
+        RETURN_IF_ERROR(flush());
+    }
+    // wait for the runs in flight to release memory, a schema change holding no blocks always
+    // goes on, so that one of the schema changes makes progress
+    while (_mem_tracker->consumption() > 0 && _exceeds_mem_limit(bytes)) {
+        std::unique_lock<std::mutex> l(_lock);
+        RETURN_IF_ERROR(_status);
+        if (_num_runs_in_flight == 0) {
+            // only the current run holds memory
+            l.unlock();
+            RETURN_IF_ERROR(flush());
+            continue;
+        }
+        _cv.wait_for(l, std::chrono::milliseconds(100));
+    }
+    _mem_tracker->consume(bytes);
+    update_sort_mem_usage(bytes);
+    _blocks_bytes += bytes;
+    _blocks.push_back(std::move(block));
+    return Status::OK();
+}
+
+Status SchemaChangeRunWriter::flush() {
+    if (_blocks.empty()) {
+        return Status::OK();
+    }
+    size_t run_index = 0;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        RETURN_IF_ERROR(_status);
+        run_index = _rowsets.size();
+        _rowsets.emplace_back();
+        ++_num_runs_in_flight;
+    }
+    auto blocks = std::make_shared<Blocks>(std::move(_blocks));
+    _blocks.clear();
+    int64_t bytes = _blocks_bytes;
+    _blocks_bytes = 0;
+
+    Status st = Status::InternalError("no thread pool");
+    if (_pool != nullptr) {
+        st = _pool->submit_func([this, blocks, bytes, run_index]() {
+            // memory of the sorted blocks is consumed by the schema change task
+            SCOPED_ATTACH_TASK(_task_mem_tracker);
+            _write_run(blocks, bytes, run_index);
+        });
+    }
+    if (!st.ok()) {
+        // no pool or it is shut down, write the run by this thread
+        _write_run(blocks, bytes, run_index);
+    }
+    return Status::OK();
+}
+
+void SchemaChangeRunWriter::_write_run(const std::shared_ptr<Blocks>& blocks, int64_t bytes,
+                                       size_t run_index) {
+    Status st;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        st = _status;
+    }
+    RowsetSharedPtr rowset;
+    uint64_t merged_rows = 0;
+    if (st.ok()) {
+        st = _write_run_func(*blocks, run_index, &rowset, &merged_rows);
+    }
+    size_t rows = 0;
+    for (auto& block : *blocks) {
+        rows += block->rows();
+    }
+    blocks->clear();
+    _mem_tracker->release(bytes);
+    update_sort_mem_usage(-bytes);
+
+    std::lock_guard<std::mutex> l(_lock);
+    if (st.ok()) {
+        _rowsets[run_index] = rowset;
+        _merged_rows += merged_rows;
+        DorisMetrics::instance()->schema_change_sorted_rows_total->increment(rows);
+        DorisMetrics::instance()->schema_change_sorted_runs_total->increment(1);
+    } else if (_status.ok()) {
+        _status = st;
+    }
+    --_num_runs_in_flight;
+    _cv.notify_all();
+}
+
+Status SchemaChangeRunWriter::finish(std::vector<RowsetSharedPtr>* rowsets,
+                                     uint64_t* merged_rows) {
+    RETURN_IF_ERROR(flush());
+    if (_pool != nullptr) {
+        _pool->wait();
+    }
+    std::lock_guard<std::mutex> l(_lock);
+    RETURN_IF_ERROR(_status);
+    *rowsets = std::move(_rowsets);
+    _rowsets.clear();
+    *merged_rows = _merged_rows;
+    return Status::OK();
+}
+
 VSchemaChangeWithSorting::VSchemaChangeWithSorting(const BlockChanger& changer,
                                                    size_t memory_limitation)
         : _changer(changer),
@@ -502,17 +675,16 @@ Status VSchemaChangeWithSorting::_inner_process(RowsetReaderSharedPtr rowset_rea
                                                 RowsetWriter* rowset_writer,
                                                 TabletSharedPtr new_tablet,
                                                 TabletSchemaSPtr base_tablet_schema) {
-    // for internal sorting
-    std::vector<std::unique_ptr<vectorized::Block>> blocks;
-
     // for external sorting
-    // src_rowsets to store the rowset generated by internal sorting
+    // src_rowsets to store the rowset generated by internal sorting, in the order of versions
     std::vector<RowsetSharedPtr> src_rowsets;
 
     Defer defer {[&]() {
         // remove the intermediate rowsets generated by internal sorting
         for (auto& row_set : src_rowsets) {
-            StorageEngine::instance()->add_unused_rowset(row_set);
+            if (row_set != nullptr) {
+                StorageEngine::instance()->add_unused_rowset(row_set);
+            }
         }
     }};
 
@@ -520,27 +692,23 @@ Status VSchemaChangeWithSorting::_inner_process(RowsetReaderSharedPtr rowset_rea
     SegmentsOverlapPB segments_overlap = rowset->rowset_meta()->segments_overlap();
     int64_t newest_write_timestamp = rowset->newest_write_timestamp();
     _temp_delta_versions.first = _temp_delta_versions.second;
-
-    auto create_rowset = [&]() -> Status {
-        if (blocks.empty()) {
-            return Status::OK();
-        }
-
-        RowsetSharedPtr rowset;
-        RETURN_IF_ERROR(_internal_sorting(
-                blocks, Version(_temp_delta_versions.second, _temp_delta_versions.second),
-                newest_write_timestamp, new_tablet, BETA_ROWSET, segments_overlap, &rowset));
-        src_rowsets.push_back(rowset);
-
-        for (auto& block : blocks) {
-            _mem_tracker->release(block->allocated_bytes());
-        }
-        blocks.clear();
-
-        // increase temp version
-        _temp_delta_versions.second++;
-        return Status::OK();
-    };
+    int64_t first_version = _temp_delta_versions.first;
+
+    bool is_percent = false;
+    int64_t total_mem_limit = ParseUtil::parse_mem_spec(config::schema_change_sort_mem_limit, -1,
+                                                        MemInfo::mem_limit(), &is_percent);
+    // the runs are sorted and written by the pool while the next run is read, each run gets a
+    // temp version in the order of the runs
+    SchemaChangeRunWriter run_writer(
+            config::schema_change_sort_parallelism, _memory_limitation, total_mem_limit,
+            _mem_tracker.get(),
+            [&](const SchemaChangeRunWriter::Blocks& blocks, size_t run_index,
+                RowsetSharedPtr* run_rowset, uint64_t* merged_rows) {
+                int64_t version = first_version + run_index;
+                return _internal_sorting(blocks, Version(version, version),
+                                         newest_write_timestamp, new_tablet, BETA_ROWSET,
+                                         segments_overlap, run_rowset, merged_rows);
+            });
 
     auto new_block = vectorized::Block::create_unique(new_tablet->tablet_schema()->create_block());
 
@@ -552,26 +720,22 @@ Status VSchemaChangeWithSorting::_inner_process(RowsetReaderSharedPtr rowset_rea
         }
 
         RETURN_IF_ERROR(_changer.change_block(ref_block.get(), new_block.get()));
-        if (_mem_tracker->consumption() + new_block->allocated_bytes() > _memory_limitation) {
-            RETURN_IF_ERROR(create_rowset());
-
-            if (_mem_tracker->consumption() + new_block->allocated_bytes() > _memory_limitation) {
-                LOG(WARNING) << "Memory limitation is too small for Schema Change."
-                             << " _memory_limitation=" << _memory_limitation
-                             << ", new_block->allocated_bytes()=" << new_block->allocated_bytes()
-                             << ", consumption=" << _mem_tracker->consumption();
-                return Status::Error<INVALID_ARGUMENT>();
-            }
+        if (new_block->allocated_bytes() > _memory_limitation) {
+            LOG(WARNING) << "Memory limitation is too small for Schema Change."
+                         << " _memory_limitation=" << _memory_limitation
+                         << ", new_block->allocated_bytes()=" << new_block->allocated_bytes()
+                         << ", consumption=" << _mem_tracker->consumption();
+            return Status::Error<INVALID_ARGUMENT>();
         }
-        _mem_tracker->consume(new_block->allocated_bytes());
-
-        // move unique ptr
-        blocks.push_back(
-                vectorized::Block::create_unique(new_tablet->tablet_schema()->create_block()));
-        swap(blocks.back(), new_block);
+        RETURN_IF_ERROR(run_writer.add_block(std::move(new_block)));
+        new_block = vectorized::Block::create_unique(new_tablet->tablet_schema()->create_block());
     } while (true);
 
-    RETURN_IF_ERROR(create_rowset());
+    uint64_t merged_rows = 0;
+    RETURN_IF_ERROR(run_writer.finish(&src_rowsets, &merged_rows));
+    // increase temp version
+    _temp_delta_versions.second = first_version + src_rowsets.size();
+    _add_merged_rows(merged_rows);
 
     if (src_rowsets.empty()) {
         RETURN_IF_ERROR(rowset_writer->flush());
@@ -585,8 +749,7 @@ Status VSchemaChangeWithSorting::_inner_process(RowsetReaderSharedPtr rowset_rea
 Status VSchemaChangeWithSorting::_internal_sorting(
         const std::vector<std::unique_ptr<vectorized::Block>>& blocks, const Version& version,
         int64_t newest_write_timestamp, TabletSharedPtr new_tablet, RowsetTypePB new_rowset_type,
-        SegmentsOverlapPB segments_overlap, RowsetSharedPtr* rowset) {
-    uint64_t merged_rows = 0;
+        SegmentsOverlapPB segments_overlap, RowsetSharedPtr* rowset, uint64_t* merged_rows) {
     MultiBlockMerger merger(new_tablet);
 
     std::unique_ptr<RowsetWriter> rowset_writer;
@@ -603,9 +766,8 @@ Status VSchemaChangeWithSorting::_internal_sorting(
                                                    rowset_writer->rowset_id().to_string());
     }};
 
-    RETURN_IF_ERROR(merger.merge(blocks, rowset_writer.get(), &merged_rows));
+    RETURN_IF_ERROR(merger.merge(blocks, rowset_writer.get(), merged_rows));
 
-    _add_merged_rows(merged_rows);
     *rowset = rowset_writer->build();
     return Status::OK();
 }
@@ -1292,6 +1454,14 @@ Status SchemaChangeHandler::_do_process_alter_inverted_index(
     // get rowset reader
     std::vector<RowsetReaderSharedPtr> rs_readers;
     RETURN_IF_ERROR(_get_rowset_readers(tablet, tablet_schema, request, &rs_readers));
+    for (auto& rs_reader : rs_readers) {
+        // inverted index files in a packed segment file can't be changed in place
+        if (rs_reader->rowset()->rowset_meta()->is_segments_packed()) {
+            return Status::NotSupported(
+                    "can not alter inverted index of rowset {} with packed segment files",
+                    rs_reader->rowset()->rowset_id().to_string());
+        }
+    }
     if (request.__isset.is_drop_op && request.is_drop_op) {
         // drop index
         res = _drop_inverted_index(rs_readers, tablet_schema, tablet, request);
@@ -24,7 +24,10 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <shared_mutex>
@@ -54,7 +57,9 @@ class DeleteHandler;
 class Field;
 class TAlterInvertedIndexReq;
 class TAlterTabletReqV2;
+class MemTrackerLimiter;
 class TExpr;
+class ThreadPool;
 enum AlterTabletType : int;
 enum RowsetTypePB : int;
 enum SegmentsOverlapPB : int;
@@ -194,6 +199,60 @@ private:
     const BlockChanger& _changer;
 };
 
+// Sorts and writes the runs of a sorting schema change by a thread pool while the next run is
+// read. The blocks of the run being read and of the runs queued or being written share the
+// memory limit of the schema change, all sorting schema changes of the BE share
+// `total_mem_limit`. Reading waits for the runs in flight when a limit is reached.
+class SchemaChangeRunWriter {
+public:
+    using Blocks = std::vector<std::unique_ptr<vectorized::Block>>;
+    // sort the blocks of the `run_index`th run and write them to `rowset`
+    using WriteRunFunc = std::function<Status(const Blocks& blocks, size_t run_index,
+                                              RowsetSharedPtr* rowset, uint64_t* merged_rows)>;
+
+    SchemaChangeRunWriter(int num_threads, int64_t mem_limit, int64_t total_mem_limit,
+                          MemTracker* mem_tracker, WriteRunFunc write_run);
+    // waits for the runs in flight
+    ~SchemaChangeRunWriter();
+
+    // add a block to the current run, the current run is submitted first if the block
+    // doesn't fit into it
+    Status add_block(std::unique_ptr<vectorized::Block> block);
+
+    // submit the current run
+    Status flush();
+
+    // wait for all runs, `rowsets` are in the order of the runs
+    Status finish(std::vector<RowsetSharedPtr>* rowsets, uint64_t* merged_rows);
+
+    // bytes of the blocks held by all sorting schema changes of the BE
+    static int64_t total_mem_usage();
+
+private:
+    bool _exceeds_mem_limit(int64_t bytes) const;
+    void _write_run(const std::shared_ptr<Blocks>& blocks, int64_t bytes, size_t run_index);
+
+    int64_t _mem_limit;
+    // max bytes of a run, so that runs in flight and the current run fit into _mem_limit
+    int64_t _run_mem_limit;
+    int64_t _total_mem_limit;
+    MemTracker* _mem_tracker;
+    // the tracker of the schema change task, attached to the threads writing runs
+    std::shared_ptr<MemTrackerLimiter> _task_mem_tracker;
+    WriteRunFunc _write_run_func;
+    std::unique_ptr<ThreadPool> _pool;
+
+    Blocks _blocks;
+    int64_t _blocks_bytes = 0;
+
+    std::mutex _lock;
+    std::condition_variable _cv;
+    Status _status;
+    size_t _num_runs_in_flight = 0;
+    std::vector<RowsetSharedPtr> _rowsets;
+    uint64_t _merged_rows = 0;
+};
+
 // @breif schema change with sorting
 class VSchemaChangeWithSorting : public SchemaChange {
 public:
@@ -204,10 +263,13 @@ private:
     Status _inner_process(RowsetReaderSharedPtr rowset_reader, RowsetWriter* rowset_writer,
                           TabletSharedPtr new_tablet, TabletSchemaSPtr base_tablet_schema) override;
 
+    // Sort `blocks` and write them to a new rowset, could be called by multiple threads
+    // concurrently.
     Status _internal_sorting(const std::vector<std::unique_ptr<vectorized::Block>>& blocks,
                              const Version& temp_delta_versions, int64_t newest_write_timestamp,
                              TabletSharedPtr new_tablet, RowsetTypePB new_rowset_type,
-                             SegmentsOverlapPB segments_overlap, RowsetSharedPtr* rowset);
+                             SegmentsOverlapPB segments_overlap, RowsetSharedPtr* rowset,
+                             uint64_t* merged_rows);
 
     Status _external_sorting(std::vector<RowsetSharedPtr>& src_rowsets, RowsetWriter* rowset_writer,
                              TabletSharedPtr new_tablet);
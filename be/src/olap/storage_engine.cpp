@@ -155,10 +155,15 @@ StorageEngine::~StorageEngine() {
     if (_tablet_meta_checkpoint_thread_pool) {
         _tablet_meta_checkpoint_thread_pool->shutdown();
     }
+    if (_vertical_compaction_thread_pool) {
+        _vertical_compaction_thread_pool->shutdown();
+    }
     _s_instance = nullptr;
 }
 
 void StorageEngine::load_data_dirs(const std::vector<DataDir*>& data_dirs) {
+    MonotonicStopWatch watch;
+    watch.start();
     std::vector<std::thread> threads;
     for (auto data_dir : data_dirs) {
         threads.emplace_back([data_dir] {
@@ -173,6 +178,8 @@ void StorageEngine::load_data_dirs(const std::vector<DataDir*>& data_dirs) {
     for (auto& thread : threads) {
         thread.join();
     }
+    LOG(INFO) << "finish to load data dirs, num=" << data_dirs.size()
+              << ", cost(ms)=" << watch.elapsed_time() / 1000000;
 }
 
 Status StorageEngine::_open() {
@@ -546,6 +553,7 @@ void StorageEngine::stop() {
     THREAD_JOIN(_garbage_sweeper_thread);
     THREAD_JOIN(_disk_stat_monitor_thread);
     THREAD_JOIN(_fd_cache_clean_thread);
+    THREAD_JOIN(_tablet_init_thread);
     THREAD_JOIN(_tablet_checkpoint_tasks_producer_thread);
 #undef THREAD_JOIN
 
@@ -197,6 +197,10 @@ public:
     }
     bool stopped() { return _stopped; }
     ThreadPool* get_bg_multiget_threadpool() { return _bg_multi_get_thread_pool.get(); }
+    // may be nullptr when parallel value column group merging is disabled
+    ThreadPool* vertical_compaction_thread_pool() {
+        return _vertical_compaction_thread_pool.get();
+    }
 
 private:
     // Instance should be inited from `static open()`
@@ -237,6 +241,9 @@ private:
     // clean file descriptors cache
     void _fd_cache_clean_callback();
 
+    // init tablets which are loaded lazily when BE starts
+    void _tablet_init_callback();
+
     // path gc process function
     void _path_gc_thread_callback(DataDir* data_dir);
 
@@ -345,6 +352,8 @@ private:
     // thread to produce both base and cumulative compaction tasks
     scoped_refptr<Thread> _compaction_tasks_producer_thread;
     scoped_refptr<Thread> _fd_cache_clean_thread;
+    // thread to init tablets which are loaded lazily
+    scoped_refptr<Thread> _tablet_init_thread;
     // threads to clean all file descriptor not actively in use
     std::vector<scoped_refptr<Thread>> _path_gc_threads;
     // threads to scan disk paths
@@ -382,6 +391,7 @@ private:
 
     std::unique_ptr<ThreadPool> _tablet_meta_checkpoint_thread_pool;
     std::unique_ptr<ThreadPool> _bg_multi_get_thread_pool;
+    std::unique_ptr<ThreadPool> _vertical_compaction_thread_pool;
 
     CompactionPermitLimiter _permit_limiter;
 
@@ -293,6 +293,9 @@ Status Tablet::_init_once_action() {
         _rowset_tree = std::make_unique<RowsetTree>();
         res = _rowset_tree->Init(rowset_vec);
     }
+    if (res.ok()) {
+        _add_rowsets_on_load();
+    }
     return res;
 }
 
@@ -300,6 +303,33 @@ Status Tablet::init() {
     return _init_once.call([this] { return _init_once_action(); });
 }
 
+Status Tablet::add_rowset_on_load(RowsetSharedPtr rowset) {
+    {
+        std::lock_guard l(_rowsets_on_load_lock);
+        if (!_rowsets_on_load_added) {
+            _rowsets_on_load.push_back(std::move(rowset));
+            return Status::OK();
+        }
+    }
+    return add_rowset(rowset);
+}
+
+void Tablet::_add_rowsets_on_load() {
+    std::vector<RowsetSharedPtr> rowsets;
+    {
+        std::lock_guard l(_rowsets_on_load_lock);
+        rowsets.swap(_rowsets_on_load);
+        _rowsets_on_load_added = true;
+    }
+    for (auto& rowset : rowsets) {
+        Status st = add_rowset(rowset);
+        if (!st.ok() && !st.is<PUSH_VERSION_ALREADY_EXIST>()) {
+            LOG(WARNING) << "add visible rowset to tablet failed rowset_id:" << rowset->rowset_id()
+                         << " tablet id: " << tablet_id() << ", st=" << st;
+        }
+    }
+}
+
 // should save tablet meta to remote meta store
 // if it's a primary replica
 void Tablet::save_meta() {
@@ -808,11 +838,35 @@ void Tablet::delete_expired_stale_rowset() {
                 << " old_meta_size=" << old_meta_size << " sweep endtime " << std::fixed
                 << expired_stale_sweep_endtime << ", reconstructed=" << reconstructed;
 
+    if (enable_unique_key_merge_on_write() && config::enable_delete_bitmap_version_fold) {
+        _fold_delete_bitmap_versions_unlocked();
+    }
+
 #ifndef BE_TEST
     save_meta();
 #endif
 }
 
+void Tablet::_fold_delete_bitmap_versions_unlocked() {
+    // A reader can only read a version which is the end version of a rowset in
+    // the version graph, so no reader reads below the minimum end version of the
+    // remaining rowsets and stale rowsets.
+    int64_t min_readable_version = std::numeric_limits<int64_t>::max();
+    for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
+        min_readable_version = std::min(min_readable_version, rs_meta->end_version());
+    }
+    for (auto& rs_meta : _tablet_meta->all_stale_rs_metas()) {
+        min_readable_version = std::min(min_readable_version, rs_meta->end_version());
+    }
+    if (min_readable_version == std::numeric_limits<int64_t>::max()) {
+        return;
+    }
+    size_t removed = _tablet_meta->delete_bitmap().fold_versions(min_readable_version);
+    VLOG_NOTICE << "fold delete bitmap versions, tablet=" << full_name()
+                << ", min_readable_version=" << min_readable_version
+                << ", removed_bitmaps=" << removed;
+}
+
 bool Tablet::_reconstruct_version_tracker_if_necessary() {
     double orphan_vertex_ratio = _timestamped_version_tracker.get_orphan_vertex_ratio();
     if (orphan_vertex_ratio >= config::tablet_version_graph_orphan_vertex_ratio) {
@@ -1533,9 +1587,10 @@ void Tablet::build_tablet_report_info(TTabletInfo* tablet_info,
     } else {
         tablet_info->__set_version_miss(cversion.second < max_version.second);
     }
-    // find rowset with max version
-    auto iter = _rs_version_map.find(max_version);
-    if (iter == _rs_version_map.end()) {
+    // find rowset with max version, rowsets of a tablet which is loaded lazily are not
+    // created until it's initialized
+    if (_init_once.has_called() && (!_init_once.stored_result().ok() ||
+                                    _rs_version_map.find(max_version) == _rs_version_map.end())) {
         // If the tablet is in running state, it must not be doing schema-change. so if we can not
         // access its rowsets, it means that the tablet is bad and needs to be reported to the FE
         // for subsequent repairs (through the cloning task)
@@ -141,6 +141,9 @@ public:
 
     // operation in rowsets
     Status add_rowset(RowsetSharedPtr rowset);
+    // Add a visible rowset found in the meta store when the data dir is loaded. The rowset of a
+    // tablet which is loaded lazily is added once the tablet is initialized.
+    Status add_rowset_on_load(RowsetSharedPtr rowset);
     Status create_initial_rowset(const int64_t version);
     Status modify_rowsets(std::vector<RowsetSharedPtr>& to_add,
                           std::vector<RowsetSharedPtr>& to_delete, bool check_delete = false);
@@ -487,6 +490,7 @@ public:
 
 private:
     Status _init_once_action();
+    void _add_rowsets_on_load();
     void _print_missed_versions(const std::vector<Version>& missed_versions) const;
     bool _contains_rowset(const RowsetId rowset_id);
     Status _contains_version(const Version& version);
@@ -510,6 +514,9 @@ private:
     // When the proportion of empty edges in the adjacency matrix used to represent the version graph
     // in the version tracker is greater than the threshold, rebuild the version tracker
     bool _reconstruct_version_tracker_if_necessary();
+    // Fold the delete bitmap versions below the minimum version which can still be read,
+    // must be called with _meta_lock held.
+    void _fold_delete_bitmap_versions_unlocked();
     void _init_context_common_fields(RowsetWriterContext& context);
 
     Status _check_pk_in_pre_segments(RowsetId rowset_id,
@@ -539,6 +546,10 @@ private:
     TimestampedVersionTracker _timestamped_version_tracker;
 
     DorisCallOnce<Status> _init_once;
+    std::mutex _rowsets_on_load_lock;
+    // rowsets added by add_rowset_on_load() before the tablet is initialized
+    std::vector<RowsetSharedPtr> _rowsets_on_load;
+    bool _rowsets_on_load_added = false;
     // meta store lock is used for prevent 2 threads do checkpoint concurrently
     // it will be used in econ-mode in the future
     std::shared_mutex _meta_store_lock;
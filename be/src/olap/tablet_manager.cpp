@@ -136,8 +136,17 @@ Status TabletManager::_add_tablet_unlocked(TTabletId tablet_id, const TabletShar
     int32_t old_version, new_version;
     {
         std::shared_lock rdlock(existed_tablet->get_header_lock());
-        const RowsetSharedPtr old_rowset = existed_tablet->rowset_with_max_version();
-        const RowsetSharedPtr new_rowset = tablet->rowset_with_max_version();
+        // compare the rowset metas, the rowsets of tablets loaded lazily are not created until
+        // they're initialized, which is not done under the shard lock
+        auto rs_meta_with_max_version = [](const TabletSharedPtr& t) -> RowsetMetaSharedPtr {
+            Version max_version = t->tablet_meta()->max_version();
+            if (max_version.first == -1) {
+                return nullptr;
+            }
+            return t->tablet_meta()->acquire_rs_meta_by_version(max_version);
+        };
+        const RowsetMetaSharedPtr old_rowset = rs_meta_with_max_version(existed_tablet);
+        const RowsetMetaSharedPtr new_rowset = rs_meta_with_max_version(tablet);
         // If new tablet is empty, it is a newly created schema change tablet.
         // the old tablet is dropped before add tablet. it should not exist old tablet
         if (new_rowset == nullptr) {
@@ -540,6 +549,11 @@ Status TabletManager::drop_tablets_on_error_root_path(
 }
 
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, bool include_deleted, string* err) {
+    return _init_tablet(get_tablet_without_init(tablet_id, include_deleted, err), err);
+}
+
+TabletSharedPtr TabletManager::get_tablet_without_init(TTabletId tablet_id, bool include_deleted,
+                                                       string* err) {
     std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
     return _get_tablet_unlocked(tablet_id, include_deleted, err);
 }
@@ -590,12 +604,32 @@ TabletSharedPtr TabletManager::_get_tablet_unlocked(TTabletId tablet_id, bool in
     return tablet;
 }
 
+TabletSharedPtr TabletManager::_init_tablet(TabletSharedPtr tablet, string* err) {
+    // the tablet may be loaded lazily, init it before use. Init is out of the shard lock since
+    // it may take long, and it's called once by Tablet::init().
+    if (tablet == nullptr || tablet->tablet_state() == TABLET_SHUTDOWN) {
+        return tablet;
+    }
+    Status st = tablet->init();
+    if (!st.ok()) {
+        LOG(WARNING) << "tablet init failed. tablet=" << tablet->tablet_id() << ", st=" << st;
+        if (err != nullptr) {
+            *err = "tablet init failed. " + BackendOptions::get_localhost();
+        }
+        return nullptr;
+    }
+    return tablet;
+}
+
 TabletSharedPtr TabletManager::get_tablet(TTabletId tablet_id, TabletUid tablet_uid,
                                           bool include_deleted, string* err) {
-    std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
-    TabletSharedPtr tablet = _get_tablet_unlocked(tablet_id, include_deleted, err);
+    TabletSharedPtr tablet;
+    {
+        std::shared_lock rdlock(_get_tablets_shard_lock(tablet_id));
+        tablet = _get_tablet_unlocked(tablet_id, include_deleted, err);
+    }
     if (tablet != nullptr && tablet->tablet_uid() == tablet_uid) {
-        return tablet;
+        return _init_tablet(tablet, err);
     }
     return nullptr;
 }
@@ -747,7 +781,7 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(
 Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_id,
                                             TSchemaHash schema_hash, const string& meta_binary,
                                             bool update_meta, bool force, bool restore,
-                                            bool check_path) {
+                                            bool check_path, bool lazy_init) {
     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker);
     TabletMetaSharedPtr tablet_meta(new TabletMeta());
     Status status = tablet_meta->deserialize(meta_binary);
@@ -822,8 +856,10 @@ Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_
         return Status::Error<TABLE_INDEX_VALIDATE_ERROR>();
     }
 
-    RETURN_NOT_OK_LOG(tablet->init(),
-                      strings::Substitute("tablet init failed. tablet=$0", tablet->full_name()));
+    if (!lazy_init) {
+        RETURN_NOT_OK_LOG(tablet->init(), strings::Substitute("tablet init failed. tablet=$0",
+                                                              tablet->full_name()));
+    }
 
     std::lock_guard<std::shared_mutex> wrlock(_get_tablets_shard_lock(tablet_id));
     RETURN_NOT_OK_LOG(_add_tablet_unlocked(tablet_id, tablet, update_meta, force),
@@ -944,6 +980,11 @@ Status TabletManager::start_trash_sweep() {
             {
                 std::shared_lock rdlock(tablets_shard.lock);
                 for (auto& item : tablet_map) {
+                    // skip tablets which are not initialized, they don't have stale rowsets
+                    // to delete yet
+                    if (!item.second->init_succeeded()) {
+                        continue;
+                    }
                     // try to clean empty item
                     all_tablets.push_back(item.second);
                 }
@@ -1334,7 +1375,7 @@ void TabletManager::get_cooldown_tablets(std::vector<TabletSharedPtr>* tablets,
     }
     auto get_cooldown_tablet = [&sort_ctx_vec, &skip_tablet](std::weak_ptr<Tablet>& t) {
         const TabletSharedPtr& tablet = t.lock();
-        if (UNLIKELY(nullptr == tablet)) {
+        if (UNLIKELY(nullptr == tablet) || !tablet->init_succeeded()) {
             return;
         }
         std::shared_lock rdlock(tablet->get_header_lock());
@@ -1371,13 +1412,39 @@ void TabletManager::get_all_tablets_storage_format(TCheckStorageFormatResult* re
     result->__isset.v2_tablets = true;
 }
 
+void TabletManager::init_all_tablets(const std::function<bool()>& stop) {
+    auto tablets = get_all_tablet([](Tablet* t) { return t->is_used() && !t->init_succeeded(); });
+    LOG(INFO) << "begin to init tablets which are loaded lazily, num=" << tablets.size();
+    MonotonicStopWatch watch;
+    watch.start();
+    size_t num_failed = 0;
+    for (size_t i = 0; i < tablets.size(); ++i) {
+        if (stop()) {
+            LOG(INFO) << "stop to init tablets, inited " << i << " tablets";
+            return;
+        }
+        Status st = tablets[i]->init();
+        if (!st.ok()) {
+            LOG(WARNING) << "tablet init failed. tablet=" << tablets[i]->full_name()
+                         << ", st=" << st;
+            ++num_failed;
+        }
+    }
+    LOG(INFO) << "finish to init tablets which are loaded lazily, num=" << tablets.size()
+              << ", failed=" << num_failed << ", cost(ms)=" << watch.elapsed_time() / 1000000;
+}
+
 std::set<int64_t> TabletManager::check_all_tablet_segment(bool repair) {
     std::set<int64_t> bad_tablets;
+    // init the tablets loaded lazily out of the shard lock, init() below is a no-op for them then
+    for (const auto& tablet : get_all_tablet([](Tablet* t) { return !t->init_succeeded(); })) {
+        static_cast<void>(tablet->init());
+    }
     for (const auto& tablets_shard : _tablets_shards) {
         std::lock_guard<std::shared_mutex> wrlock(tablets_shard.lock);
         for (const auto& item : tablets_shard.tablet_map) {
             TabletSharedPtr tablet = item.second;
-            if (!tablet->check_all_rowset_segment()) {
+            if (!tablet->init().ok() || !tablet->check_all_rowset_segment()) {
                 bad_tablets.insert(tablet->tablet_id());
                 if (repair) {
                     tablet->set_tablet_state(TABLET_SHUTDOWN);
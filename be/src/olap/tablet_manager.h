@@ -82,6 +82,10 @@ public:
     TabletSharedPtr get_tablet(TTabletId tablet_id, bool include_deleted = false,
                                std::string* err = nullptr);
 
+    // Like get_tablet(), but doesn't init the tablet if it's loaded lazily
+    TabletSharedPtr get_tablet_without_init(TTabletId tablet_id, bool include_deleted = false,
+                                            std::string* err = nullptr);
+
     std::pair<TabletSharedPtr, Status> get_tablet_and_status(TTabletId tablet_id,
                                                              bool include_deleted = false);
 
@@ -125,9 +129,12 @@ public:
     // parse tablet header msg to generate tablet object
     // - restore: whether the request is from restore tablet action,
     //   where we should change tablet status from shutdown back to running
+    // - lazy_init: don't init the tablet now, it's initialized when got by get_tablet()
+    //   for the first time or by init_all_tablets()
     Status load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_id, TSchemaHash schema_hash,
                                  const std::string& header, bool update_meta, bool force = false,
-                                 bool restore = false, bool check_path = true);
+                                 bool restore = false, bool check_path = true,
+                                 bool lazy_init = false);
 
     Status load_tablet_from_dir(DataDir* data_dir, TTabletId tablet_id, SchemaHash schema_hash,
                                 const std::string& schema_hash_path, bool force = false,
@@ -167,6 +174,9 @@ public:
 
     void get_all_tablets_storage_format(TCheckStorageFormatResult* result);
 
+    // Init tablets which are loaded lazily when BE starts, return early if `stop` returns true
+    void init_all_tablets(const std::function<bool()>& stop);
+
     std::set<int64_t> check_all_tablet_segment(bool repair);
 
 private:
@@ -190,6 +200,8 @@ private:
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id);
     TabletSharedPtr _get_tablet_unlocked(TTabletId tablet_id, bool include_deleted,
                                          std::string* err);
+    // init a tablet which may be loaded lazily, must be called without the shard lock
+    TabletSharedPtr _init_tablet(TabletSharedPtr tablet, std::string* err);
 
     TabletSharedPtr _internal_create_tablet_unlocked(const TCreateTabletReq& request,
                                                      const bool is_schema_change,
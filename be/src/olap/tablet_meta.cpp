@@ -974,6 +974,41 @@ uint64_t DeleteBitmap::cardinality() {
     return cardinality;
 }
 
+size_t DeleteBitmap::fold_versions(Version version) {
+    std::lock_guard l(lock);
+    size_t removed = 0;
+    auto it = delete_bitmap.begin();
+    while (it != delete_bitmap.end()) {
+        auto [rowset_id, segment_id, ver] = it->first;
+        if (ver > version) {
+            ++it;
+            continue;
+        }
+        // [it, end) are the bitmaps of this segment which can be folded
+        auto end = std::next(it);
+        while (end != delete_bitmap.end() && std::get<0>(end->first) == rowset_id &&
+               std::get<1>(end->first) == segment_id && std::get<2>(end->first) <= version) {
+            ++end;
+        }
+        size_t num_bitmaps = std::distance(it, end);
+        if (num_bitmaps == 1) {
+            it = end;
+            continue;
+        }
+        roaring::Roaring folded;
+        for (auto i = it; i != end; ++i) {
+            folded |= i->second;
+        }
+        folded.runOptimize();
+        it = delete_bitmap.erase(it, end);
+        it = delete_bitmap.emplace_hint(it, BitmapKey {rowset_id, segment_id, version},
+                                        std::move(folded));
+        ++it;
+        removed += num_bitmaps - 1;
+    }
+    return removed;
+}
+
 // We cannot just copy the underlying memory to construct a string
 // due to equivalent objects may have different padding bytes.
 // Reading padding bytes is undefined behavior, neither copy nor
@@ -391,6 +391,16 @@ public:
 
     uint64_t cardinality();
 
+    /**
+     * Folds the bitmaps of each segment whose version <= the given version
+     * into one bitmap at the given version. The aggregated result of any
+     * version >= the given one does not change, so the given version must not
+     * be greater than the minimum version that can still be read.
+     *
+     * @return number of bitmaps removed
+     */
+    size_t fold_versions(Version version);
+
     /**
      * Checks if the given row is marked deleted in bitmap with the condition:
      * all the bitmaps that
@@ -27,6 +27,8 @@
 #include <gen_cpp/Types_constants.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <memory>
 #include <mutex>
@@ -62,6 +64,7 @@
 #include "util/defer_op.h"
 #include "util/network_util.h"
 #include "util/stopwatch.hpp"
+#include "util/threadpool.h"
 #include "util/thrift_rpc_helper.h"
 
 using std::set;
@@ -431,10 +434,11 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
     }
 
     // Get copy from remote
-    uint64_t total_file_size = 0;
+    std::atomic<uint64_t> total_file_size = 0;
     MonotonicStopWatch watch;
     watch.start();
-    for (auto& file_name : file_name_list) {
+    auto download_file = [data_dir, &remote_url_prefix, &local_path,
+                          &total_file_size](const std::string& file_name) -> Status {
         auto remote_file_url = remote_url_prefix + file_name;
 
         // get file length
@@ -469,9 +473,14 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
                             file_size](HttpClient* client) {
             RETURN_IF_ERROR(client->init(remote_file_url));
             client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
-
+            // a retry resumes from the bytes downloaded by the failed attempt
             std::error_code ec;
+            uint64_t offset = std::filesystem::file_size(local_file_path, ec);
+            if (ec || offset >= file_size) {
+                offset = 0;
+            }
+            RETURN_IF_ERROR(client->download(local_file_path, offset));
+
             // Check file length
             uint64_t local_file_size = std::filesystem::file_size(local_file_path, ec);
             if (ec) {
@@ -488,19 +497,60 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
             chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
             return Status::OK();
         };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
-    } // Clone files from remote backend
+        return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+    };
+
+    // the data files are downloaded concurrently, the header file is the last one of the list
+    // and downloaded after all of them
+    int num_threads = std::max(config::clone_download_files_parallelism, 1);
+    std::unique_ptr<ThreadPool> download_pool;
+    if (num_threads > 1 && file_name_list.size() > 2) {
+        ThreadPoolBuilder("CloneDownloadThreadPool")
+                .set_min_threads(0)
+                .set_max_threads(num_threads)
+                .build(&download_pool);
+    }
+    std::mutex status_lock;
+    Status download_status;
+    for (size_t i = 0; i + 1 < file_name_list.size(); ++i) {
+        auto task = [&download_file, &status_lock, &download_status,
+                     &file_name = file_name_list[i]]() {
+            {
+                std::lock_guard<std::mutex> l(status_lock);
+                if (!download_status.ok()) {
+                    return;
+                }
+            }
+            Status st = download_file(file_name);
+            if (!st.ok()) {
+                std::lock_guard<std::mutex> l(status_lock);
+                if (download_status.ok()) {
+                    download_status = st;
+                }
+            }
+        };
+        if (download_pool == nullptr || !download_pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+    if (download_pool != nullptr) {
+        download_pool->wait();
+    }
+    RETURN_IF_ERROR(download_status);
+    if (!file_name_list.empty()) {
+        RETURN_IF_ERROR(download_file(file_name_list.back()));
+    }
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
     total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
     double copy_rate = 0.0;
     if (total_time_ms > 0) {
-        copy_rate = total_file_size / ((double)total_time_ms) / 1000;
+        copy_rate = total_file_size.load() / ((double)total_time_ms) / 1000;
     }
-    _copy_size = (int64_t)total_file_size;
+    _copy_size = (int64_t)total_file_size.load();
     _copy_time_ms = (int64_t)total_time_ms;
-    LOG(INFO) << "succeed to copy tablet " << _signature << ", total file size: " << total_file_size
-              << " B"
+    LOG(INFO) << "succeed to copy tablet " << _signature
+              << ", total file size: " << total_file_size.load() << " B"
               << ", cost: " << total_time_ms << " ms"
               << ", rate: " << copy_rate << " MB/s";
     return Status::OK();
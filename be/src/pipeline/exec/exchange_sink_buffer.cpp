@@ -220,6 +220,7 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
         auto brpc_request = _instance_to_request[id];
         brpc_request->set_eos(request.eos);
         brpc_request->set_packet_seq(_instance_to_seq[id]++);
+        brpc_request->set_transfer_by_attachment(false);
         if (request.block) {
             brpc_request->set_allocated_block(request.block.get());
         }
@@ -268,6 +269,12 @@ Status ExchangeSinkBuffer::_send_rpc(InstanceLoId id) {
         auto* _closure =
                 new SelfDeleteClosure<PTransmitDataResult>(id, request.eos, request.block_holder);
         _closure->cntl.set_timeout_ms(request.channel->_brpc_timeout_ms);
+        // the column values are shared with the requests to other channels
+        const auto& column_values = request.block_holder->column_values_attachment();
+        brpc_request->set_transfer_by_attachment(!column_values.empty());
+        if (!column_values.empty()) {
+            _closure->cntl.request_attachment().append(column_values);
+        }
         _closure->addFailedHandler(
                 [&](const InstanceLoId& id, const std::string& err) { _failed(id, err); });
         _closure->addSuccessHandler([&](const InstanceLoId& id, const bool& eos,
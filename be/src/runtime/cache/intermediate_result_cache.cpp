@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/cache/intermediate_result_cache.h"
+
+#include <glog/logging.h>
+
+#include "vec/columns/column.h"
+
+namespace doris {
+
+IntermediateResultCache* IntermediateResultCache::_s_instance = nullptr;
+
+IntermediateResultCache::IntermediateResultCache(int64_t capacity, uint32_t num_shards) {
+    _cache = std::unique_ptr<Cache>(new_lru_cache("IntermediateResultCache", capacity,
+                                                  LRUCacheType::SIZE, num_shards));
+}
+
+void IntermediateResultCache::create_global_cache(int64_t capacity, uint32_t num_shards) {
+    DCHECK(_s_instance == nullptr);
+    if (capacity <= 0) {
+        return;
+    }
+    static IntermediateResultCache instance(capacity, num_shards);
+    _s_instance = &instance;
+}
+
+IntermediateResultCache* IntermediateResultCache::instance() {
+    return _s_instance;
+}
+
+bool IntermediateResultCache::_lookup(const std::string& encoded_key, CacheHandle* handle) {
+    auto lru_handle = _cache->lookup(encoded_key);
+    if (!lru_handle) {
+        // cache miss
+        return false;
+    }
+    *handle = CacheHandle(_cache.get(), lru_handle);
+    return true;
+}
+
+void IntermediateResultCache::_insert(const std::string& encoded_key, Blocks&& blocks) {
+    auto deleter = [](const doris::CacheKey& key, void* value) {
+        delete static_cast<Blocks*>(value);
+    };
+    size_t charge = sizeof(Blocks) + blocks.capacity() * sizeof(vectorized::Block);
+    for (const auto& block : blocks) {
+        charge += block.allocated_bytes();
+    }
+    auto* cache_value = new Blocks(std::move(blocks));
+    // the blocks are copied by the scanner under the query's tracker, the cache transfers the
+    // charge to its own tracker, and back to the thread which evicts the entry and frees them
+    auto handle = _cache->insert(encoded_key, cache_value, charge, deleter, CachePriority::NORMAL);
+    // handle will released
+    auto tmp = CacheHandle {_cache.get(), handle};
+}
+
+void IntermediateResultCache::append_block(const vectorized::Block& src,
+                                           vectorized::Block* dst) {
+    DCHECK_EQ(src.columns(), dst->columns());
+    auto columns = dst->mutate_columns();
+    for (size_t i = 0; i < columns.size(); ++i) {
+        columns[i]->insert_range_from(*src.get_by_position(i).column, 0, src.rows());
+    }
+    dst->set_columns(std::move(columns));
+}
+
+bool ResultCacheScanContext::next_cached_block(vectorized::Block* block) {
+    while (_handle_idx < _handles.size()) {
+        const auto& blocks = _handles[_handle_idx].blocks();
+        if (_block_idx < blocks.size()) {
+            IntermediateResultCache::append_block(blocks[_block_idx++], block);
+            return true;
+        }
+        // release the replayed entry
+        _handles[_handle_idx++] = IntermediateResultCache::CacheHandle();
+        _block_idx = 0;
+    }
+    return false;
+}
+
+void ResultCacheScanContext::begin_entry() {
+    _reset_entry();
+    _copying = true;
+}
+
+void ResultCacheScanContext::add_block(const vectorized::Block& block) {
+    if (!_copying || block.rows() == 0) {
+        return;
+    }
+    auto cached_block = block.clone_empty();
+    IntermediateResultCache::append_block(block, &cached_block);
+    _bytes += cached_block.allocated_bytes();
+    _blocks.push_back(std::move(cached_block));
+    if (_bytes > _max_entry_bytes) {
+        _reset_entry();
+    }
+}
+
+void ResultCacheScanContext::_reset_entry() {
+    _copying = false;
+    IntermediateResultCache::Blocks().swap(_blocks);
+    _bytes = 0;
+}
+
+} // namespace doris
@@ -0,0 +1,206 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <butil/macros.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "olap/lru_cache.h"
+#include "olap/olap_common.h"
+#include "util/mysql_global.h"
+#include "vec/core/block.h"
+
+namespace doris {
+
+// IntermediateResultCache is a LRU cache for the output blocks of a cacheable sub-plan on one
+// tablet, so that a query repeating the sub-plan on the same version of the tablet replays
+// the blocks instead of reading the tablet again. The entries are evicted by their bytes.
+class IntermediateResultCache {
+public:
+    // The cache key, the digest is computed by FE from the sub-plan and covers everything
+    // which affects its output except the tablet and the version.
+    struct Key {
+        Key(int64_t digest, int64_t tablet_id, int64_t version)
+                : digest(digest), tablet_id(tablet_id), version(version) {}
+        int64_t digest;
+        int64_t tablet_id;
+        int64_t version;
+
+        // Encode to a flat binary which can be used as LRUCache's key
+        std::string encode() const {
+            std::string full_key;
+            full_key.resize(sizeof(int64_t) * 3);
+            int8store(&full_key[0], digest);
+            int8store(&full_key[sizeof(int64_t)], tablet_id);
+            int8store(&full_key[sizeof(int64_t) * 2], version);
+            return full_key;
+        }
+    };
+
+    // The cache key of the output of a sub-plan on one rowset, which is immutable, so that
+    // the output on the old rowsets of a tablet is reused after new rowsets are added.
+    struct RowsetKey {
+        RowsetKey(int64_t digest, const RowsetId& rowset_id)
+                : digest(digest), rowset_id(rowset_id) {}
+        int64_t digest;
+        RowsetId rowset_id;
+
+        std::string encode() const {
+            std::string full_key;
+            full_key.resize(sizeof(int64_t) * 4);
+            int8store(&full_key[0], digest);
+            int8store(&full_key[sizeof(int64_t)], rowset_id.hi);
+            int8store(&full_key[sizeof(int64_t) * 2], rowset_id.mi);
+            int8store(&full_key[sizeof(int64_t) * 3], rowset_id.lo);
+            return full_key;
+        }
+    };
+
+    using Blocks = std::vector<vectorized::Block>;
+
+    // A handle for IntermediateResultCache entry, which releases the entry when it is
+    // destroyed.
+    class CacheHandle {
+    public:
+        CacheHandle() = default;
+        CacheHandle(Cache* cache, Cache::Handle* handle) : _cache(cache), _handle(handle) {}
+        ~CacheHandle() {
+            if (_handle != nullptr) {
+                _cache->release(_handle);
+            }
+        }
+
+        CacheHandle(CacheHandle&& other) noexcept {
+            std::swap(_cache, other._cache);
+            std::swap(_handle, other._handle);
+        }
+
+        CacheHandle& operator=(CacheHandle&& other) noexcept {
+            std::swap(_cache, other._cache);
+            std::swap(_handle, other._handle);
+            return *this;
+        }
+
+        bool valid() const { return _cache != nullptr && _handle != nullptr; }
+
+        const Blocks& blocks() const { return *static_cast<Blocks*>(_cache->value(_handle)); }
+
+    private:
+        Cache* _cache = nullptr;
+        Cache::Handle* _handle = nullptr;
+
+        // Don't allow copy and assign
+        DISALLOW_COPY_AND_ASSIGN(CacheHandle);
+    };
+
+    // Create global instance of this class, the cache is disabled if capacity <= 0
+    static void create_global_cache(int64_t capacity, uint32_t num_shards = kDefaultNumShards);
+
+    // Returns nullptr if the cache is disabled
+    static IntermediateResultCache* instance();
+
+    // Return true and write the entry into handle if the key is found.
+    bool lookup(const Key& key, CacheHandle* handle) { return _lookup(key.encode(), handle); }
+    bool lookup(const RowsetKey& key, CacheHandle* handle) {
+        return _lookup(key.encode(), handle);
+    }
+
+    // Insert the blocks of key into this cache, charged by their allocated bytes. The memory of
+    // the blocks is transferred from the tracker of the calling thread to the cache's tracker.
+    void insert(const Key& key, Blocks&& blocks) { _insert(key.encode(), std::move(blocks)); }
+    void insert(const RowsetKey& key, Blocks&& blocks) {
+        _insert(key.encode(), std::move(blocks));
+    }
+
+    // Memory consumed by the cached blocks
+    int64_t mem_consumption() { return _cache->mem_consumption(); }
+
+    // Deep copy the rows of `src` to the end of `dst`, which has the same structure.
+    static void append_block(const vectorized::Block& src, vectorized::Block* dst);
+
+private:
+    static constexpr uint32_t kDefaultNumShards = 16;
+    IntermediateResultCache(int64_t capacity, uint32_t num_shards);
+    bool _lookup(const std::string& encoded_key, CacheHandle* handle);
+    void _insert(const std::string& encoded_key, Blocks&& blocks);
+    static IntermediateResultCache* _s_instance;
+    std::unique_ptr<Cache> _cache = nullptr;
+};
+
+// The intermediate result cache state of one scanner. It replays the entries the scanner hits
+// in the order they are looked up, and copies the output the scanner reads into a new entry.
+class ResultCacheScanContext {
+public:
+    ResultCacheScanContext(IntermediateResultCache* cache, int64_t max_entry_bytes)
+            : _cache(cache), _max_entry_bytes(max_entry_bytes) {}
+
+    // Return true and queue the entry to be replayed if the key is found.
+    template <typename Key>
+    bool lookup(const Key& key) {
+        IntermediateResultCache::CacheHandle handle;
+        if (!_cache->lookup(key, &handle)) {
+            return false;
+        }
+        _handles.push_back(std::move(handle));
+        return true;
+    }
+
+    // Append the next block of the queued entries to `block`, returns false if there is none.
+    bool next_cached_block(vectorized::Block* block);
+
+    // Start copying the output of the scanner into a new entry.
+    void begin_entry();
+
+    // Copy the rows of `block` into the entry, the entry is dropped if it grows larger than
+    // max_entry_bytes.
+    void add_block(const vectorized::Block& block);
+
+    // Put the entry into the cache with `key`, nothing is put if the entry is dropped.
+    template <typename Key>
+    void finish_entry(const Key& key) {
+        if (_copying) {
+            _cache->insert(key, std::move(_blocks));
+        }
+        _reset_entry();
+    }
+
+    // Whether the output of the scanner is being copied
+    bool copying() const { return _copying; }
+
+private:
+    void _reset_entry();
+
+    IntermediateResultCache* _cache;
+    const int64_t _max_entry_bytes;
+
+    std::vector<IntermediateResultCache::CacheHandle> _handles;
+    size_t _handle_idx = 0;
+    size_t _block_idx = 0;
+
+    bool _copying = false;
+    IntermediateResultCache::Blocks _blocks;
+    int64_t _bytes = 0;
+};
+
+} // namespace doris
@@ -124,8 +124,14 @@ public:
     ThreadPool* buffered_reader_prefetch_thread_pool() {
         return _buffered_reader_prefetch_thread_pool.get();
     }
+    // may be nullptr when segment page prefetching is disabled
+    ThreadPool* segment_page_prefetch_thread_pool() {
+        return _segment_page_prefetch_thread_pool.get();
+    }
     ThreadPool* send_report_thread_pool() { return _send_report_thread_pool.get(); }
     ThreadPool* join_node_thread_pool() { return _join_node_thread_pool.get(); }
+    ThreadPool* sort_thread_pool() { return _sort_thread_pool.get(); }
+    ThreadPool* agg_thread_pool() { return _agg_thread_pool.get(); }
 
     void set_serial_download_cache_thread_token() {
         _serial_download_cache_thread_token =
@@ -218,12 +224,17 @@ private:
     std::unique_ptr<ThreadPool> _download_cache_thread_pool;
     // Threadpool used to prefetch remote file for buffered reader
     std::unique_ptr<ThreadPool> _buffered_reader_prefetch_thread_pool;
+    // Threadpool used to read data pages of segments into page cache ahead of segment iterators
+    std::unique_ptr<ThreadPool> _segment_page_prefetch_thread_pool;
     // A token used to submit download cache task serially
     std::unique_ptr<ThreadPoolToken> _serial_download_cache_thread_token;
     // Pool used by fragment manager to send profile or status to FE coordinator
     std::unique_ptr<ThreadPool> _send_report_thread_pool;
     // Pool used by join node to build hash table
     std::unique_ptr<ThreadPool> _join_node_thread_pool;
+    // Pool for sorting runs of full sorts in parallel
+    std::unique_ptr<ThreadPool> _sort_thread_pool;
+    std::unique_ptr<ThreadPool> _agg_thread_pool;
     // ThreadPoolToken -> buffer
     std::unordered_map<ThreadPoolToken*, std::unique_ptr<char[]>> _download_cache_buf_map;
     FragmentMgr* _fragment_mgr = nullptr;
@@ -45,6 +45,7 @@
 #include "pipeline/task_scheduler.h"
 #include "runtime/block_spill_manager.h"
 #include "runtime/broker_mgr.h"
+#include "runtime/cache/intermediate_result_cache.h"
 #include "runtime/cache/result_cache.h"
 #include "runtime/client_cache.h"
 #include "runtime/exec_env.h"
@@ -54,6 +55,7 @@
 #include "runtime/load_channel_mgr.h"
 #include "runtime/load_path_mgr.h"
 #include "runtime/memory/chunk_allocator.h"
+#include "runtime/memory/mem_reservation.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/memory/mem_tracker_limiter.h"
 #include "runtime/memory/thread_mem_tracker_mgr.h"
@@ -129,6 +131,14 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_threads(64)
             .build(&_buffered_reader_prefetch_thread_pool);
 
+    if (config::segment_page_prefetch_thread_num > 0) {
+        ThreadPoolBuilder("SegmentPagePrefetchThreadPool")
+                .set_min_threads(config::segment_page_prefetch_thread_num)
+                .set_max_threads(config::segment_page_prefetch_thread_num)
+                .set_max_queue_size(config::segment_page_prefetch_queue_size)
+                .build(&_segment_page_prefetch_thread_pool);
+    }
+
     // min num equal to fragment pool's min num
     // max num is useless because it will start as many as requested in the past
     // queue size is useless because the max thread num is very large
@@ -144,6 +154,20 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
             .set_max_queue_size(config::fragment_pool_queue_size)
             .build(&_join_node_thread_pool);
 
+    int sort_thread_num = config::parallel_sort_thread_num > 0 ? config::parallel_sort_thread_num
+                                                               : CpuInfo::num_cores();
+    ThreadPoolBuilder("SortThreadPool")
+            .set_min_threads(sort_thread_num)
+            .set_max_threads(sort_thread_num)
+            .build(&_sort_thread_pool);
+
+    int agg_thread_num = config::parallel_agg_thread_num > 0 ? config::parallel_agg_thread_num
+                                                             : CpuInfo::num_cores();
+    ThreadPoolBuilder("AggThreadPool")
+            .set_min_threads(agg_thread_num)
+            .set_max_threads(agg_thread_num)
+            .build(&_agg_thread_pool);
+
     RETURN_IF_ERROR(init_pipeline_task_scheduler());
     _scanner_scheduler = new doris::vectorized::ScannerScheduler();
     _fragment_mgr = new FragmentMgr(this);
@@ -231,6 +255,9 @@ Status ExecEnv::_init_mem_env() {
     int32_t index_percentage = config::index_page_cache_percentage;
     uint32_t num_shards = config::storage_page_cache_shard_size;
     StoragePageCache::create_global_cache(storage_cache_limit, index_percentage, num_shards);
+    // only the page prefetcher reads data pages concurrently with the scanners
+    StoragePageCache::instance()->set_dedupe_inflight_reads(
+            config::segment_page_prefetch_thread_num > 0);
     LOG(INFO) << "Storage page cache memory limit: "
               << PrettyPrinter::print(storage_cache_limit, TUnit::BYTES)
               << ", origin config value: " << config::storage_page_cache_limit;
@@ -248,6 +275,29 @@ Status ExecEnv::_init_mem_env() {
               << PrettyPrinter::print(row_cache_mem_limit, TUnit::BYTES)
               << ", origin config value: " << config::row_cache_mem_limit;
 
+    // Init memory reservation
+    if (config::enable_mem_reservation) {
+        int64_t mem_reservation_limit =
+                ParseUtil::parse_mem_spec(config::mem_reservation_limit, MemInfo::mem_limit(),
+                                          MemInfo::physical_mem(), &is_percent);
+        MemReservation::create_process_reservation(mem_reservation_limit);
+        LOG(INFO) << "Memory reservation limit: "
+                  << PrettyPrinter::print(mem_reservation_limit, TUnit::BYTES)
+                  << ", origin config value: " << config::mem_reservation_limit;
+    }
+
+    // Init intermediate result cache
+    int64_t intermediate_result_cache_mem_limit =
+            ParseUtil::parse_mem_spec(config::intermediate_result_cache_mem_limit,
+                                      MemInfo::mem_limit(), MemInfo::physical_mem(), &is_percent);
+    while (!is_percent && intermediate_result_cache_mem_limit > MemInfo::mem_limit() / 2) {
+        intermediate_result_cache_mem_limit = intermediate_result_cache_mem_limit / 2;
+    }
+    IntermediateResultCache::create_global_cache(intermediate_result_cache_mem_limit);
+    LOG(INFO) << "Intermediate result cache memory limit: "
+              << PrettyPrinter::print(intermediate_result_cache_mem_limit, TUnit::BYTES)
+              << ", origin config value: " << config::intermediate_result_cache_mem_limit;
+
     uint64_t fd_number = config::min_file_descriptor_number;
     struct rlimit l;
     int ret = getrlimit(RLIMIT_NOFILE, &l);
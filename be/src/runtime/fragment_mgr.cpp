@@ -20,6 +20,7 @@
 #include <bvar/latency_recorder.h>
 #include <exprs/runtime_filter.h>
 #include <fmt/format.h>
+#include <gen_cpp/Descriptors_types.h>
 #include <gen_cpp/DorisExternalService_types.h>
 #include <gen_cpp/FrontendService.h>
 #include <gen_cpp/FrontendService_types.h>
@@ -310,7 +311,9 @@ void FragmentExecState::coordinator_callback(const Status& status, RuntimeProfil
 }
 
 FragmentMgr::FragmentMgr(ExecEnv* exec_env)
-        : _exec_env(exec_env), _stop_background_threads_latch(1) {
+        : _exec_env(exec_env),
+          _desc_tbl_cache(config::fragment_desc_tbl_cache_capacity),
+          _stop_background_threads_latch(1) {
     _entity = DorisMetrics::instance()->metric_registry()->register_entity("FragmentMgr");
     INT_UGAUGE_METRIC_REGISTER(_entity, timeout_canceled_fragment_count);
     REGISTER_HOOK_METRIC(plan_fragment_count, [this]() { return _fragment_map.size(); });
@@ -345,11 +348,8 @@ FragmentMgr::~FragmentMgr() {
     _thread_pool->shutdown();
 
     // Only me can delete
-    {
-        std::lock_guard<std::mutex> lock(_lock);
-        _fragment_map.clear();
-        _query_ctx_map.clear();
-    }
+    _fragment_map.clear();
+    _query_ctx_map.clear();
 }
 
 std::string FragmentMgr::to_http_path(const std::string& file_name) {
@@ -542,12 +542,9 @@ void FragmentMgr::_exec_actual(std::shared_ptr<FragmentExecState> exec_state,
     }
 
     // remove exec state after this fragment finished
-    {
-        std::lock_guard<std::mutex> lock(_lock);
-        _fragment_map.erase(exec_state->fragment_instance_id());
-        if (all_done && query_ctx) {
-            _query_ctx_map.erase(query_ctx->query_id);
-        }
+    _fragment_map.erase(exec_state->fragment_instance_id());
+    if (all_done && query_ctx) {
+        _query_ctx_map.erase(query_ctx->query_id);
     }
 
     // Callback after remove from this id
@@ -597,24 +594,22 @@ Status FragmentMgr::exec_plan_fragment(const TPipelineFragmentParams& params) {
 }
 
 Status FragmentMgr::start_query_execution(const PExecPlanFragmentStartRequest* request) {
-    std::lock_guard<std::mutex> lock(_lock);
     TUniqueId query_id;
     query_id.__set_hi(request->query_id().hi());
     query_id.__set_lo(request->query_id().lo());
-    auto search = _query_ctx_map.find(query_id);
-    if (search == _query_ctx_map.end()) {
+    std::shared_ptr<QueryContext> query_ctx;
+    if (!_query_ctx_map.find(query_id, &query_ctx)) {
         return Status::InternalError(
                 "Failed to get query fragments context. Query may be "
                 "timeout or be cancelled. host: {}",
                 BackendOptions::get_localhost());
     }
-    search->second->set_ready_to_execute(false);
+    query_ctx->set_ready_to_execute(false);
     return Status::OK();
 }
 
 void FragmentMgr::remove_pipeline_context(
         std::shared_ptr<pipeline::PipelineFragmentContext> f_context) {
-    std::lock_guard<std::mutex> lock(_lock);
     auto query_id = f_context->get_query_id();
     auto* q_context = f_context->get_query_context();
     bool all_done = q_context->countdown();
@@ -624,28 +619,62 @@ void FragmentMgr::remove_pipeline_context(
     }
 }
 
+template <typename Params>
+Status FragmentMgr::_get_desc_tbl(const Params& params, QueryContext* query_ctx) {
+    if (!params.__isset.desc_tbl_digest || config::fragment_desc_tbl_cache_capacity <= 0) {
+        return DescriptorTbl::create(&(query_ctx->obj_pool), params.desc_tbl,
+                                     &(query_ctx->desc_tbl));
+    }
+    // the descriptors are immutable after created, so the queries with the same plan share them
+    CachedDescriptorTbl cached;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(_desc_tbl_cache_lock);
+        found = _desc_tbl_cache.get(params.desc_tbl_digest, &cached);
+    }
+    // the digest is a 64 bits hash of the thrift descriptor table computed by FE, comparing the
+    // whole table on every hit costs as much as building it, so only the numbers of descriptors
+    // are checked against a collision
+    const auto& desc_tbl = params.desc_tbl;
+    if (found && (cached.num_slots != desc_tbl.slotDescriptors.size() ||
+                  cached.num_tuples != desc_tbl.tupleDescriptors.size() ||
+                  cached.num_tables != desc_tbl.tableDescriptors.size())) {
+        LOG(INFO) << "descriptor table mismatches the cached one with digest "
+                  << params.desc_tbl_digest << ", rebuild it";
+        found = false;
+    }
+    if (!found) {
+        cached.obj_pool = std::make_shared<ObjectPool>();
+        cached.num_slots = desc_tbl.slotDescriptors.size();
+        cached.num_tuples = desc_tbl.tupleDescriptors.size();
+        cached.num_tables = desc_tbl.tableDescriptors.size();
+        RETURN_IF_ERROR(DescriptorTbl::create(cached.obj_pool.get(), desc_tbl, &cached.desc_tbl));
+        std::lock_guard<std::mutex> lock(_desc_tbl_cache_lock);
+        _desc_tbl_cache.put(params.desc_tbl_digest, cached);
+    }
+    query_ctx->shared_desc_tbl_pool = cached.obj_pool;
+    query_ctx->desc_tbl = cached.desc_tbl;
+    return Status::OK();
+}
+
 template <typename Params>
 Status FragmentMgr::_get_query_ctx(const Params& params, TUniqueId query_id, bool pipeline,
                                    std::shared_ptr<QueryContext>& query_ctx) {
     if (params.is_simplified_param) {
         // Get common components from _query_ctx_map
-        std::lock_guard<std::mutex> lock(_lock);
-        auto search = _query_ctx_map.find(query_id);
-        if (search == _query_ctx_map.end()) {
+        if (!_query_ctx_map.find(query_id, &query_ctx)) {
             return Status::InternalError(
                     "Failed to get query fragments context. Query may be "
                     "timeout or be cancelled. host: {}",
                     BackendOptions::get_localhost());
         }
-        query_ctx = search->second;
     } else {
         // This may be a first fragment request of the query.
         // Create the query fragments context.
         query_ctx = QueryContext::create_shared(params.fragment_num_on_host, _exec_env,
                                                 params.query_options);
         query_ctx->query_id = query_id;
-        RETURN_IF_ERROR(DescriptorTbl::create(&(query_ctx->obj_pool), params.desc_tbl,
-                                              &(query_ctx->desc_tbl)));
+        RETURN_IF_ERROR(_get_desc_tbl(params, query_ctx.get()));
         query_ctx->coord_addr = params.coord;
         LOG(INFO) << "query_id: " << UniqueId(query_ctx->query_id.hi, query_ctx->query_id.lo)
                   << " coord_addr " << query_ctx->coord_addr
@@ -690,20 +719,16 @@ Status FragmentMgr::_get_query_ctx(const Params& params, TUniqueId query_id, boo
             query_ctx->query_mem_tracker->enable_print_log_usage();
         }
 
-        {
-            // Find _query_ctx_map again, in case some other request has already
-            // create the query fragments context.
-            std::lock_guard<std::mutex> lock(_lock);
-            auto search = _query_ctx_map.find(query_id);
-            if (search == _query_ctx_map.end()) {
-                _query_ctx_map.insert(std::make_pair(query_ctx->query_id, query_ctx));
-                LOG(INFO) << "Register query/load memory tracker, query/load id: "
-                          << print_id(query_ctx->query_id)
-                          << " limit: " << PrettyPrinter::print(bytes_limit, TUnit::BYTES);
-            } else {
-                // Already has a query fragments context, use it
-                query_ctx = search->second;
-            }
+        // Find _query_ctx_map again, in case some other request has already
+        // create the query fragments context.
+        auto registered_ctx = _query_ctx_map.find_or_insert(query_id, query_ctx);
+        if (registered_ctx == query_ctx) {
+            LOG(INFO) << "Register query/load memory tracker, query/load id: "
+                      << print_id(query_ctx->query_id)
+                      << " limit: " << PrettyPrinter::print(bytes_limit, TUnit::BYTES);
+        } else {
+            // Already has a query fragments context, use it
+            query_ctx = registered_ctx;
         }
     }
     return Status::OK();
@@ -721,13 +746,9 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params,
              << apache::thrift::ThriftDebugString(params.query_options).c_str();
     START_AND_SCOPE_SPAN(tracer, span, "FragmentMgr::exec_plan_fragment");
     const TUniqueId& fragment_instance_id = params.params.fragment_instance_id;
-    {
-        std::lock_guard<std::mutex> lock(_lock);
-        auto iter = _fragment_map.find(fragment_instance_id);
-        if (iter != _fragment_map.end()) {
-            // Duplicated
-            return Status::OK();
-        }
+    if (_fragment_map.contains(fragment_instance_id)) {
+        // Duplicated
+        return Status::OK();
     }
 
     std::shared_ptr<FragmentExecState> exec_state;
@@ -756,25 +777,19 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params,
         RETURN_IF_ERROR(exec_state->prepare(params));
     }
     g_fragmentmgr_prepare_latency << (duration_ns / 1000);
+    DorisMetrics::instance()->fragment_prepare_duration_us->add(duration_ns / 1000);
     std::shared_ptr<RuntimeFilterMergeControllerEntity> handler;
     _runtimefilter_controller.add_entity(params, &handler, exec_state->executor()->runtime_state());
     exec_state->set_merge_controller_handler(handler);
-    {
-        std::lock_guard<std::mutex> lock(_lock);
-        _fragment_map.insert(std::make_pair(params.params.fragment_instance_id, exec_state));
-        _cv.notify_all();
-    }
+    _fragment_map.insert(params.params.fragment_instance_id, exec_state);
     auto st = _thread_pool->submit_func(
             [this, exec_state, cb, parent_span = opentelemetry::trace::Tracer::GetCurrentSpan()] {
                 OpentelemetryScope scope {parent_span};
                 _exec_actual(exec_state, cb);
             });
     if (!st.ok()) {
-        {
-            // Remove the exec state added
-            std::lock_guard<std::mutex> lock(_lock);
-            _fragment_map.erase(params.params.fragment_instance_id);
-        }
+        // Remove the exec state added
+        _fragment_map.erase(params.params.fragment_instance_id);
         exec_state->cancel(PPlanFragmentCancelReason::INTERNAL_ERROR,
                            "push plan fragment to thread pool failed");
         return Status::InternalError(
@@ -823,13 +838,9 @@ Status FragmentMgr::exec_plan_fragment(const TPipelineFragmentParams& params,
         const auto& local_params = params.local_params[i];
 
         const TUniqueId& fragment_instance_id = local_params.fragment_instance_id;
-        {
-            std::lock_guard<std::mutex> lock(_lock);
-            auto iter = _pipeline_map.find(fragment_instance_id);
-            if (iter != _pipeline_map.end()) {
-                // Duplicated
-                continue;
-            }
+        if (_pipeline_map.contains(fragment_instance_id)) {
+            // Duplicated
+            continue;
         }
 
         query_ctx->fragment_ids.push_back(fragment_instance_id);
@@ -866,17 +877,14 @@ Status FragmentMgr::exec_plan_fragment(const TPipelineFragmentParams& params,
             }
         }
         g_fragmentmgr_prepare_latency << (duration_ns / 1000);
+        DorisMetrics::instance()->fragment_prepare_duration_us->add(duration_ns / 1000);
 
         std::shared_ptr<RuntimeFilterMergeControllerEntity> handler;
         _runtimefilter_controller.add_entity(params, local_params, &handler,
                                              context->get_runtime_state());
         context->set_merge_controller_handler(handler);
 
-        {
-            std::lock_guard<std::mutex> lock(_lock);
-            _pipeline_map.insert(std::make_pair(fragment_instance_id, context));
-            _cv.notify_all();
-        }
+        _pipeline_map.insert(fragment_instance_id, context);
         RETURN_IF_ERROR(context->submit());
     }
 
@@ -898,26 +906,12 @@ void FragmentMgr::_set_scan_concurrency(const Param& params, QueryContext* query
 void FragmentMgr::cancel(const TUniqueId& fragment_id, const PPlanFragmentCancelReason& reason,
                          const std::string& msg) {
     std::shared_ptr<FragmentExecState> exec_state;
-    {
-        std::lock_guard<std::mutex> lock(_lock);
-        auto iter = _fragment_map.find(fragment_id);
-        if (iter != _fragment_map.end()) {
-            exec_state = iter->second;
-        }
-    }
-    if (exec_state) {
+    if (_fragment_map.find(fragment_id, &exec_state) && exec_state) {
         exec_state->cancel(reason, msg);
     }
 
     std::shared_ptr<pipeline::PipelineFragmentContext> pipeline_fragment_ctx;
-    {
-        std::lock_guard<std::mutex> lock(_lock);
-        auto iter = _pipeline_map.find(fragment_id);
-        if (iter != _pipeline_map.end()) {
-            pipeline_fragment_ctx = iter->second;
-        }
-    }
-    if (pipeline_fragment_ctx) {
+    if (_pipeline_map.find(fragment_id, &pipeline_fragment_ctx) && pipeline_fragment_ctx) {
         pipeline_fragment_ctx->cancel(reason, msg);
     }
 }
@@ -925,12 +919,9 @@ void FragmentMgr::cancel(const TUniqueId& fragment_id, const PPlanFragmentCancel
 void FragmentMgr::cancel_query(const TUniqueId& query_id, const PPlanFragmentCancelReason& reason,
                                const std::string& msg) {
     std::vector<TUniqueId> cancel_fragment_ids;
-    {
-        std::lock_guard<std::mutex> lock(_lock);
-        auto ctx = _query_ctx_map.find(query_id);
-        if (ctx != _query_ctx_map.end()) {
-            cancel_fragment_ids = ctx->second->fragment_ids;
-        }
+    std::shared_ptr<QueryContext> query_ctx;
+    if (_query_ctx_map.find(query_id, &query_ctx)) {
+        cancel_fragment_ids = query_ctx->fragment_ids;
     }
     for (auto it : cancel_fragment_ids) {
         cancel(it, reason, msg);
@@ -938,18 +929,17 @@ void FragmentMgr::cancel_query(const TUniqueId& query_id, const PPlanFragmentCan
 }
 
 bool FragmentMgr::query_is_canceled(const TUniqueId& query_id) {
-    std::lock_guard<std::mutex> lock(_lock);
-    auto ctx = _query_ctx_map.find(query_id);
-    if (ctx != _query_ctx_map.end()) {
-        for (auto it : ctx->second->fragment_ids) {
-            auto exec_state_iter = _fragment_map.find(it);
-            if (exec_state_iter != _fragment_map.end() && exec_state_iter->second) {
-                return exec_state_iter->second->is_canceled();
+    std::shared_ptr<QueryContext> query_ctx;
+    if (_query_ctx_map.find(query_id, &query_ctx)) {
+        for (auto it : query_ctx->fragment_ids) {
+            std::shared_ptr<FragmentExecState> exec_state;
+            if (_fragment_map.find(it, &exec_state) && exec_state) {
+                return exec_state->is_canceled();
             }
 
-            auto pipeline_ctx_iter = _pipeline_map.find(it);
-            if (pipeline_ctx_iter != _pipeline_map.end() && pipeline_ctx_iter->second) {
-                return pipeline_ctx_iter->second->is_canceled();
+            std::shared_ptr<pipeline::PipelineFragmentContext> pipeline_ctx;
+            if (_pipeline_map.find(it, &pipeline_ctx) && pipeline_ctx) {
+                return pipeline_ctx->is_canceled();
             }
         }
     }
@@ -962,21 +952,16 @@ void FragmentMgr::cancel_worker() {
         std::vector<TUniqueId> to_cancel;
         std::vector<TUniqueId> to_cancel_queries;
         vectorized::VecDateTimeValue now = vectorized::VecDateTimeValue::local_time();
-        {
-            std::lock_guard<std::mutex> lock(_lock);
-            for (auto& it : _fragment_map) {
-                if (it.second->is_timeout(now)) {
-                    to_cancel.push_back(it.second->fragment_instance_id());
-                }
+        _fragment_map.for_each([&](const TUniqueId& fragment_instance_id,
+                                   const std::shared_ptr<FragmentExecState>& exec_state) {
+            if (exec_state->is_timeout(now)) {
+                to_cancel.push_back(fragment_instance_id);
             }
-            for (auto it = _query_ctx_map.begin(); it != _query_ctx_map.end();) {
-                if (it->second->is_timeout(now)) {
-                    it = _query_ctx_map.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-        }
+        });
+        _query_ctx_map.erase_if([&](const TUniqueId& query_id,
+                                    const std::shared_ptr<QueryContext>& query_ctx) {
+            return query_ctx->is_timeout(now);
+        });
         timeout_canceled_fragment_count->increment(to_cancel.size());
         for (auto& id : to_cancel) {
             cancel(id, PPlanFragmentCancelReason::TIMEOUT);
@@ -989,15 +974,14 @@ void FragmentMgr::cancel_worker() {
 
 void FragmentMgr::debug(std::stringstream& ss) {
     // Keep things simple
-    std::lock_guard<std::mutex> lock(_lock);
-
     ss << "FragmentMgr have " << _fragment_map.size() << " jobs.\n";
     ss << "job_id\t\tstart_time\t\texecute_time(s)\n";
     vectorized::VecDateTimeValue now = vectorized::VecDateTimeValue::local_time();
-    for (auto& it : _fragment_map) {
-        ss << it.first << "\t" << it.second->start_time().debug_string() << "\t"
-           << now.second_diff(it.second->start_time()) << "\n";
-    }
+    _fragment_map.for_each([&](const TUniqueId& fragment_instance_id,
+                               const std::shared_ptr<FragmentExecState>& exec_state) {
+        ss << fragment_instance_id << "\t" << exec_state->start_time().debug_string() << "\t"
+           << now.second_diff(exec_state->start_time()) << "\n";
+    });
 }
 
 /*
@@ -1130,24 +1114,18 @@ Status FragmentMgr::apply_filter(const PPublishFilterRequest* request,
 
     RuntimeFilterMgr* runtime_filter_mgr = nullptr;
     if (is_pipeline) {
-        std::unique_lock<std::mutex> lock(_lock);
-        auto iter = _pipeline_map.find(tfragment_instance_id);
-        if (iter == _pipeline_map.end()) {
+        if (!_pipeline_map.find(tfragment_instance_id, &pip_context)) {
             VLOG_CRITICAL << "unknown.... fragment-id:" << fragment_instance_id;
             return Status::InvalidArgument("fragment-id: {}", fragment_instance_id.to_string());
         }
-        pip_context = iter->second;
 
         DCHECK(pip_context != nullptr);
         runtime_filter_mgr = pip_context->get_runtime_state()->runtime_filter_mgr();
     } else {
-        std::unique_lock<std::mutex> lock(_lock);
-        auto iter = _fragment_map.find(tfragment_instance_id);
-        if (iter == _fragment_map.end()) {
+        if (!_fragment_map.find(tfragment_instance_id, &fragment_state)) {
             VLOG_CRITICAL << "unknown.... fragment-id:" << fragment_instance_id;
             return Status::InvalidArgument("fragment-id: {}", fragment_instance_id.to_string());
         }
-        fragment_state = iter->second;
 
         DCHECK(fragment_state != nullptr);
         runtime_filter_mgr = fragment_state->executor()->runtime_state()->runtime_filter_mgr();
@@ -1172,26 +1150,20 @@ Status FragmentMgr::apply_filterv2(const PPublishFilterRequestV2* request,
         RuntimeFilterMgr* runtime_filter_mgr = nullptr;
         ObjectPool* pool;
         if (is_pipeline) {
-            std::unique_lock<std::mutex> lock(_lock);
-            auto iter = _pipeline_map.find(tfragment_instance_id);
-            if (iter == _pipeline_map.end()) {
+            if (!_pipeline_map.find(tfragment_instance_id, &pip_context)) {
                 VLOG_CRITICAL << "unknown.... fragment-id:" << fragment_instance_id;
                 return Status::InvalidArgument("fragment-id: {}", fragment_instance_id.to_string());
             }
-            pip_context = iter->second;
 
             DCHECK(pip_context != nullptr);
             runtime_filter_mgr =
                     pip_context->get_runtime_state()->get_query_ctx()->runtime_filter_mgr();
             pool = &pip_context->get_query_context()->obj_pool;
         } else {
-            std::unique_lock<std::mutex> lock(_lock);
-            auto iter = _fragment_map.find(tfragment_instance_id);
-            if (iter == _fragment_map.end()) {
+            if (!_fragment_map.find(tfragment_instance_id, &fragment_state)) {
                 VLOG_CRITICAL << "unknown.... fragment-id:" << fragment_instance_id;
                 return Status::InvalidArgument("fragment-id: {}", fragment_instance_id.to_string());
             }
-            fragment_state = iter->second;
 
             DCHECK(fragment_state != nullptr);
             runtime_filter_mgr = fragment_state->executor()
@@ -1223,28 +1195,18 @@ Status FragmentMgr::merge_filter(const PMergeFilterRequest* request,
     TUniqueId tfragment_instance_id = fragment_instance_id.to_thrift();
     std::shared_ptr<FragmentExecState> fragment_state;
     std::shared_ptr<pipeline::PipelineFragmentContext> pip_context;
+    // hold reference to pip_context or fragment_state, or else runtime_state can be destroyed
+    // when filter_controller->merge is still in progress
     if (is_pipeline) {
-        std::lock_guard<std::mutex> lock(_lock);
-        auto iter = _pipeline_map.find(tfragment_instance_id);
-        if (iter == _pipeline_map.end()) {
+        if (!_pipeline_map.find(tfragment_instance_id, &pip_context)) {
             VLOG_CRITICAL << "unknown fragment-id:" << fragment_instance_id;
             return Status::InvalidArgument("fragment-id: {}", fragment_instance_id.to_string());
         }
-
-        // hold reference to pip_context, or else runtime_state can be destroyed
-        // when filter_controller->merge is still in progress
-        pip_context = iter->second;
     } else {
-        std::unique_lock<std::mutex> lock(_lock);
-        auto iter = _fragment_map.find(tfragment_instance_id);
-        if (iter == _fragment_map.end()) {
+        if (!_fragment_map.find(tfragment_instance_id, &fragment_state)) {
             VLOG_CRITICAL << "unknown fragment-id:" << fragment_instance_id;
             return Status::InvalidArgument("fragment-id: {}", fragment_instance_id.to_string());
         }
-
-        // hold reference to fragment_state, or else runtime_state can be destroyed
-        // when filter_controller->merge is still in progress
-        fragment_state = iter->second;
     }
     RETURN_IF_ERROR(filter_controller->merge(request, attach_data, opt_remote_rf));
     return Status::OK();
@@ -21,7 +21,6 @@
 #include <gen_cpp/types.pb.h>
 #include <stdint.h>
 
-#include <condition_variable>
 #include <functional>
 #include <iosfwd>
 #include <memory>
@@ -36,7 +35,9 @@
 #include "runtime_filter_mgr.h"
 #include "util/countdown_latch.h"
 #include "util/hash_util.hpp" // IWYU pragma: keep
+#include "util/lru_cache.hpp"
 #include "util/metrics.h"
+#include "util/sharded_map.h"
 
 namespace butil {
 class IOBufAsZeroCopyInputStream;
@@ -48,7 +49,9 @@ namespace pipeline {
 class PipelineFragmentContext;
 }
 class QueryContext;
+class DescriptorTbl;
 class ExecEnv;
+class ObjectPool;
 class FragmentExecState;
 class ThreadPool;
 class TExecPlanFragmentParams;
@@ -156,22 +159,40 @@ private:
     Status _get_query_ctx(const Params& params, TUniqueId query_id, bool pipeline,
                           std::shared_ptr<QueryContext>& query_ctx);
 
+    // Create the descriptor table of the query, or reuse the cached one with the same digest.
+    template <typename Params>
+    Status _get_desc_tbl(const Params& params, QueryContext* query_ctx);
+
     // This is input params
     ExecEnv* _exec_env;
 
-    std::mutex _lock;
-
-    std::condition_variable _cv;
-
+    // The registries are sharded maps, so that starting, finishing and cancelling fragments
+    // of different queries seldom contend for a lock.
     // Make sure that remove this before no data reference FragmentExecState
-    std::unordered_map<TUniqueId, std::shared_ptr<FragmentExecState>> _fragment_map;
+    ShardedMap<TUniqueId, std::shared_ptr<FragmentExecState>> _fragment_map;
 
-    std::unordered_map<TUniqueId, std::shared_ptr<pipeline::PipelineFragmentContext>> _pipeline_map;
+    ShardedMap<TUniqueId, std::shared_ptr<pipeline::PipelineFragmentContext>> _pipeline_map;
 
     // query id -> QueryContext
-    std::unordered_map<TUniqueId, std::shared_ptr<QueryContext>> _query_ctx_map;
+    ShardedMap<TUniqueId, std::shared_ptr<QueryContext>> _query_ctx_map;
     std::unordered_map<TUniqueId, std::unordered_map<int, int64_t>> _bf_size_map;
 
+    struct CachedDescriptorTbl {
+        // owns the descriptors of the table
+        std::shared_ptr<ObjectPool> obj_pool;
+        DescriptorTbl* desc_tbl = nullptr;
+        // the numbers of descriptors of the thrift table desc_tbl is built from, a cheap check
+        // of a hit of the digest
+        size_t num_slots = 0;
+        size_t num_tuples = 0;
+        size_t num_tables = 0;
+    };
+    std::mutex _desc_tbl_cache_lock;
+    // desc_tbl_digest -> descriptor table. Only descriptor tables are cached, the prepared exec
+    // nodes and expression contexts of a fragment keep per-instance state, so they are not
+    // shared between queries.
+    LruCache<int64_t, CachedDescriptorTbl> _desc_tbl_cache;
+
     CountDownLatch _stop_background_threads_latch;
     scoped_refptr<Thread> _cancel_thread;
     // every job is a pool
@@ -21,8 +21,11 @@
 #include <sanitizer/asan_interface.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <mutex>
 
+#include "common/compiler_util.h"
 #include "common/config.h"
 #include "common/status.h"
 #include "runtime/memory/chunk.h"
@@ -44,6 +47,7 @@ static constexpr size_t MAX_CHUNK_SIZE = 64 * (1ULL << 20); // 64M
 
 ChunkAllocator* ChunkAllocator::_s_instance = nullptr;
 
+DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_thread_cache_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_local_core_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_other_core_alloc_count, MetricUnit::NOUNIT);
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_alloc_count, MetricUnit::NOUNIT);
@@ -52,6 +56,7 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_alloc_cost_ns, MetricUnit
 DEFINE_COUNTER_METRIC_PROTOTYPE_2ARG(chunk_pool_system_free_cost_ns, MetricUnit::NANOSECONDS);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(chunk_pool_reserved_bytes, MetricUnit::NOUNIT);
 
+static IntCounter* chunk_pool_thread_cache_alloc_count;
 static IntCounter* chunk_pool_local_core_alloc_count;
 static IntCounter* chunk_pool_other_core_alloc_count;
 static IntCounter* chunk_pool_system_alloc_count;
@@ -123,7 +128,16 @@ public:
         _chunk_lists[idx].push_back(ptr);
     }
 
-    void clear() {
+    // Push `num` chunks of the same size with one lock, the chunks should have been poisoned.
+    void push_free_chunks(uint8_t* const* ptrs, int num, size_t size) {
+        int idx = BitUtil::Log2Ceiling64(size);
+        std::lock_guard<SpinLock> l(_lock);
+        _chunk_lists[idx].insert(_chunk_lists[idx].end(), ptrs, ptrs + num);
+    }
+
+    // Return the bytes of the freed chunks
+    int64_t clear() {
+        int64_t freed_bytes = 0;
         std::lock_guard<SpinLock> l(_lock);
         for (int i = 0; i < 64; ++i) {
             if (_chunk_lists[i].empty()) {
@@ -132,8 +146,10 @@ public:
             for (auto ptr : _chunk_lists[i]) {
                 ::free(ptr);
             }
+            freed_bytes += _chunk_lists[i].size() << i;
             std::vector<uint8_t*>().swap(_chunk_lists[i]);
         }
+        return freed_bytes;
     }
 
 private:
@@ -141,6 +157,166 @@ private:
     std::vector<std::vector<uint8_t*>> _chunk_lists;
 };
 
+// Free chunks cached by one thread in front of the arenas, see the comment of ChunkAllocator.
+// The cached chunks are owned by ChunkAllocator's MemTracker like the chunks in the arenas,
+// and are counted in ChunkAllocator::_thread_cached_bytes.
+// Only accessed by its owner thread and ChunkAllocator::clear(), so the lock is hardly contended.
+class ChunkThreadCache {
+    // The max number of cached chunks of each size
+    static constexpr int MAGAZINE_SIZE = 16;
+
+public:
+    ChunkThreadCache(ChunkAllocator* allocator) : _allocator(allocator) {
+        std::lock_guard<std::mutex> l(_allocator->_thread_caches_lock);
+        _allocator->_thread_caches.insert(this);
+    }
+
+    // Called when the thread exits, the thread context may have been destroyed, so the chunks
+    // are returned to the arenas without touching the thread's MemTracker.
+    ~ChunkThreadCache() {
+        {
+            std::lock_guard<std::mutex> l(_allocator->_thread_caches_lock);
+            _allocator->_thread_caches.erase(this);
+        }
+        for (int i = 0; i < 64; ++i) {
+            _release_oldest(i, _magazines[i].count, ReleaseTo::ARENA);
+        }
+        _flush();
+    }
+
+    bool pop_free_chunk(size_t size, uint8_t** ptr) {
+        std::lock_guard<SpinLock> l(_lock);
+        auto& magazine = _magazines[BitUtil::Log2Ceiling64(size)];
+        if (magazine.count == 0) {
+            return false;
+        }
+        *ptr = magazine.chunks[--magazine.count];
+        ASAN_UNPOISON_MEMORY_REGION(*ptr, size);
+        // transfer the memory ownership from ChunkAllocator::tracker to the tls tracker.
+        _add_delta(-static_cast<int64_t>(size), -static_cast<int64_t>(size));
+        THREAD_LIMITER_MEM_TRACKER_CONSUME(static_cast<int64_t>(size));
+        return true;
+    }
+
+    // Return false if the chunk can not be cached because the cache of this thread is full,
+    // or the chunks reserved by the arenas and all thread caches reach the reserve limit.
+    bool push_free_chunk(uint8_t* ptr, size_t size) {
+        std::lock_guard<SpinLock> l(_lock);
+        if (_cached_bytes + static_cast<int64_t>(size) >
+                    config::chunk_allocator_thread_cache_bytes ||
+            _allocator->_reserved_bytes.load(std::memory_order_relaxed) +
+                            _allocator->_thread_cached_bytes.load(std::memory_order_relaxed) +
+                            static_cast<int64_t>(size) >
+                    _allocator->_reserve_bytes_limit) {
+            return false;
+        }
+        int idx = BitUtil::Log2Ceiling64(size);
+        auto& magazine = _magazines[idx];
+        if (magazine.count == MAGAZINE_SIZE) {
+            _release_oldest(idx, MAGAZINE_SIZE / 2, ReleaseTo::ARENA_OR_SYSTEM);
+        }
+        ASAN_POISON_MEMORY_REGION(ptr, size);
+        magazine.chunks[magazine.count++] = ptr;
+        // transfer the memory ownership from the tls tracker to ChunkAllocator::tracker.
+        THREAD_LIMITER_MEM_TRACKER_CONSUME(-static_cast<int64_t>(size));
+        _add_delta(size, size);
+        return true;
+    }
+
+    // Free all cached chunks to the system, called by ChunkAllocator::clear() from any thread.
+    void clear() {
+        std::lock_guard<SpinLock> l(_lock);
+        for (int i = 0; i < 64; ++i) {
+            _release_oldest(i, _magazines[i].count, ReleaseTo::SYSTEM);
+        }
+        _flush();
+    }
+
+private:
+    enum class ReleaseTo {
+        ARENA,
+        // to the system if the arenas and thread caches reach the reserve limit
+        ARENA_OR_SYSTEM,
+        SYSTEM,
+    };
+
+    struct Magazine {
+        int count = 0;
+        uint8_t* chunks[MAGAZINE_SIZE];
+    };
+
+    // Release the oldest `num` chunks of magazine `idx` in one batch, the newer chunks are kept
+    // because they are more likely to be in the cpu cache.
+    void _release_oldest(int idx, int num, ReleaseTo to) {
+        if (num == 0) {
+            return;
+        }
+        auto& magazine = _magazines[idx];
+        size_t size = (size_t)1 << idx;
+        int64_t bytes = size * num;
+        bool to_arena = to == ReleaseTo::ARENA ||
+                        (to == ReleaseTo::ARENA_OR_SYSTEM &&
+                         _allocator->_reserved_bytes + _allocator->_thread_cached_bytes <=
+                                 _allocator->_reserve_bytes_limit);
+
+        if (to_arena) {
+            // the chunks stay in ChunkAllocator::tracker and in the reserve limit
+            _allocator->_reserved_bytes.fetch_add(bytes);
+            _add_delta(-bytes, 0);
+            _allocator->_arenas[CpuInfo::get_current_core()]->push_free_chunks(magazine.chunks,
+                                                                              num, size);
+            chunk_pool_reserved_bytes->set_value(_allocator->_reserved_bytes);
+        } else {
+            // transfer the memory ownership from ChunkAllocator::tracker to the tls tracker,
+            // which is released by the mem hook when the memory is freed.
+            _add_delta(-bytes, -bytes);
+            THREAD_LIMITER_MEM_TRACKER_CONSUME(bytes);
+            int64_t cost_ns = 0;
+            {
+                SCOPED_RAW_TIMER(&cost_ns);
+                for (int i = 0; i < num; ++i) {
+                    ASAN_UNPOISON_MEMORY_REGION(magazine.chunks[i], size);
+                    SystemAllocator::free(magazine.chunks[i], size);
+                }
+            }
+            chunk_pool_system_free_count->increment(num);
+            chunk_pool_system_free_cost_ns->increment(cost_ns);
+        }
+        std::copy(magazine.chunks + num, magazine.chunks + magazine.count, magazine.chunks);
+        magazine.count -= num;
+    }
+
+    // ChunkAllocator::_thread_cached_bytes and the consumption of ChunkAllocator::tracker are
+    // shared by all threads, so update them in batches.
+    void _add_delta(int64_t cached_bytes, int64_t tracker_bytes) {
+        _cached_bytes += cached_bytes;
+        _cached_bytes_delta += cached_bytes;
+        _tracker_delta += tracker_bytes;
+        if (std::abs(_cached_bytes_delta) >= config::mem_tracker_consume_min_size_bytes ||
+            std::abs(_tracker_delta) >= config::mem_tracker_consume_min_size_bytes) {
+            _flush();
+        }
+    }
+
+    void _flush() {
+        _allocator->_thread_cached_bytes.fetch_add(_cached_bytes_delta);
+        _cached_bytes_delta = 0;
+#ifdef USE_MEM_TRACKER
+        _allocator->_mem_tracker->consume(_tracker_delta);
+#endif
+        _tracker_delta = 0;
+    }
+
+    ChunkAllocator* _allocator;
+    SpinLock _lock;
+    int64_t _cached_bytes = 0;
+    int64_t _cached_bytes_delta = 0;
+    int64_t _tracker_delta = 0;
+    Magazine _magazines[64];
+};
+
+DEFINE_STATIC_THREAD_LOCAL(ChunkThreadCache, ChunkAllocator, _s_thread_cache);
+
 void ChunkAllocator::init_instance(size_t reserve_limit) {
     if (_s_instance != nullptr) return;
     _s_instance = new ChunkAllocator(reserve_limit);
@@ -159,6 +335,8 @@ ChunkAllocator::ChunkAllocator(size_t reserve_limit)
 
     _chunk_allocator_metric_entity =
             DorisMetrics::instance()->metric_registry()->register_entity("chunk_allocator");
+    INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity,
+                                chunk_pool_thread_cache_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_local_core_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_other_core_alloc_count);
     INT_COUNTER_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_system_alloc_count);
@@ -168,6 +346,14 @@ ChunkAllocator::ChunkAllocator(size_t reserve_limit)
     INT_GAUGE_METRIC_REGISTER(_chunk_allocator_metric_entity, chunk_pool_reserved_bytes);
 }
 
+ChunkThreadCache* ChunkAllocator::_thread_cache() {
+    if (config::chunk_allocator_thread_cache_bytes <= 0) {
+        return nullptr;
+    }
+    INIT_STATIC_THREAD_LOCAL(ChunkThreadCache, _s_thread_cache, this);
+    return _s_thread_cache;
+}
+
 Status ChunkAllocator::allocate_align(size_t size, Chunk* chunk) {
     CHECK(size > 0);
     size = BitUtil::RoundUpToPowerOfTwo(size);
@@ -182,6 +368,13 @@ Status ChunkAllocator::allocate_align(size_t size, Chunk* chunk) {
         return Status::OK();
     }
 
+    // fastest path: allocate from the chunks cached by current thread
+    auto thread_cache = _thread_cache();
+    if (thread_cache != nullptr && thread_cache->pop_free_chunk(size, &chunk->data)) {
+        chunk_pool_thread_cache_alloc_count->increment(1);
+        return Status::OK();
+    }
+
     if (_arenas[core_id]->pop_free_chunk(size, &chunk->data)) {
         DCHECK_GE(_reserved_bytes, 0);
         _reserved_bytes.fetch_sub(size);
@@ -232,12 +425,19 @@ void ChunkAllocator::free(const Chunk& chunk) {
         return;
     }
 
+    if (chunk.size > MIN_CHUNK_SIZE && chunk.size < MAX_CHUNK_SIZE) {
+        auto thread_cache = _thread_cache();
+        if (thread_cache != nullptr && thread_cache->push_free_chunk(chunk.data, chunk.size)) {
+            return;
+        }
+    }
+
     int64_t old_reserved_bytes = _reserved_bytes;
     int64_t new_reserved_bytes = 0;
     do {
         new_reserved_bytes = old_reserved_bytes + chunk.size;
         if (chunk.size <= MIN_CHUNK_SIZE || chunk.size >= MAX_CHUNK_SIZE ||
-            new_reserved_bytes > _reserve_bytes_limit) {
+            new_reserved_bytes + _thread_cached_bytes > _reserve_bytes_limit) {
             int64_t cost_ns = 0;
             {
                 SCOPED_RAW_TIMER(&cost_ns);
@@ -273,10 +473,18 @@ void ChunkAllocator::free(uint8_t* data, size_t size) {
 }
 
 void ChunkAllocator::clear() {
+    int64_t freed_bytes = 0;
     for (int i = 0; i < _arenas.size(); ++i) {
-        _arenas[i]->clear();
+        freed_bytes += _arenas[i]->clear();
+    }
+    _reserved_bytes.fetch_sub(freed_bytes);
+    THREAD_MEM_TRACKER_TRANSFER_FROM(freed_bytes, _mem_tracker.get());
+    // The chunks cached by idle threads are freed too, and the consumption of these chunks is
+    // transferred by the thread caches.
+    std::lock_guard<std::mutex> l(_thread_caches_lock);
+    for (auto thread_cache : _thread_caches) {
+        thread_cache->clear();
     }
-    THREAD_MEM_TRACKER_TRANSFER_FROM(_mem_tracker->consumption(), _mem_tracker.get());
 }
 
 } // namespace doris
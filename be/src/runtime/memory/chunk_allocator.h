@@ -21,14 +21,18 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include "runtime/memory/mem_tracker_limiter.h"
+#include "runtime/threadlocal.h"
 
 namespace doris {
 
 struct Chunk;
 class ChunkArena;
+class ChunkThreadCache;
 class MetricEntity;
 class Status;
 
@@ -49,6 +53,16 @@ class Status;
 // ChunkArena will keep a separate free list for each chunk size. In common case, chunk will
 // be allocated from current core arena. In this case, there is no lock contention.
 //
+// Thread Cache
+// In front of the arenas, each thread caches a few free chunks of each size, which are
+// allocated and freed under a lock of its own without any shared counter update. When the chunks
+// of a size overflow, half of them are returned to the arena in one batch. The bytes cached by
+// each thread are limited by config::chunk_allocator_thread_cache_bytes, which is 0 by default
+// to disable the thread cache. The cached bytes of all threads are counted in mem_consumption()
+// and in the reserve limit together with the arenas. They and the consumption of ChunkAllocator's
+// MemTracker are updated by each thread in batches of config::mem_tracker_consume_min_size_bytes.
+// clear() frees the chunks cached by all threads, including idle ones.
+//
 // Must call CpuInfo::init() and DorisMetrics::instance()->initialize() to achieve good performance
 // before first object is created. And call init_instance() before use instance is called.
 class ChunkAllocator {
@@ -75,19 +89,30 @@ public:
 
     void clear();
 
-    int64_t mem_consumption() { return _reserved_bytes; }
+    int64_t mem_consumption() { return _reserved_bytes + _thread_cached_bytes; }
 
 private:
+    friend class ChunkThreadCache;
+
     ChunkAllocator(size_t reserve_limit);
 
+    // nullptr if the thread cache is disabled
+    ChunkThreadCache* _thread_cache();
+
 private:
     static ChunkAllocator* _s_instance;
+    DECLARE_STATIC_THREAD_LOCAL(ChunkThreadCache, _s_thread_cache);
 
     size_t _reserve_bytes_limit;
     // When the reserved chunk memory size is greater than the limit,
     // it is allowed to steal the chunks of other arenas.
     size_t _steal_arena_limit;
     std::atomic<int64_t> _reserved_bytes;
+    // the bytes of the chunks cached by all threads
+    std::atomic<int64_t> _thread_cached_bytes = 0;
+    // the thread caches of live threads, to be cleared by clear()
+    std::mutex _thread_caches_lock;
+    std::unordered_set<ChunkThreadCache*> _thread_caches;
     // each core has a ChunkArena
     std::vector<std::unique_ptr<ChunkArena>> _arenas;
 
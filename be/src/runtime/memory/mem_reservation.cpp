@@ -0,0 +1,133 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/mem_reservation.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "common/config.h"
+
+namespace doris {
+
+std::shared_ptr<MemReservation> MemReservation::_s_process = nullptr;
+
+MemReservation::MemReservation(std::string label, int64_t limit,
+                               std::shared_ptr<MemReservation> parent, int64_t share)
+        : _label(std::move(label)), _limit(limit), _parent(std::move(parent)), _share(share) {
+    if (_parent != nullptr) {
+        _parent->_children_share += share;
+    }
+}
+
+MemReservation::~MemReservation() {
+    DCHECK_EQ(reserved(), 0) << _label;
+    if (_parent != nullptr) {
+        _parent->_children_share -= _share.load();
+    }
+}
+
+void MemReservation::create_process_reservation(int64_t limit) {
+    DCHECK(_s_process == nullptr);
+    _s_process = std::make_shared<MemReservation>("Process", limit, nullptr);
+}
+
+bool MemReservation::try_reserve(int64_t bytes) {
+    DCHECK_GE(bytes, 0);
+    for (auto node = this; node != nullptr; node = node->_parent.get()) {
+        if (!node->_try_consume(bytes)) {
+            // roll back the descendants of the node
+            for (auto n = this; n != node; n = n->_parent.get()) {
+                n->_reserved -= bytes;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+void MemReservation::release(int64_t bytes) {
+    DCHECK_GE(bytes, 0);
+    for (auto node = this; node != nullptr; node = node->_parent.get()) {
+        node->_reserved -= bytes;
+        DCHECK_GE(node->reserved(), 0) << node->_label;
+    }
+}
+
+void MemReservation::set_share(int64_t share) {
+    int64_t old_share = _share.exchange(share);
+    if (_parent != nullptr) {
+        _parent->_children_share += share - old_share;
+    }
+}
+
+bool MemReservation::_try_consume(int64_t bytes) {
+    int64_t reserved = _reserved.fetch_add(bytes) + bytes;
+    if ((_limit >= 0 && reserved > _limit) || !_within_fair_share(reserved)) {
+        _reserved -= bytes;
+        return false;
+    }
+    return true;
+}
+
+bool MemReservation::_within_fair_share(int64_t reserved) const {
+    int64_t share = _share.load();
+    if (share <= 0 || _parent == nullptr || _parent->_limit < 0) {
+        return true;
+    }
+    // the siblings may use the spare memory of each other until the parent is nearly full
+    if (_parent->reserved() <
+        _parent->_limit / 100 * config::mem_reservation_fair_share_watermark_percent) {
+        return true;
+    }
+    int64_t children_share = std::max(_parent->_children_share.load(), share);
+    return reserved <= static_cast<int64_t>(static_cast<double>(_parent->_limit) * share /
+                                            children_share);
+}
+
+void OperatorMemReservation::init(std::shared_ptr<MemReservation> reservation,
+                                  RuntimeProfile* profile) {
+    _reservation = std::move(reservation);
+    if (_reservation == nullptr || profile == nullptr) {
+        return;
+    }
+    _reserved_counter = profile->AddHighWaterMarkCounter("MemReserved", TUnit::BYTES);
+    _denied_counter = ADD_COUNTER(profile, "MemReservationDenied", TUnit::UNIT);
+}
+
+bool OperatorMemReservation::reserve_to(int64_t bytes) {
+    if (_reservation == nullptr || bytes == _reserved) {
+        return true;
+    }
+    if (bytes < _reserved) {
+        _reservation->release(_reserved - bytes);
+    } else if (!_reservation->try_reserve(bytes - _reserved)) {
+        if (_denied_counter != nullptr) {
+            COUNTER_UPDATE(_denied_counter, 1);
+        }
+        return false;
+    }
+    _reserved = bytes;
+    if (_reserved_counter != nullptr) {
+        _reserved_counter->set(_reserved);
+    }
+    return true;
+}
+
+} // namespace doris
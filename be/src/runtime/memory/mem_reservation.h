@@ -0,0 +1,114 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+// A node of the hierarchy of memory reservations: process -> workload group -> query.
+// Operators reserve memory from the node of their query before they build large in-memory
+// structures. A reservation is granted only if it fits into the limit of the node and of all
+// its ancestors, so unlike MemTrackerLimiter, which cancels queries after the memory has been
+// allocated, a denied reservation gives the operator the chance to spill or shrink instead.
+//
+// The children of a node with a share, i.e. the workload groups, may reserve the memory of
+// each other until the parent is nearly full, then each of them is limited to its fair share,
+// which is proportional to its share.
+//
+// This class is thread-safe.
+class MemReservation {
+public:
+    // limit < 0 means no limit
+    MemReservation(std::string label, int64_t limit, std::shared_ptr<MemReservation> parent,
+                   int64_t share = 0);
+    ~MemReservation();
+
+    // Returns false if the limit of this node or any ancestor would be exceeded,
+    // nothing is reserved then.
+    bool try_reserve(int64_t bytes);
+
+    void release(int64_t bytes);
+
+    int64_t reserved() const { return _reserved.load(std::memory_order_relaxed); }
+    int64_t limit() const { return _limit; }
+    const std::string& label() const { return _label; }
+
+    void set_share(int64_t share);
+
+    // Create the root of the hierarchy, memory reservation is disabled if it is not created
+    static void create_process_reservation(int64_t limit);
+
+    static std::shared_ptr<MemReservation> process_reservation() { return _s_process; }
+
+private:
+    bool _try_consume(int64_t bytes);
+    bool _within_fair_share(int64_t reserved) const;
+
+    const std::string _label;
+    const int64_t _limit;
+    std::shared_ptr<MemReservation> _parent;
+    std::atomic<int64_t> _reserved = 0;
+    std::atomic<int64_t> _share;
+    // sum of the shares of the children
+    std::atomic<int64_t> _children_share = 0;
+
+    static std::shared_ptr<MemReservation> _s_process;
+};
+
+// The memory reserved by one operator from the reservation of its query, which is released
+// when this object is destroyed. It reserves nothing if the reservation is nullptr.
+// Not thread-safe.
+class OperatorMemReservation {
+public:
+    OperatorMemReservation() = default;
+    ~OperatorMemReservation() {
+        if (_reserved > 0) {
+            _reservation->release(_reserved);
+        }
+    }
+
+    // Counters of the reservations are added to `profile` if it is not nullptr.
+    void init(std::shared_ptr<MemReservation> reservation, RuntimeProfile* profile);
+
+    // Grow or shrink the reserved bytes to `bytes`. Returns false if growing is denied,
+    // the reserved bytes are unchanged then.
+    bool reserve_to(int64_t bytes);
+
+    bool try_reserve(int64_t bytes) { return reserve_to(_reserved + bytes); }
+
+    int64_t reserved() const { return _reserved; }
+
+    // Whether memory reservation is enabled for the operator
+    bool enabled() const { return _reservation != nullptr; }
+
+private:
+    std::shared_ptr<MemReservation> _reservation;
+    int64_t _reserved = 0;
+
+    RuntimeProfile::HighWaterMarkCounter* _reserved_counter = nullptr;
+    RuntimeProfile::Counter* _denied_counter = nullptr;
+};
+
+} // namespace doris
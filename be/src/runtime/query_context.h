@@ -22,6 +22,7 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "common/config.h"
@@ -29,6 +30,7 @@
 #include "common/object_pool.h"
 #include "runtime/datetime_value.h"
 #include "runtime/exec_env.h"
+#include "runtime/memory/mem_reservation.h"
 #include "runtime/memory/mem_tracker_limiter.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/runtime_predicate.h"
@@ -144,6 +146,22 @@ public:
 
     taskgroup::TaskGroup* get_task_group() const { return _task_group.get(); }
 
+    // The memory reservation of this query, whose parent is the reservation of its task group
+    // or of the process. nullptr if memory reservation is disabled. Must be called after the
+    // task group is set.
+    std::shared_ptr<MemReservation> mem_reservation() {
+        std::call_once(_mem_reservation_once, [this]() {
+            auto parent = _task_group != nullptr ? _task_group->mem_reservation()
+                                                 : MemReservation::process_reservation();
+            if (parent != nullptr) {
+                _mem_reservation = std::make_shared<MemReservation>(
+                        fmt::format("Query#Id={}", print_id(query_id)),
+                        query_mem_tracker->limit(), std::move(parent));
+            }
+        });
+        return _mem_reservation;
+    }
+
     int execution_timeout() const {
         return _query_options.__isset.execution_timeout ? _query_options.execution_timeout
                                                         : _query_options.query_timeout;
@@ -186,6 +204,8 @@ public:
     std::atomic<int> fragment_num;
     int timeout_second;
     ObjectPool obj_pool;
+    // owns desc_tbl if it is shared with other queries
+    std::shared_ptr<ObjectPool> shared_desc_tbl_pool;
     // MemTracker that is shared by all fragment instances running on this host.
     std::shared_ptr<MemTrackerLimiter> query_mem_tracker;
 
@@ -214,6 +234,8 @@ private:
     vectorized::RuntimePredicate _runtime_predicate;
 
     taskgroup::TaskGroupPtr _task_group;
+    std::once_flag _mem_reservation_once;
+    std::shared_ptr<MemReservation> _mem_reservation;
     std::unique_ptr<RuntimeFilterMgr> _runtime_filter_mgr;
     const TQueryOptions _query_options;
 };
@@ -32,8 +32,10 @@
 #include "common/status.h"
 #include "runtime/exec_env.h"
 #include "runtime/load_path_mgr.h"
+#include "runtime/memory/mem_reservation.h"
 #include "runtime/memory/mem_tracker_limiter.h"
 #include "runtime/memory/thread_mem_tracker_mgr.h"
+#include "runtime/query_context.h"
 #include "runtime/runtime_filter_mgr.h"
 #include "runtime/thread_context.h"
 #include "util/timezone_utils.h"
@@ -377,4 +379,8 @@ int64_t RuntimeState::get_load_mem_limit() {
     }
 }
 
+std::shared_ptr<MemReservation> RuntimeState::query_mem_reservation() {
+    return _query_ctx == nullptr ? nullptr : _query_ctx->mem_reservation();
+}
+
 } // end namespace doris
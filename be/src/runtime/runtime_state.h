@@ -48,6 +48,7 @@ class DescriptorTbl;
 class ObjectPool;
 class ExecEnv;
 class RuntimeFilterMgr;
+class MemReservation;
 class MemTrackerLimiter;
 class QueryContext;
 
@@ -323,7 +324,7 @@ public:
 
     int partitioned_hash_agg_rows_threshold() const {
         if (!_query_options.__isset.partitioned_hash_agg_rows_threshold) {
-            return 0;
+            return 1048576;
         }
         return _query_options.partitioned_hash_agg_rows_threshold;
     }
@@ -348,6 +349,9 @@ public:
 
     QueryContext* get_query_ctx() { return _query_ctx; }
 
+    // nullptr if memory reservation is disabled or there is no query context
+    std::shared_ptr<MemReservation> query_mem_reservation();
+
     void set_query_mem_tracker(const std::shared_ptr<MemTrackerLimiter>& tracker) {
         _query_mem_tracker = tracker;
     }
@@ -481,7 +485,7 @@ private:
     std::vector<TTabletCommitInfo> _tablet_commit_infos;
     std::vector<TErrorTabletInfo> _error_tablet_infos;
 
-    QueryContext* _query_ctx;
+    QueryContext* _query_ctx = nullptr;
 
     // true if max_filter_ratio is 0
     bool _load_zero_tolerance = false;
@@ -27,6 +27,7 @@
 #include <utility>
 
 #include "common/logging.h"
+#include "runtime/memory/mem_reservation.h"
 
 namespace doris {
 namespace taskgroup {
@@ -64,7 +65,15 @@ std::string TaskGroupEntity::debug_string() const {
 }
 
 TaskGroup::TaskGroup(uint64_t id, std::string name, uint64_t cpu_share, int64_t version)
-        : _id(id), _name(name), _cpu_share(cpu_share), _task_entity(this), _version(version) {}
+        : _id(id), _name(name), _cpu_share(cpu_share), _task_entity(this), _version(version) {
+    if (auto process_reservation = MemReservation::process_reservation()) {
+        // the workload groups share the memory which can be reserved in proportion to their
+        // cpu shares
+        _mem_reservation = std::make_shared<MemReservation>(
+                fmt::format("TaskGroup#Id={}", id), -1, std::move(process_reservation),
+                cpu_share);
+    }
+}
 
 std::string TaskGroup::debug_string() const {
     std::shared_lock<std::shared_mutex> rl {mutex};
@@ -86,6 +95,9 @@ void TaskGroup::check_and_update(const TaskGroupInfo& tg_info) {
     if (tg_info._version > _version) {
         _name = tg_info._name;
         _cpu_share = tg_info._cpu_share;
+        if (_mem_reservation != nullptr) {
+            _mem_reservation->set_share(tg_info._cpu_share);
+        }
         _version = tg_info._version;
     }
 }
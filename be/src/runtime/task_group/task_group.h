@@ -34,6 +34,7 @@ namespace pipeline {
 class PipelineTask;
 }
 
+class MemReservation;
 class TPipelineResourceGroup;
 
 namespace taskgroup {
@@ -86,6 +87,9 @@ public:
 
     void check_and_update(const TaskGroupInfo& tg_info);
 
+    // nullptr if memory reservation is disabled
+    std::shared_ptr<MemReservation> mem_reservation() const { return _mem_reservation; }
+
 private:
     mutable std::shared_mutex mutex;
     const uint64_t _id;
@@ -93,6 +97,7 @@ private:
     std::atomic<uint64_t> _cpu_share;
     TaskGroupEntity _task_entity;
     int64_t _version;
+    std::shared_ptr<MemReservation> _mem_reservation;
 };
 
 using TaskGroupPtr = std::shared_ptr<TaskGroup>;
@@ -324,6 +324,10 @@ private:
 #define THREAD_MEM_TRACKER_TRANSFER_FROM(size, tracker) \
     tracker->transfer_to(                               \
             size, doris::thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker_raw())
+// Consume the limiter tracker of the thread only, used when the other side of a transfer is
+// accounted by the caller in batches.
+#define THREAD_LIMITER_MEM_TRACKER_CONSUME(size) \
+    doris::thread_context()->thread_mem_tracker_mgr->limiter_mem_tracker_raw()->cache_consume(size)
 
 // Mem Hook to consume thread mem tracker
 // TODO: In the original design, the MemTracker consume method is called before the memory is allocated.
@@ -352,6 +356,7 @@ private:
 #define RELEASE_THREAD_MEM_TRACKER(size) (void)0
 #define THREAD_MEM_TRACKER_TRANSFER_TO(size, tracker) (void)0
 #define THREAD_MEM_TRACKER_TRANSFER_FROM(size, tracker) (void)0
+#define THREAD_LIMITER_MEM_TRACKER_CONSUME(size) (void)0
 #define CONSUME_MEM_TRACKER(size) (void)0
 #define RELEASE_MEM_TRACKER(size) (void)0
 #endif
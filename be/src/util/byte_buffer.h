@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <string.h>
 
 #include <cstddef>
@@ -35,7 +36,7 @@ struct ByteBuffer {
         return ptr;
     }
 
-    ~ByteBuffer() { delete[] ptr; }
+    ~ByteBuffer() { delete[] reinterpret_cast<uint8_t*>(ptr); }
 
     void put_bytes(const char* data, size_t size) {
         memcpy(ptr + pos, data, size);
@@ -56,14 +57,25 @@ struct ByteBuffer {
     size_t remaining() const { return limit - pos; }
     bool has_remaining() const { return limit > pos; }
 
-    char* const ptr;
+    // Take over the memory of the buffer, the buffer is empty afterwards.
+    std::unique_ptr<uint8_t[]> release() {
+        std::unique_ptr<uint8_t[]> res(reinterpret_cast<uint8_t*>(ptr));
+        ptr = nullptr;
+        pos = limit = capacity = 0;
+        return res;
+    }
+
+    char* ptr;
     size_t pos;
     size_t limit;
     size_t capacity;
 
 private:
     ByteBuffer(size_t capacity_)
-            : ptr(new char[capacity_]), pos(0), limit(capacity_), capacity(capacity_) {}
+            : ptr(reinterpret_cast<char*>(new uint8_t[capacity_])),
+              pos(0),
+              limit(capacity_),
+              capacity(capacity_) {}
 };
 
 } // namespace doris
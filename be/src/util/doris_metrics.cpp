@@ -99,6 +99,11 @@ DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(base_compaction_bytes_total, MetricUnit::BY
 DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(cumulative_compaction_bytes_total, MetricUnit::BYTES, "",
                                      compaction_bytes_total, Labels({{"type", "cumulative"}}));
 
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(schema_change_sorted_rows_total, MetricUnit::ROWS, "",
+                                     schema_change_sorted, Labels({{"type", "rows"}}));
+DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(schema_change_sorted_runs_total, MetricUnit::ROWSETS, "",
+                                     schema_change_sorted, Labels({{"type", "runs"}}));
+
 DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(meta_write_request_total, MetricUnit::REQUESTS, "",
                                      meta_request_total, Labels({{"type", "write"}}));
 DEFINE_COUNTER_METRIC_PROTOTYPE_5ARG(meta_read_request_total, MetricUnit::REQUESTS, "",
@@ -153,9 +158,11 @@ DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(all_rowsets_num, MetricUnit::NOUNIT);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(all_segments_num, MetricUnit::NOUNIT);
 
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(compaction_used_permits, MetricUnit::NOUNIT);
+DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(schema_change_sort_mem_bytes, MetricUnit::BYTES);
 DEFINE_GAUGE_METRIC_PROTOTYPE_2ARG(compaction_waitting_permits, MetricUnit::NOUNIT);
 
 DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(tablet_version_num_distribution, MetricUnit::NOUNIT);
+DEFINE_HISTOGRAM_METRIC_PROTOTYPE_2ARG(fragment_prepare_duration_us, MetricUnit::MICROSECONDS);
 
 DEFINE_GAUGE_CORE_METRIC_PROTOTYPE_2ARG(query_scan_bytes_per_second, MetricUnit::BYTES);
 
@@ -259,6 +266,9 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, cumulative_compaction_deltas_total);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, cumulative_compaction_bytes_total);
 
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, schema_change_sorted_rows_total);
+    INT_COUNTER_METRIC_REGISTER(_server_metric_entity, schema_change_sorted_runs_total);
+
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, meta_write_request_total);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, meta_write_request_duration_us);
     INT_COUNTER_METRIC_REGISTER(_server_metric_entity, meta_read_request_total);
@@ -290,8 +300,10 @@ DorisMetrics::DorisMetrics() : _metric_registry(_s_registry_name) {
 
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, compaction_used_permits);
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, compaction_waitting_permits);
+    INT_GAUGE_METRIC_REGISTER(_server_metric_entity, schema_change_sort_mem_bytes);
 
     HISTOGRAM_METRIC_REGISTER(_server_metric_entity, tablet_version_num_distribution);
+    HISTOGRAM_METRIC_REGISTER(_server_metric_entity, fragment_prepare_duration_us);
 
     INT_GAUGE_METRIC_REGISTER(_server_metric_entity, query_scan_bytes_per_second);
 
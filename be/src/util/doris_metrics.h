@@ -95,6 +95,9 @@ public:
     IntCounter* cumulative_compaction_deltas_total;
     IntCounter* cumulative_compaction_bytes_total;
 
+    IntCounter* schema_change_sorted_rows_total;
+    IntCounter* schema_change_sorted_runs_total;
+
     IntCounter* publish_task_request_total;
     IntCounter* publish_task_failed_total;
 
@@ -147,7 +150,12 @@ public:
     // permits required by the compaction task which is waiting for permits
     IntGauge* compaction_waitting_permits;
 
+    // memory of the blocks held by all sorting schema changes
+    IntGauge* schema_change_sort_mem_bytes;
+
     HistogramMetric* tablet_version_num_distribution;
+    // time to prepare a fragment instance
+    HistogramMetric* fragment_prepare_duration_us;
 
     // The following metrics will be calculated
     // by metric calculator
@@ -129,8 +129,9 @@ void attachment_transfer_request_row_batch(const Params* brpc_request, brpc::Con
     }
 }
 
-// TODO(zxy) delete in v1.3 version
 // Controller Attachment transferred to Block in ProtoBuf Request.
+// Also used by broadcast exchange, which shares the column values of one block as attachment
+// between the requests to all receivers.
 template <typename Params>
 void attachment_transfer_request_block(const Params* brpc_request, brpc::Controller* cntl) {
     Params* req = const_cast<Params*>(brpc_request);
@@ -0,0 +1,136 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace doris {
+
+// A thread safe hash map split into shards by the hash of the key, each shard has its own
+// lock, so that the operations on different keys seldom wait for each other.
+// Values are returned by copy, use std::shared_ptr for the values which are not cheap to copy.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedMap {
+public:
+    static constexpr size_t kDefaultNumShards = 128;
+
+    explicit ShardedMap(size_t num_shards = kDefaultNumShards)
+            : _shards(num_shards == 0 ? 1 : num_shards) {}
+
+    // Returns false if the key exists, the value is not inserted then.
+    bool insert(const Key& key, Value value) {
+        auto& shard = _get_shard(key);
+        std::lock_guard<std::mutex> l(shard.lock);
+        return shard.map.emplace(key, std::move(value)).second;
+    }
+
+    bool find(const Key& key, Value* value) const {
+        const auto& shard = _get_shard(key);
+        std::lock_guard<std::mutex> l(shard.lock);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return false;
+        }
+        *value = it->second;
+        return true;
+    }
+
+    bool contains(const Key& key) const {
+        const auto& shard = _get_shard(key);
+        std::lock_guard<std::mutex> l(shard.lock);
+        return shard.map.find(key) != shard.map.end();
+    }
+
+    // Returns the value of the key, or inserts `value` if the key does not exist.
+    Value find_or_insert(const Key& key, Value value) {
+        auto& shard = _get_shard(key);
+        std::lock_guard<std::mutex> l(shard.lock);
+        return shard.map.emplace(key, std::move(value)).first->second;
+    }
+
+    bool erase(const Key& key) {
+        auto& shard = _get_shard(key);
+        std::lock_guard<std::mutex> l(shard.lock);
+        return shard.map.erase(key) > 0;
+    }
+
+    // Erases the entries for which pred(key, value) returns true.
+    template <typename Pred>
+    void erase_if(Pred&& pred) {
+        for (auto& shard : _shards) {
+            std::lock_guard<std::mutex> l(shard.lock);
+            for (auto it = shard.map.begin(); it != shard.map.end();) {
+                if (pred(it->first, it->second)) {
+                    it = shard.map.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    // Calls func(key, value) for all entries, holding the lock of one shard at a time,
+    // so func must not access this map.
+    template <typename Func>
+    void for_each(Func&& func) const {
+        for (const auto& shard : _shards) {
+            std::lock_guard<std::mutex> l(shard.lock);
+            for (const auto& [key, value] : shard.map) {
+                func(key, value);
+            }
+        }
+    }
+
+    size_t size() const {
+        size_t size = 0;
+        for (const auto& shard : _shards) {
+            std::lock_guard<std::mutex> l(shard.lock);
+            size += shard.map.size();
+        }
+        return size;
+    }
+
+    void clear() {
+        for (auto& shard : _shards) {
+            std::lock_guard<std::mutex> l(shard.lock);
+            shard.map.clear();
+        }
+    }
+
+private:
+    struct Shard {
+        mutable std::mutex lock;
+        std::unordered_map<Key, Value, Hash> map;
+    };
+
+    Shard& _get_shard(const Key& key) { return _shards[Hash()(key) % _shards.size()]; }
+
+    const Shard& _get_shard(const Key& key) const {
+        return _shards[Hash()(key) % _shards.size()];
+    }
+
+    std::vector<Shard> _shards;
+};
+
+} // namespace doris
@@ -31,6 +31,7 @@
 
 #include "vec/columns/column_array.h"
 #include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
 #include "vec/columns/columns_number.h"
 #include "vec/common/field_visitors.h"
 #include "vec/common/schema_util.h"
@@ -63,6 +64,35 @@ DataTypePtr create_array_of_type(DataTypePtr type, size_t num_dimensions) {
     return type;
 }
 
+/// Pushes a value into a part of subcolumn whose nested column is ColumnType,
+/// returns false for parts of other columns.
+template <typename ColumnType, typename Inserter>
+bool insert_into_part(IColumn& part, Inserter&& inserter) {
+    if (auto* nullable = typeid_cast<ColumnNullable*>(&part)) {
+        auto* column = typeid_cast<ColumnType*>(&nullable->get_nested_column());
+        if (column == nullptr) {
+            return false;
+        }
+        inserter(*column);
+        nullable->get_null_map_data().push_back(0);
+        return true;
+    }
+    auto* column = typeid_cast<ColumnType*>(&part);
+    if (column == nullptr) {
+        return false;
+    }
+    inserter(*column);
+    return true;
+}
+
+/// Type id of scalar type, ignoring Nullable.
+TypeIndex get_scalar_type_id(const DataTypePtr& type) {
+    if (const auto* nullable = typeid_cast<const DataTypeNullable*>(type.get())) {
+        return nullable->get_nested_type()->get_type_id();
+    }
+    return type->get_type_id();
+}
+
 DataTypePtr getBaseTypeOfArray(const DataTypePtr& type) {
     /// Get raw pointers to avoid extra copying of type pointers.
     const DataTypeArray* last_array = nullptr;
@@ -303,6 +333,56 @@ Status ColumnObject::Subcolumn::insert(Field field) {
     return insert(std::move(field), std::move(info));
 }
 
+bool ColumnObject::Subcolumn::try_insert_int64(Int64 value) {
+    if (data.empty() || least_common_type.get_dimensions() != 0 ||
+        get_scalar_type_id(least_common_type.getBase()) != TypeIndex::Int64) {
+        return false;
+    }
+    return insert_into_part<ColumnInt64>(
+            *data.back(), [&](ColumnInt64& column) { column.get_data().push_back(value); });
+}
+
+bool ColumnObject::Subcolumn::try_insert_bool(bool value) {
+    if (data.empty() || least_common_type.get_dimensions() != 0) {
+        return false;
+    }
+    // bool is inserted as an integer, any integer type can hold it
+    switch (get_scalar_type_id(least_common_type.getBase())) {
+    case TypeIndex::Int8:
+        return insert_into_part<ColumnInt8>(
+                *data.back(), [&](ColumnInt8& column) { column.get_data().push_back(value); });
+    case TypeIndex::Int16:
+        return insert_into_part<ColumnInt16>(
+                *data.back(), [&](ColumnInt16& column) { column.get_data().push_back(value); });
+    case TypeIndex::Int32:
+        return insert_into_part<ColumnInt32>(
+                *data.back(), [&](ColumnInt32& column) { column.get_data().push_back(value); });
+    case TypeIndex::Int64:
+        return insert_into_part<ColumnInt64>(
+                *data.back(), [&](ColumnInt64& column) { column.get_data().push_back(value); });
+    default:
+        return false;
+    }
+}
+
+bool ColumnObject::Subcolumn::try_insert_float64(Float64 value) {
+    if (data.empty() || least_common_type.get_dimensions() != 0 ||
+        get_scalar_type_id(least_common_type.getBase()) != TypeIndex::Float64) {
+        return false;
+    }
+    return insert_into_part<ColumnFloat64>(
+            *data.back(), [&](ColumnFloat64& column) { column.get_data().push_back(value); });
+}
+
+bool ColumnObject::Subcolumn::try_insert_string(const StringRef& value) {
+    if (data.empty() || least_common_type.get_dimensions() != 0 ||
+        get_scalar_type_id(least_common_type.getBase()) != TypeIndex::String) {
+        return false;
+    }
+    return insert_into_part<ColumnString>(
+            *data.back(), [&](ColumnString& column) { column.insert_data(value.data, value.size); });
+}
+
 void ColumnObject::Subcolumn::add_new_column_part(DataTypePtr type) {
     data.push_back(type->create_column());
     least_common_type = LeastCommonType {std::move(type)};
@@ -114,6 +114,14 @@ public:
 
         Status insert(Field field, FieldInfo info);
 
+        /// Fast paths of insert(Field) for scalars parsed from JSON, which push the value into
+        /// the last part directly. Return false if the subcolumn has no part yet, is an array,
+        /// or its type can't hold the value without widening, insert(Field) should be used then.
+        bool try_insert_int64(Int64 value);
+        bool try_insert_bool(bool value);
+        bool try_insert_float64(Float64 value);
+        bool try_insert_string(const StringRef& value);
+
         void insertDefault();
 
         void insertManyDefaults(size_t length);
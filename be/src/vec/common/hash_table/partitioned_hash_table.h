@@ -452,9 +452,9 @@ public:
                                size_t hash_value) {
         if (_is_partitioned) {
             size_t sub_table_idx = get_sub_table_from_hash(hash_value);
-            level1_sub_tables[sub_table_idx].emplace(key_holder, it, inserted, hash_value);
+            emplace_impl(level1_sub_tables[sub_table_idx], key_holder, it, inserted, hash_value);
         } else {
-            level0_sub_table.emplace(key_holder, it, inserted, hash_value);
+            emplace_impl(level0_sub_table, key_holder, it, inserted, hash_value);
             if (UNLIKELY(level0_sub_table.need_partition())) {
                 convert_to_partitioned();
 
@@ -551,7 +551,28 @@ public:
         return !_is_partitioned && level0_sub_table.add_elem_size_overflow(row);
     }
 
+    bool is_partitioned() const { return _is_partitioned; }
+
+    static constexpr size_t get_sub_table_count() { return NUM_LEVEL1_SUB_TABLES; }
+
+    /// The sub table of the key with the hash value once the table is partitioned, keys in
+    /// different sub tables can be processed by different threads.
+    static size_t get_sub_table_idx(size_t hash_value) {
+        return get_sub_table_from_hash(hash_value);
+    }
+
 private:
+    /// PHHashMap takes the hash value before the `inserted` flag.
+    template <typename KeyHolder>
+    static void ALWAYS_INLINE emplace_impl(Impl& table, KeyHolder&& key_holder, LookupResult& it,
+                                           bool& inserted, size_t hash_value) {
+        if constexpr (HashTableTraits<Impl>::is_phmap) {
+            table.emplace(key_holder, it, hash_value, inserted);
+        } else {
+            table.emplace(key_holder, it, inserted, hash_value);
+        }
+    }
+
     void convert_to_partitioned() {
         SCOPED_RAW_TIMER(&_convert_timer_ns);
 
@@ -271,7 +271,7 @@ private:
     // if need resize and bucket count after resize will be >= _partitioned_threshold,
     // this flag is set to true, and resize does not actually happen,
     // PartitionedHashTable will convert this hash table to partitioned hash table
-    bool _need_partition;
+    bool _need_partition = false;
 };
 
 template <typename Key, typename Mapped, typename Hash, bool PartitionedHashTable>
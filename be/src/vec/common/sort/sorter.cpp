@@ -26,10 +26,13 @@
 #include <string>
 #include <utility>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "runtime/block_spill_manager.h"
 #include "runtime/exec_env.h"
+#include "runtime/memory/mem_tracker_limiter.h"
 #include "runtime/thread_context.h"
+#include "util/threadpool.h"
 #include "vec/columns/column.h"
 #include "vec/columns/column_nullable.h"
 #include "vec/core/block_spill_reader.h"
@@ -71,8 +74,10 @@ Status MergeSorterState::add_sorted_block(Block& block) {
 
     auto bytes_used = data_size();
     auto total_bytes_used = bytes_used + block.bytes();
-    if (is_spilled_ || (external_sort_bytes_threshold_ > 0 &&
-                        total_bytes_used >= external_sort_bytes_threshold_)) {
+    if (is_spilled_ ||
+        (external_sort_bytes_threshold_ > 0 &&
+         total_bytes_used >= external_sort_bytes_threshold_) ||
+        !mem_reservation_.try_reserve(block.allocated_bytes())) {
         is_spilled_ = true;
         BlockSpillWriterUPtr spill_block_writer;
         RETURN_IF_ERROR(ExecEnv::GetInstance()->block_spill_mgr()->get_writer(
@@ -258,6 +263,20 @@ Status MergeSorterState::_create_intermediate_merger(int num_blocks,
 
 Status Sorter::partial_sort(Block& src_block, Block& dest_block) {
     size_t num_cols = src_block.columns();
+    Block* result_block = nullptr;
+    RETURN_IF_ERROR(prepare_for_partial_sort(src_block, dest_block, &result_block));
+
+    {
+        SCOPED_TIMER(_partial_sort_timer);
+        sort_block(*result_block, dest_block, _sort_description, _offset + _limit);
+        src_block.clear_column_data(num_cols);
+    }
+
+    return Status::OK();
+}
+
+Status Sorter::prepare_for_partial_sort(Block& src_block, Block& dest_block,
+                                        Block** result_block) {
     if (_materialize_sort_exprs) {
         auto output_tuple_expr_ctxs = _vsort_exec_exprs.sort_tuple_slot_expr_ctxs();
         std::vector<int> valid_column_ids(output_tuple_expr_ctxs.size());
@@ -285,26 +304,16 @@ Status Sorter::partial_sort(Block& src_block, Block& dest_block) {
     }
 
     _sort_description.resize(_vsort_exec_exprs.lhs_ordering_expr_ctxs().size());
-    Block* result_block = _materialize_sort_exprs ? &dest_block : &src_block;
+    *result_block = _materialize_sort_exprs ? &dest_block : &src_block;
     for (int i = 0; i < _sort_description.size(); i++) {
         const auto& ordering_expr = _vsort_exec_exprs.lhs_ordering_expr_ctxs()[i];
-        RETURN_IF_ERROR(ordering_expr->execute(result_block, &_sort_description[i].column_number));
+        RETURN_IF_ERROR(
+                ordering_expr->execute(*result_block, &_sort_description[i].column_number));
 
         _sort_description[i].direction = _is_asc_order[i] ? 1 : -1;
         _sort_description[i].nulls_direction =
                 _nulls_first[i] ? -_sort_description[i].direction : _sort_description[i].direction;
     }
-
-    {
-        SCOPED_TIMER(_partial_sort_timer);
-        if (_materialize_sort_exprs) {
-            sort_block(dest_block, dest_block, _sort_description, _offset + _limit);
-        } else {
-            sort_block(src_block, dest_block, _sort_description, _offset + _limit);
-        }
-        src_block.clear_column_data(num_cols);
-    }
-
     return Status::OK();
 }
 
@@ -313,7 +322,16 @@ FullSorter::FullSorter(VSortExecExprs& vsort_exec_exprs, int limit, int64_t offs
                        std::vector<bool>& nulls_first, const RowDescriptor& row_desc,
                        RuntimeState* state, RuntimeProfile* profile)
         : Sorter(vsort_exec_exprs, limit, offset, pool, is_asc_order, nulls_first),
-          _state(MergeSorterState::create_unique(row_desc, offset, limit, state, profile)) {}
+          _state(MergeSorterState::create_unique(row_desc, offset, limit, state, profile)),
+          _runtime_state(state) {
+    auto query_mem_tracker = state->query_mem_tracker();
+    if (query_mem_tracker != nullptr && query_mem_tracker->has_limit()) {
+        max_buffered_block_bytes_ = std::clamp<size_t>(query_mem_tracker->limit() / 8,
+                                                       MIN_BUFFERED_BLOCK_BYTES,
+                                                       SPILL_BUFFERED_BLOCK_BYTES);
+        buffered_block_bytes_ = std::min(buffered_block_bytes_, max_buffered_block_bytes_);
+    }
+}
 
 Status FullSorter::append_block(Block* block) {
     DCHECK(block->rows() > 0);
@@ -350,6 +368,12 @@ Status FullSorter::get_next(RuntimeState* state, Block* block, bool* eos) {
 }
 
 Status FullSorter::_do_sort() {
+    if (_limit == -1) {
+        size_t num_runs = _num_parallel_runs(_state->unsorted_block_->rows());
+        if (num_runs > 1) {
+            return _do_parallel_sort(num_runs);
+        }
+    }
     Block* src_block = _state->unsorted_block_.get();
     Block desc_block = src_block->clone_without_columns();
     RETURN_IF_ERROR(partial_sort(*src_block, desc_block));
@@ -390,7 +414,81 @@ Status FullSorter::_do_sort() {
         _block_priority_queue.swap(tmp);
 
         buffered_block_size_ = SPILL_BUFFERED_BLOCK_SIZE;
-        buffered_block_bytes_ = SPILL_BUFFERED_BLOCK_BYTES;
+        buffered_block_bytes_ = max_buffered_block_bytes_;
+    }
+    return Status::OK();
+}
+
+size_t FullSorter::_num_parallel_runs(size_t rows) const {
+    ThreadPool* thread_pool = ExecEnv::GetInstance()->sort_thread_pool();
+    int32_t min_rows_per_run = config::parallel_sort_min_rows_per_run;
+    if (thread_pool == nullptr || min_rows_per_run <= 0) {
+        return 1;
+    }
+    return std::min<size_t>(rows / min_rows_per_run, thread_pool->max_threads());
+}
+
+Status sort_runs_in_parallel(ThreadPool* thread_pool, RuntimeState* state,
+                             const SortDescription& description, std::vector<Block>* runs) {
+    std::vector<Status> statuses(runs->size());
+    auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    for (size_t i = 0; i < runs->size(); ++i) {
+        Block* run = &(*runs)[i];
+        auto st = token->submit_func([state, run, &description, status = &statuses[i]]() {
+            // memory of the sorted columns is consumed by the query
+            SCOPED_ATTACH_TASK(state);
+            *status = [&]() {
+                RETURN_IF_CATCH_EXCEPTION(sort_block(*run, *run, description));
+                return Status::OK();
+            }();
+        });
+        if (!st.ok()) {
+            // the pool is shut down, sort the run by this thread
+            RETURN_IF_CATCH_EXCEPTION(sort_block(*run, *run, description));
+        }
+    }
+    token->wait();
+    for (const auto& status : statuses) {
+        RETURN_IF_ERROR(status);
+    }
+    return Status::OK();
+}
+
+// Split the buffered rows into runs which are sorted by the sort thread pool in parallel,
+// the runs are merged with other sorted blocks by MergeSorterState.
+Status FullSorter::_do_parallel_sort(size_t num_runs) {
+    Block* src_block = _state->unsorted_block_.get();
+    size_t num_cols = src_block->columns();
+    Block desc_block = src_block->clone_without_columns();
+    Block* result_block = nullptr;
+    RETURN_IF_ERROR(prepare_for_partial_sort(*src_block, desc_block, &result_block));
+
+    std::vector<Block> runs(num_runs);
+    {
+        SCOPED_TIMER(_partial_sort_timer);
+        size_t rows = result_block->rows();
+        size_t rows_per_run = (rows + num_runs - 1) / num_runs;
+        for (size_t i = 0; i < num_runs; ++i) {
+            size_t offset = i * rows_per_run;
+            size_t length = std::min(rows_per_run, rows - offset);
+            Block& run = runs[i];
+            RETURN_IF_CATCH_EXCEPTION({
+                for (const auto& column : *result_block) {
+                    run.insert({column.column->cut(offset, length), column.type, column.name});
+                }
+            });
+        }
+        src_block->clear_column_data(num_cols);
+        RETURN_IF_ERROR(sort_runs_in_parallel(ExecEnv::GetInstance()->sort_thread_pool(),
+                                              _runtime_state, _sort_description, &runs));
+    }
+
+    for (auto& run : runs) {
+        RETURN_IF_ERROR(_state->add_sorted_block(run));
+    }
+    if (_state->is_spilled()) {
+        buffered_block_size_ = SPILL_BUFFERED_BLOCK_SIZE;
+        buffered_block_bytes_ = max_buffered_block_bytes_;
     }
     return Status::OK();
 }
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "common/status.h"
+#include "runtime/memory/mem_reservation.h"
 #include "runtime/runtime_state.h"
 #include "util/runtime_profile.h"
 #include "vec/common/sort/vsort_exec_exprs.h"
@@ -40,10 +41,16 @@
 namespace doris {
 class ObjectPool;
 class RowDescriptor;
+class ThreadPool;
 } // namespace doris
 
 namespace doris::vectorized {
 
+// Sort `runs' by `thread_pool' in parallel, pool tasks are attached to the query of `state'.
+// A run is sorted by the calling thread if it can't be submitted.
+Status sort_runs_in_parallel(ThreadPool* thread_pool, RuntimeState* state,
+                             const SortDescription& description, std::vector<Block>* runs);
+
 // TODO: now we only use merge sort
 class MergeSorterState {
     ENABLE_FACTORY_CREATOR(MergeSorterState);
@@ -67,6 +74,8 @@ public:
         spilled_block_count_ = ADD_COUNTER(block_spill_profile_, "BlockCount", TUnit::UNIT);
         spilled_original_block_size_ =
                 ADD_COUNTER(block_spill_profile_, "BlockBytes", TUnit::BYTES);
+
+        mem_reservation_.init(state->query_mem_reservation(), profile);
     }
 
     ~MergeSorterState() = default;
@@ -127,6 +136,9 @@ private:
     RuntimeProfile* block_spill_profile_;
     RuntimeProfile::Counter* spilled_block_count_;
     RuntimeProfile::Counter* spilled_original_block_size_;
+
+    // the sorted blocks are spilled once the memory for them can not be reserved
+    OperatorMemReservation mem_reservation_;
 };
 
 class Sorter {
@@ -165,6 +177,10 @@ public:
 protected:
     Status partial_sort(Block& src_block, Block& dest_block);
 
+    // materialize sort exprs into dest_block if necessary and build the sort description,
+    // returns the block to be sorted
+    Status prepare_for_partial_sort(Block& src_block, Block& dest_block, Block** result_block);
+
     SortDescription _sort_description;
     VSortExecExprs& _vsort_exec_exprs;
     int _limit;
@@ -208,7 +224,13 @@ private:
 
     Status _do_sort();
 
+    // number of runs the buffered rows are split into to be sorted in parallel
+    size_t _num_parallel_runs(size_t rows) const;
+
+    Status _do_parallel_sort(size_t num_runs);
+
     std::unique_ptr<MergeSorterState> _state;
+    RuntimeState* _runtime_state;
 
     static constexpr size_t INITIAL_BUFFERED_BLOCK_SIZE = 1024 * 1024;
     static constexpr size_t INITIAL_BUFFERED_BLOCK_BYTES = 64 << 20;
@@ -216,8 +238,13 @@ private:
     static constexpr size_t SPILL_BUFFERED_BLOCK_SIZE = 4 * 1024 * 1024;
     static constexpr size_t SPILL_BUFFERED_BLOCK_BYTES = 256 << 20;
 
+    static constexpr size_t MIN_BUFFERED_BLOCK_BYTES = 8 << 20;
+
     size_t buffered_block_size_ = INITIAL_BUFFERED_BLOCK_SIZE;
     size_t buffered_block_bytes_ = INITIAL_BUFFERED_BLOCK_BYTES;
+    // buffered bytes are bounded by the memory limit of the query, since sorting a buffered
+    // block takes twice of its memory
+    size_t max_buffered_block_bytes_ = SPILL_BUFFERED_BLOCK_BYTES;
 };
 
 } // namespace doris::vectorized
@@ -20,7 +20,9 @@
 
 #include "vec/core/sort_block.h"
 
+#include "common/config.h"
 #include "vec/core/column_with_type_and_name.h"
+#include "vec/core/sort_normalized_key.h"
 
 namespace doris::vectorized {
 
@@ -62,6 +64,9 @@ struct PartialSortingLess {
     }
 };
 
+// radix sort on normalized keys doesn't pay off its encoding for fewer rows
+static constexpr size_t NORMALIZED_KEY_SORT_MIN_ROWS = 256;
+
 void sort_block(Block& src_block, Block& dest_block, const SortDescription& description,
                 UInt64 limit) {
     if (!src_block) {
@@ -87,18 +92,23 @@ void sort_block(Block& src_block, Block& dest_block, const SortDescription& desc
         }
     } else {
         size_t size = src_block.rows();
-        IColumn::Permutation perm(size);
-        for (size_t i = 0; i < size; ++i) {
-            perm[i] = i;
-        }
-
         if (limit >= size) {
             limit = 0;
         }
 
-        ColumnsWithSortDescriptions columns_with_sort_desc =
-                get_columns_with_sort_description(src_block, description);
-        {
+        IColumn::Permutation perm;
+        NormalizedSortKeys normalized_keys;
+        if (limit == 0 && size >= NORMALIZED_KEY_SORT_MIN_ROWS &&
+            config::enable_normalized_key_sort && normalized_keys.init(src_block, description)) {
+            normalized_keys.get_permutation(perm);
+        } else {
+            perm.resize(size);
+            for (size_t i = 0; i < size; ++i) {
+                perm[i] = i;
+            }
+
+            ColumnsWithSortDescriptions columns_with_sort_desc =
+                    get_columns_with_sort_description(src_block, description);
             EqualFlags flags(size, 1);
             EqualRange range {0, size};
 
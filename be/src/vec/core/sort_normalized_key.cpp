@@ -0,0 +1,293 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_normalized_key.h"
+
+#include <glog/logging.h>
+#include <pdqsort.h>
+#include <string.h>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "vec/columns/column_const.h"
+#include "vec/columns/column_decimal.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/sort_block.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+namespace {
+
+template <typename T>
+struct UnsignedOf {
+    using type = std::make_unsigned_t<T>;
+};
+
+template <>
+struct UnsignedOf<Int128> {
+    using type = unsigned __int128;
+};
+
+template <typename T>
+auto native_value(const T& value) {
+    if constexpr (IsDecimalNumber<T>) {
+        return value.value;
+    } else {
+        return value;
+    }
+}
+
+template <typename U>
+void store_big_endian(uint8_t* dst, U value) {
+    for (ssize_t i = sizeof(U) - 1; i >= 0; --i) {
+        dst[i] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+// write value bytes of all rows of `column` to keys + row * key_bytes
+using Encoder = void (*)(const IColumn& column, size_t width, bool desc, uint8_t* keys,
+                         size_t key_bytes, size_t rows);
+
+template <typename ColumnType>
+void encode_integers(const IColumn& column, size_t width, bool desc, uint8_t* keys,
+                     size_t key_bytes, size_t rows) {
+    const auto& data = assert_cast<const ColumnType&>(column).get_data();
+    using Native = std::decay_t<decltype(native_value(data[0]))>;
+    using U = typename UnsignedOf<Native>::type;
+    constexpr bool is_signed = std::is_same_v<Native, Int128> || std::is_signed_v<Native>;
+    DCHECK_EQ(width, sizeof(U));
+    for (size_t i = 0; i < rows; ++i) {
+        U value = static_cast<U>(native_value(data[i]));
+        if constexpr (is_signed) {
+            value ^= U(1) << (sizeof(U) * 8 - 1);
+        }
+        if (desc) {
+            value = ~value;
+        }
+        store_big_endian(keys + i * key_bytes, value);
+    }
+}
+
+void encode_string_prefixes(const IColumn& column, size_t width, bool desc, uint8_t* keys,
+                            size_t key_bytes, size_t rows) {
+    const auto& column_string = assert_cast<const ColumnString&>(column);
+    for (size_t i = 0; i < rows; ++i) {
+        StringRef value = column_string.get_data_at(i);
+        uint8_t* dst = keys + i * key_bytes;
+        size_t size = std::min(value.size, width);
+        memcpy(dst, value.data, size);
+        memset(dst + size, 0, width - size);
+        if (desc) {
+            for (size_t j = 0; j < width; ++j) {
+                dst[j] = ~dst[j];
+            }
+        }
+    }
+}
+
+// returns false if `column` can't be encoded, `width` is 0 for string prefixes
+bool get_encoder(const IColumn& column, Encoder* encoder, size_t* width) {
+#define DISPATCH(COLUMN_TYPE)                                                        \
+    if (check_and_get_column<COLUMN_TYPE>(column)) {                                 \
+        *encoder = encode_integers<COLUMN_TYPE>;                                     \
+        *width = sizeof(typename COLUMN_TYPE::value_type);                           \
+        return true;                                                                 \
+    }
+    DISPATCH(ColumnVector<UInt8>)
+    DISPATCH(ColumnVector<UInt16>)
+    DISPATCH(ColumnVector<UInt32>)
+    DISPATCH(ColumnVector<UInt64>)
+    DISPATCH(ColumnVector<Int8>)
+    DISPATCH(ColumnVector<Int16>)
+    DISPATCH(ColumnVector<Int32>)
+    DISPATCH(ColumnVector<Int64>)
+    DISPATCH(ColumnVector<Int128>)
+    DISPATCH(ColumnDecimal<Decimal32>)
+    DISPATCH(ColumnDecimal<Decimal64>)
+    DISPATCH(ColumnDecimal<Decimal128>)
+    DISPATCH(ColumnDecimal<Decimal128I>)
+#undef DISPATCH
+    if (check_and_get_column<ColumnString>(column)) {
+        *encoder = encode_string_prefixes;
+        *width = 0;
+        return true;
+    }
+    return false;
+}
+
+struct EqualKeysLess {
+    ColumnsWithSortDescriptions columns;
+
+    bool operator()(size_t a, size_t b) const {
+        for (const auto& [column, desc] : columns) {
+            int res = desc.direction * column->compare_at(a, b, *column, desc.nulls_direction);
+            if (res < 0) {
+                return true;
+            } else if (res > 0) {
+                return false;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+bool NormalizedSortKeys::init(const Block& block, const SortDescription& description) {
+    struct ColumnEncoding {
+        const IColumn* column;
+        const NullMap* null_map;
+        Encoder encoder;
+        size_t offset;
+        size_t width;
+        bool desc;
+        bool nulls_first;
+    };
+
+    _block = &block;
+    _description = &description;
+    _rows = block.rows();
+    _key_bytes = 0;
+    _num_complete_columns = 0;
+
+    std::vector<ColumnEncoding> encodings;
+    ColumnsWithSortDescriptions columns = get_columns_with_sort_description(block, description);
+    for (const auto& [column, desc] : columns) {
+        if (is_column_const(*column)) {
+            ++_num_complete_columns;
+            continue;
+        }
+        const IColumn* nested_column = column;
+        const NullMap* null_map = nullptr;
+        if (const auto* nullable = check_and_get_column<ColumnNullable>(*column)) {
+            nested_column = &nullable->get_nested_column();
+            null_map = &nullable->get_null_map_data();
+        }
+        size_t null_bytes = null_map != nullptr ? 1 : 0;
+        Encoder encoder = nullptr;
+        size_t width = 0;
+        if (!get_encoder(*nested_column, &encoder, &width) ||
+            _key_bytes + null_bytes >= MAX_KEY_BYTES) {
+            break;
+        }
+        bool complete = width != 0;
+        if (!complete) {
+            width = std::min(STRING_PREFIX_BYTES, MAX_KEY_BYTES - _key_bytes - null_bytes);
+        } else if (_key_bytes + null_bytes + width > MAX_KEY_BYTES) {
+            break;
+        }
+        encodings.push_back({nested_column, null_map, encoder, _key_bytes, width,
+                             desc.direction < 0, desc.direction * desc.nulls_direction < 0});
+        _key_bytes += null_bytes + width;
+        if (!complete) {
+            break;
+        }
+        ++_num_complete_columns;
+    }
+    if (_key_bytes == 0) {
+        return false;
+    }
+
+    _keys.resize(_rows * _key_bytes);
+    for (const auto& encoding : encodings) {
+        uint8_t* keys = _keys.data() + encoding.offset;
+        if (encoding.null_map == nullptr) {
+            encoding.encoder(*encoding.column, encoding.width, encoding.desc, keys, _key_bytes,
+                             _rows);
+            continue;
+        }
+        encoding.encoder(*encoding.column, encoding.width, encoding.desc, keys + 1, _key_bytes,
+                         _rows);
+        const auto& null_map = *encoding.null_map;
+        uint8_t null_byte = encoding.nulls_first ? 0 : 1;
+        for (size_t i = 0; i < _rows; ++i) {
+            uint8_t* key = keys + i * _key_bytes;
+            if (null_map[i]) {
+                key[0] = null_byte;
+                // values of null rows are undefined, make them equal
+                memset(key + 1, 0, encoding.width);
+            } else {
+                key[0] = 1 - null_byte;
+            }
+        }
+    }
+    return true;
+}
+
+void NormalizedSortKeys::get_permutation(IColumn::Permutation& perm) const {
+    _radix_sort(perm);
+    if (_num_complete_columns < _description->size()) {
+        _sort_equal_keys(perm);
+    }
+}
+
+void NormalizedSortKeys::_radix_sort(IColumn::Permutation& perm) const {
+    perm.resize(_rows);
+    for (size_t i = 0; i < _rows; ++i) {
+        perm[i] = i;
+    }
+    IColumn::Permutation buffer(_rows);
+    size_t counts[256];
+    // LSD: each pass is a stable counting sort by one byte, from the last byte to the first
+    for (ssize_t byte = _key_bytes - 1; byte >= 0; --byte) {
+        memset(counts, 0, sizeof(counts));
+        const uint8_t* bytes = _keys.data() + byte;
+        for (size_t i = 0; i < _rows; ++i) {
+            ++counts[bytes[i * _key_bytes]];
+        }
+        // the pass changes nothing if all rows have the same byte
+        if (counts[bytes[0]] == _rows) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t& count : counts) {
+            size_t next_offset = offset + count;
+            count = offset;
+            offset = next_offset;
+        }
+        for (size_t i = 0; i < _rows; ++i) {
+            size_t row = perm[i];
+            buffer[counts[bytes[row * _key_bytes]]++] = row;
+        }
+        perm.swap(buffer);
+    }
+}
+
+void NormalizedSortKeys::_sort_equal_keys(IColumn::Permutation& perm) const {
+    ColumnsWithSortDescriptions columns = get_columns_with_sort_description(*_block, *_description);
+    EqualKeysLess less {ColumnsWithSortDescriptions(columns.begin() + _num_complete_columns,
+                                                    columns.end())};
+    size_t begin = 0;
+    for (size_t i = 1; i <= _rows; ++i) {
+        if (i < _rows && memcmp(key_at(perm[i]), key_at(perm[begin]), _key_bytes) == 0) {
+            continue;
+        }
+        if (i - begin > 1) {
+            pdqsort(perm.begin() + begin, perm.begin() + i, less);
+        }
+        begin = i;
+    }
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vec/columns/column.h"
+#include "vec/common/pod_array.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_description.h"
+
+namespace doris::vectorized {
+
+// Leading sort columns of a block encoded into a fixed width key per row, so that the
+// memcmp order of the keys is the order of the rows by these columns:
+//  - integers, dates and decimals are stored big endian with the sign bit flipped
+//  - strings store their first STRING_PREFIX_BYTES bytes padded with zeros, which only
+//    orders rows by the prefix, so a string column is always the last encoded column
+//  - nullable columns have a leading byte which puts nulls first or last
+//  - DESC columns have all bytes except the null byte inverted
+// Encoding stops at the first column of other types or when the key is full.
+class NormalizedSortKeys {
+public:
+    static constexpr size_t MAX_KEY_BYTES = 32;
+    static constexpr size_t STRING_PREFIX_BYTES = 8;
+
+    // Returns false if not any leading sort column can be encoded.
+    bool init(const Block& block, const SortDescription& description);
+
+    size_t key_bytes() const { return _key_bytes; }
+
+    // Number of leading sort columns whose order is fully decided by the keys
+    size_t num_complete_columns() const { return _num_complete_columns; }
+
+    const uint8_t* key_at(size_t row) const { return _keys.data() + row * _key_bytes; }
+
+    // Sort rows by their keys with LSD radix sort, rows with equal keys are then sorted by
+    // the sort columns which are not completely encoded.
+    void get_permutation(IColumn::Permutation& perm) const;
+
+private:
+    void _radix_sort(IColumn::Permutation& perm) const;
+
+    void _sort_equal_keys(IColumn::Permutation& perm) const;
+
+    const Block* _block = nullptr;
+    const SortDescription* _description = nullptr;
+    size_t _rows = 0;
+    size_t _key_bytes = 0;
+    size_t _num_complete_columns = 0;
+    PaddedPODArray<uint8_t> _keys;
+};
+
+} // namespace doris::vectorized
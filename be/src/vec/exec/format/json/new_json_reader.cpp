@@ -176,7 +176,7 @@ Status NewJsonReader::init_reader() {
         }
     }
     if (_is_dynamic_schema) {
-        _json_parser = std::make_unique<vectorized::JSONDataParser<vectorized::SimdJSONParser>>();
+        _json_parser = std::make_unique<vectorized::JSONToVariantParser>();
     }
     for (int i = 0; i < _file_slot_descs.size(); ++i) {
         _slot_desc_index[_file_slot_descs[i]->col_name()] = i;
@@ -477,8 +477,7 @@ Status NewJsonReader::_parse_dynamic_json(bool* is_empty_row, bool* eof, Block&
         *is_empty_row = true;
         return Status::OK();
     }
-    Status st = doris::vectorized::parse_json_to_variant(column_object, StringRef {json_str, size},
-                                                         _json_parser.get());
+    Status st = _json_parser->parse(column_object, StringRef {json_str, size});
     if (st.is<DATA_QUALITY_ERROR>()) {
         fmt::memory_buffer error_msg;
         fmt::format_to(error_msg, "Parse json data for JsonDoc failed. error info: {}",
@@ -1098,7 +1097,7 @@ Status NewJsonReader::_simdjson_init_reader() {
         }
     }
     if (_is_dynamic_schema) {
-        _json_parser = std::make_unique<vectorized::JSONDataParser<vectorized::SimdJSONParser>>();
+        _json_parser = std::make_unique<vectorized::JSONToVariantParser>();
     }
     _ondemand_json_parser = std::make_unique<simdjson::ondemand::parser>();
     for (int i = 0; i < _file_slot_descs.size(); ++i) {
@@ -43,6 +43,7 @@
 #include "vec/core/types.h"
 #include "vec/exec/format/generic_reader.h"
 #include "vec/json/json_parser.h"
+#include "vec/json/parse2column.h"
 #include "vec/json/simd_json_parser.h"
 
 namespace simdjson {
@@ -252,7 +253,7 @@ private:
     // array_iter pointed to _array
     simdjson::ondemand::array_iterator _array_iter;
     simdjson::ondemand::array _array;
-    std::unique_ptr<JSONDataParser<SimdJSONParser>> _json_parser;
+    std::unique_ptr<JSONToVariantParser> _json_parser;
     std::unique_ptr<simdjson::ondemand::parser> _ondemand_json_parser = nullptr;
 };
 
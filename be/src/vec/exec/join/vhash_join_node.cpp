@@ -429,6 +429,7 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _build_rows_counter = ADD_COUNTER(_build_phase_profile, "BuildRows", TUnit::UNIT);
     _build_side_compute_hash_timer = ADD_TIMER(_build_phase_profile, "BuildSideHashComputingTime");
     _build_runtime_filter_timer = ADD_TIMER(_build_phase_profile, "BuildRuntimeFilterTime");
+    _build_mem_reservation.init(state->query_mem_reservation(), _build_phase_profile);
 
     // Probe phase
     auto probe_phase_profile = runtime_profile()->create_child("ProbePhase", true, true);
@@ -798,6 +799,82 @@ Status HashJoinNode::_materialize_build_side(RuntimeState* state) {
     return Status::OK();
 }
 
+void HashJoinNode::_check_broadcast_build_size(RuntimeState* state, size_t build_bytes) {
+    auto threshold = config::broadcast_join_build_bytes_threshold;
+    if (threshold <= 0 || build_bytes <= threshold) {
+        return;
+    }
+    _broadcast_build_exceeds_threshold = true;
+    _build_phase_profile->add_info_string(
+            "BroadcastBuildExceedsThreshold",
+            strings::Substitute("build side > $0 bytes, shuffle join may be better", threshold));
+    LOG(WARNING) << "build side of broadcast join exceeds " << threshold
+                 << " bytes, query_id=" << print_id(state->query_id())
+                 << ", fragment_instance_id=" << print_id(state->fragment_instance_id())
+                 << ", node_id=" << id();
+    _share_hash_table_at_runtime(state);
+}
+
+void HashJoinNode::_share_hash_table_at_runtime(RuntimeState* state) {
+    // The probe side is not partitioned, so the distribution can't be changed here. But all
+    // instances of the node on this BE receive the same build side, so the first one over the
+    // threshold or its memory reservation builds the hash table for the others instead of
+    // each building a copy.
+    // The pipeline engine plans builders and consumers of shared hash tables in prepare.
+    // Null aware left anti join may stop building before eos, so the builder wouldn't signal.
+    if (_shared_hashtable_controller != nullptr || state->enable_pipeline_exec() ||
+        _join_op == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN) {
+        return;
+    }
+    auto controller = state->get_query_ctx()->get_shared_hash_table_controller();
+    SharedHashTableContextPtr context;
+    // a consumer stops building here, sink() skips the rest of the build side
+    _should_build_hash_table = controller->share_hash_table_at_runtime(
+            state->fragment_instance_id(), id(), &context);
+    if (context == nullptr) {
+        // the hash table of the node is built already
+        return;
+    }
+    _shared_hashtable_controller = controller;
+    _shared_hash_table_context = context;
+    _hash_table_shared_at_runtime = true;
+    _build_phase_profile->add_info_string("ShareHashTableAtRuntime",
+                                          _should_build_hash_table ? "builder" : "consumer");
+    if (!_should_build_hash_table) {
+        // release the build side received so far, the hash table is taken from the builder
+        _build_side_mutable_block = MutableBlock();
+        _build_blocks->clear();
+        _arena = std::make_shared<Arena>();
+        _hash_table_init(state);
+        _build_mem_reservation.reserve_to(0);
+    }
+}
+
+void HashJoinNode::_reserve_build_side_memory(RuntimeState* state, int64_t incoming_bytes) {
+    // the reservation only grows while building, it covers the blocks and the hash table
+    // built from them so far
+    int64_t build_bytes = _build_side_mem_used + incoming_bytes +
+                          _hash_table_memory_usage->value() + _build_arena_memory_usage->value();
+    if (_build_mem_reservation.reserve_to(
+                std::max(build_bytes, _build_mem_reservation.reserved()))) {
+        return;
+    }
+    if (_is_broadcast_join && !_hash_table_shared_at_runtime) {
+        // all instances of the node on this BE build the same hash table, keep one of them
+        _share_hash_table_at_runtime(state);
+    }
+    if (_hash_table_shared_at_runtime) {
+        // a consumer has dropped its build side, the builder goes on building the only copy
+        // of the hash table on this BE, which the consumers wait for
+        return;
+    }
+    // the build side can not spill, it goes on and leaves the denial in the profile
+    if (!_build_mem_reservation_denied) {
+        _build_mem_reservation_denied = true;
+        _build_phase_profile->add_info_string("BuildSideMemReservation", "denied");
+    }
+}
+
 Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_block, bool eos) {
     SCOPED_TIMER(_build_timer);
 
@@ -809,6 +886,12 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
         DCHECK(state->enable_pipeline_exec());
         return Status::OK();
     }
+    if (_should_build_hash_table && _is_broadcast_join && !_broadcast_build_exceeds_threshold) {
+        _check_broadcast_build_size(state, _build_side_mem_used + in_block->allocated_bytes());
+    }
+    if (_should_build_hash_table) {
+        _reserve_build_side_memory(state, in_block->allocated_bytes());
+    }
     if (_should_build_hash_table) {
         // If eos or have already met a null value using short-circuit strategy, we do not need to pull
         // data from probe side.
@@ -853,6 +936,9 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
             RETURN_IF_ERROR(_process_build_block(state, (*_build_blocks)[_build_block_idx],
                                                  _build_block_idx));
         }
+        // the hash table is allocated already, count it into the reservation so that the other
+        // operators of the query see it
+        _reserve_build_side_memory(state, 0);
         auto ret = std::visit(Overload {[&](std::monostate&) -> Status {
                                             LOG(FATAL) << "FATAL: uninited hash table";
                                             __builtin_unreachable();
@@ -884,7 +970,8 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
             }
             _shared_hashtable_controller->signal(id());
         }
-    } else if (!_should_build_hash_table && (eos || !state->enable_pipeline_exec())) {
+    } else if (!_should_build_hash_table &&
+               (eos || (!state->enable_pipeline_exec() && !_hash_table_shared_at_runtime))) {
         DCHECK(_shared_hashtable_controller != nullptr);
         DCHECK(_shared_hash_table_context != nullptr);
         auto wait_timer = ADD_TIMER(_build_phase_profile, "WaitForSharedHashTableTime");
@@ -927,7 +1014,8 @@ Status HashJoinNode::sink(doris::RuntimeState* state, vectorized::Block* in_bloc
         }
     }
 
-    if (eos || (!_should_build_hash_table && !state->enable_pipeline_exec())) {
+    if (eos || (!_should_build_hash_table && !state->enable_pipeline_exec() &&
+                !_hash_table_shared_at_runtime)) {
         _process_hashtable_ctx_variants_init(state);
     }
 
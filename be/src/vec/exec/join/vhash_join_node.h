@@ -31,6 +31,7 @@
 #include "common/global_types.h"
 #include "common/status.h"
 #include "exprs/runtime_filter_slots.h"
+#include "runtime/memory/mem_reservation.h"
 #include "util/runtime_profile.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/column.h"
@@ -325,6 +326,11 @@ private:
     Sizes _build_key_sz;
 
     bool _is_broadcast_join = false;
+    // build side of the broadcast join is larger than broadcast_join_build_bytes_threshold
+    bool _broadcast_build_exceeds_threshold = false;
+    // the hash table is shared with other instances since the build side is too large,
+    // a consumer drops the build blocks until eos and then waits for the builder
+    bool _hash_table_shared_at_runtime = false;
     bool _should_build_hash_table = true;
     std::shared_ptr<SharedHashTableController> _shared_hashtable_controller = nullptr;
     VRuntimeFilterSlots* _runtime_filter_slots = nullptr;
@@ -342,6 +348,10 @@ private:
 
     SharedHashTableContextPtr _shared_hash_table_context = nullptr;
 
+    // memory of the build side reserved from the query
+    OperatorMemReservation _build_mem_reservation;
+    bool _build_mem_reservation_denied = false;
+
     Status _materialize_build_side(RuntimeState* state) override;
 
     Status _process_build_block(RuntimeState* state, Block& block, uint8_t offset);
@@ -360,6 +370,19 @@ private:
     void _hash_table_init(RuntimeState* state);
     void _process_hashtable_ctx_variants_init(RuntimeState* state);
 
+    // Once the build side of the broadcast join grows over the threshold, record it in the
+    // profile and share the hash table with other instances of the node on this BE.
+    void _check_broadcast_build_size(RuntimeState* state, size_t build_bytes);
+
+    // Build the hash table of the broadcast join for the other instances of the node on this BE,
+    // or take the one built by them.
+    void _share_hash_table_at_runtime(RuntimeState* state);
+
+    // Grow the reservation of the build side by `incoming_bytes`. If the reservation is denied,
+    // a broadcast join shares the hash table with the other instances, otherwise the denial is
+    // recorded in the profile and the build goes on.
+    void _reserve_build_side_memory(RuntimeState* state, int64_t incoming_bytes);
+
     static constexpr auto _MAX_BUILD_BLOCK_COUNT = 128;
 
     void _prepare_probe_block();
@@ -179,6 +179,9 @@ Status NewOlapScanNode::_init_profile() {
 
     _output_index_result_column_timer = ADD_TIMER(_segment_profile, "OutputIndexResultColumnTimer");
 
+    _result_cache_hit_counter = ADD_COUNTER(_scanner_profile, "ResultCacheHit", TUnit::UNIT);
+    _result_cache_miss_counter = ADD_COUNTER(_scanner_profile, "ResultCacheMiss", TUnit::UNIT);
+
     _filtered_segment_counter = ADD_COUNTER(_segment_profile, "NumSegmentFiltered", TUnit::UNIT);
     _total_segment_counter = ADD_COUNTER(_segment_profile, "NumSegmentTotal", TUnit::UNIT);
 
@@ -84,6 +84,8 @@ protected:
 
     PushDownType _should_push_down_is_null_predicate() override { return PushDownType::ACCEPTABLE; }
 
+    bool _should_push_down_late_arrival_runtime_filter() override { return true; }
+
     bool _should_push_down_common_expr() override;
 
     Status _init_scanners(std::list<VScannerSPtr>* scanners) override;
@@ -178,6 +180,10 @@ private:
 
     RuntimeProfile::Counter* _output_index_result_column_timer = nullptr;
 
+    // number of scanners which find or do not find their output in the intermediate result cache
+    RuntimeProfile::Counter* _result_cache_hit_counter = nullptr;
+    RuntimeProfile::Counter* _result_cache_miss_counter = nullptr;
+
     // number of created olap scanners
     RuntimeProfile::Counter* _num_scanners = nullptr;
 
@@ -192,6 +192,18 @@ Status NewOlapScanner::init() {
         }
     }
 
+    _use_result_cache = _can_use_result_cache();
+    _cache_result_by_rowset = _use_result_cache && _can_cache_result_by_rowset();
+    // With pre-aggregation the aggregation above merges the rows of an aggregate key table,
+    // so the rows of a rowset can be merged by the storage before being cached. The cache holds
+    // the storage merged rows of the rowset in the storage format, not serialized states of the
+    // query's aggregate functions, and the aggregation above merges them with the rows of the
+    // other rowsets. The GROUP BY of the query is evaluated above the scan, so only the storage
+    // keys are used here.
+    _aggregate_rowset = _cache_result_by_rowset && _aggregation &&
+                        _tablet_schema->keys_type() == KeysType::AGG_KEYS &&
+                        !parent->_olap_scan_node.__isset.push_down_agg_type_opt;
+
     // add read columns in profile
     if (_state->enable_profile()) {
         _profile->add_info_string("ReadColumns",
@@ -204,6 +216,11 @@ Status NewOlapScanner::init() {
 Status NewOlapScanner::open(RuntimeState* state) {
     RETURN_IF_ERROR(VScanner::open(state));
 
+    if (_use_result_cache && _lookup_result_cache()) {
+        // all output is replayed from the cache, or the rowsets which are not cached are read
+        return _rs_readers_to_read.empty() ? Status::OK() : _open_reader_for_next_rowset();
+    }
+
     auto res = _tablet_reader->init(_tablet_reader_params);
     if (!res.ok()) {
         std::stringstream ss;
@@ -212,10 +229,139 @@ Status NewOlapScanner::open(RuntimeState* state) {
            << ", backend=" << BackendOptions::get_localhost();
         return Status::InternalError(ss.str());
     }
+    _tablet_reader_opened = true;
 
+    // runtime filters may arrive between the scan node normalizing conjuncts and now
+    return _push_down_late_arrival_filters();
+}
+
+Status NewOlapScanner::_push_down_late_arrival_filters() {
+    if (_tablet_reader == nullptr || _tablet_reader_params.reader_type != READER_QUERY) {
+        return Status::OK();
+    }
+    auto filter_predicates = _parent->late_arrival_filter_predicates();
+    if (filter_predicates.bloom_filters.size() == _late_arrival_bloom_filter_num &&
+        filter_predicates.in_filters.size() == _late_arrival_in_filter_num) {
+        return Status::OK();
+    }
+    decltype(filter_predicates.bloom_filters) bloom_filters(
+            filter_predicates.bloom_filters.begin() + _late_arrival_bloom_filter_num,
+            filter_predicates.bloom_filters.end());
+    decltype(filter_predicates.in_filters) in_filters(
+            filter_predicates.in_filters.begin() + _late_arrival_in_filter_num,
+            filter_predicates.in_filters.end());
+    _late_arrival_bloom_filter_num = filter_predicates.bloom_filters.size();
+    _late_arrival_in_filter_num = filter_predicates.in_filters.size();
+    _tablet_reader->append_late_arrival_filters(bloom_filters, in_filters);
     return Status::OK();
 }
 
+bool NewOlapScanner::_lookup_result_cache() {
+    auto parent = static_cast<NewOlapScanNode*>(_parent);
+    const int64_t digest = parent->_olap_scan_node.result_cache_digest;
+    _result_cache_ctx = std::make_unique<ResultCacheScanContext>(
+            IntermediateResultCache::instance(), config::intermediate_result_cache_max_entry_bytes);
+    if (_cache_result_by_rowset) {
+        // only the rowsets which are not cached are read, one by one
+        for (const auto& rs_reader : _tablet_reader_params.rs_readers) {
+            if (_result_cache_ctx->lookup(IntermediateResultCache::RowsetKey(
+                        digest, rs_reader->rowset()->rowset_id()))) {
+                COUNTER_UPDATE(parent->_result_cache_hit_counter, 1);
+            } else {
+                COUNTER_UPDATE(parent->_result_cache_miss_counter, 1);
+                _rs_readers_to_read.push_back(rs_reader);
+            }
+        }
+        return true;
+    }
+
+    if (_result_cache_ctx->lookup(
+                IntermediateResultCache::Key(digest, _tablet->tablet_id(), _version))) {
+        // the tablet reader is not needed to replay the cached output
+        COUNTER_UPDATE(parent->_result_cache_hit_counter, 1);
+        return true;
+    }
+    COUNTER_UPDATE(parent->_result_cache_miss_counter, 1);
+    _result_cache_ctx->begin_entry();
+    return false;
+}
+
+bool NewOlapScanner::_can_use_result_cache() const {
+    auto parent = static_cast<NewOlapScanNode*>(_parent);
+    if (IntermediateResultCache::instance() == nullptr ||
+        !parent->_olap_scan_node.__isset.result_cache_digest) {
+        return false;
+    }
+    // runtime filters, limits and row ids make the output differ between queries with the
+    // same plan, and the scanner must read all key ranges and segments of the tablet
+    return parent->_runtime_filter_descs.empty() && _limit <= 0 &&
+           !_tablet_reader_params.use_topn_opt && !_state->skip_storage_engine_merge() &&
+           !_state->skip_delete_predicate() && !_state->skip_delete_bitmap() &&
+           _tablet_reader_params.rs_readers_segment_offsets.empty() &&
+           _key_ranges.size() == parent->_cond_ranges.size() &&
+           _output_tuple_desc->slots().back()->col_name() != BeConsts::ROWID_COL;
+}
+
+bool NewOlapScanner::_can_cache_result_by_rowset() const {
+    // the output on a tablet is the concatenation of the output on its rowsets only if the
+    // rowsets are not merged, and the rows of a rowset are not deleted by later versions
+    return _tablet_reader_params.direct_mode && _tablet_reader_params.delete_predicates.empty() &&
+           _tablet_reader_params.delete_bitmap == nullptr;
+}
+
+Status NewOlapScanner::_open_reader_for_next_rowset() {
+    // keep the statistics of the previous rowsets for the profile
+    OlapReaderStatistics stats = _tablet_reader->stats();
+    int batch_size = _tablet_reader->batch_size();
+    // the reader refers to the params, so it must be released before they are changed
+    _tablet_reader.reset();
+    _reading_rs_reader = std::move(_rs_readers_to_read.front());
+    _rs_readers_to_read.pop_front();
+    _rowset_reader_params = _tablet_reader_params;
+    _rowset_reader_params.rs_readers = {_reading_rs_reader};
+    if (_aggregate_rowset) {
+        // merge the rows of the rowset with the same keys, the rows are read in the order of
+        // the keys so that all of them are merged
+        _rowset_reader_params.direct_mode = false;
+        _rowset_reader_params.aggregation = false;
+        _rowset_reader_params.return_columns.clear();
+        _init_reader_return_columns(&_rowset_reader_params);
+    }
+
+    _tablet_reader = std::make_unique<BlockReader>();
+    _tablet_reader->set_batch_size(batch_size);
+    *_tablet_reader->mutable_stats() = stats;
+    auto res = _tablet_reader->init(_rowset_reader_params);
+    if (!res.ok()) {
+        std::stringstream ss;
+        ss << "failed to initialize storage reader. tablet=" << _tablet->full_name()
+           << ", rowset=" << _reading_rs_reader->rowset()->rowset_id() << ", res=" << res
+           << ", backend=" << BackendOptions::get_localhost();
+        return Status::InternalError(ss.str());
+    }
+    _tablet_reader_opened = true;
+    _result_cache_ctx->begin_entry();
+    return Status::OK();
+}
+
+void NewOlapScanner::_cache_result_block(const Block& block, bool eof) {
+    // the conjuncts which are not pushed down are evaluated on the replayed blocks again,
+    // so the blocks are cached before being filtered by them
+    _result_cache_ctx->add_block(block);
+    if (!eof) {
+        return;
+    }
+    auto parent = static_cast<NewOlapScanNode*>(_parent);
+    const int64_t digest = parent->_olap_scan_node.result_cache_digest;
+    if (_reading_rs_reader != nullptr) {
+        _result_cache_ctx->finish_entry(IntermediateResultCache::RowsetKey(
+                digest, _reading_rs_reader->rowset()->rowset_id()));
+    } else {
+        _result_cache_ctx->finish_entry(
+                IntermediateResultCache::Key(digest, _tablet->tablet_id(), _version));
+    }
+}
+
 void NewOlapScanner::set_compound_filters(const std::vector<TCondition>& compound_filters) {
     _compound_filters = compound_filters;
 }
@@ -342,37 +488,7 @@ Status NewOlapScanner::_init_tablet_reader_params(
     _tablet_reader_params.origin_return_columns = &_return_columns;
     _tablet_reader_params.tablet_columns_convert_to_null_set = &_tablet_columns_convert_to_null_set;
 
-    if (_tablet_reader_params.direct_mode) {
-        _tablet_reader_params.return_columns = _return_columns;
-    } else {
-        // we need to fetch all key columns to do the right aggregation on storage engine side.
-        for (size_t i = 0; i < _tablet_schema->num_key_columns(); ++i) {
-            _tablet_reader_params.return_columns.push_back(i);
-        }
-        for (auto index : _return_columns) {
-            if (_tablet_schema->column(index).is_key()) {
-                continue;
-            } else {
-                _tablet_reader_params.return_columns.push_back(index);
-            }
-        }
-        // expand the sequence column
-        if (_tablet_schema->has_sequence_col()) {
-            bool has_replace_col = false;
-            for (auto col : _return_columns) {
-                if (_tablet_schema->column(col).aggregation() ==
-                    FieldAggregationMethod::OLAP_FIELD_AGGREGATION_REPLACE) {
-                    has_replace_col = true;
-                    break;
-                }
-            }
-            if (auto sequence_col_idx = _tablet_schema->sequence_col_idx();
-                has_replace_col && std::find(_return_columns.begin(), _return_columns.end(),
-                                             sequence_col_idx) == _return_columns.end()) {
-                _tablet_reader_params.return_columns.push_back(sequence_col_idx);
-            }
-        }
-    }
+    _init_reader_return_columns(&_tablet_reader_params);
 
     // If a agg node is this scan node direct parent
     // we will not call agg object finalize method in scan node,
@@ -411,6 +527,40 @@ Status NewOlapScanner::_init_tablet_reader_params(
     return Status::OK();
 }
 
+void NewOlapScanner::_init_reader_return_columns(TabletReader::ReaderParams* reader_params) {
+    if (reader_params->direct_mode) {
+        reader_params->return_columns = _return_columns;
+    } else {
+        // we need to fetch all key columns to do the right aggregation on storage engine side.
+        for (size_t i = 0; i < _tablet_schema->num_key_columns(); ++i) {
+            reader_params->return_columns.push_back(i);
+        }
+        for (auto index : _return_columns) {
+            if (_tablet_schema->column(index).is_key()) {
+                continue;
+            } else {
+                reader_params->return_columns.push_back(index);
+            }
+        }
+        // expand the sequence column
+        if (_tablet_schema->has_sequence_col()) {
+            bool has_replace_col = false;
+            for (auto col : _return_columns) {
+                if (_tablet_schema->column(col).aggregation() ==
+                    FieldAggregationMethod::OLAP_FIELD_AGGREGATION_REPLACE) {
+                    has_replace_col = true;
+                    break;
+                }
+            }
+            if (auto sequence_col_idx = _tablet_schema->sequence_col_idx();
+                has_replace_col && std::find(_return_columns.begin(), _return_columns.end(),
+                                             sequence_col_idx) == _return_columns.end()) {
+                reader_params->return_columns.push_back(sequence_col_idx);
+            }
+        }
+    }
+}
+
 Status NewOlapScanner::_init_return_columns() {
     for (auto slot : _output_tuple_desc->slots()) {
         if (!slot->is_materialized()) {
@@ -460,14 +610,32 @@ Status NewOlapScanner::_get_block_impl(RuntimeState* state, Block* block, bool*
     // Read one block from block reader
     // ATTN: Here we need to let the _get_block_impl method guarantee the semantics of the interface,
     // that is, eof can be set to true only when the returned block is empty.
-    RETURN_IF_ERROR(_tablet_reader->next_block_with_aggregation(block, eof));
-    if (!_profile_updated) {
-        _profile_updated = _tablet_reader->update_profile(_profile);
-    }
-    if (block->rows() > 0) {
+    if (_result_cache_ctx != nullptr && _result_cache_ctx->next_cached_block(block)) {
         *eof = false;
+        return Status::OK();
+    }
+    if (!_tablet_reader_opened) {
+        // all output is replayed from the intermediate result cache
+        *eof = true;
+        return Status::OK();
+    }
+    while (true) {
+        RETURN_IF_ERROR(_tablet_reader->next_block_with_aggregation(block, eof));
+        if (!_profile_updated) {
+            _profile_updated = _tablet_reader->update_profile(_profile);
+        }
+        if (block->rows() > 0) {
+            *eof = false;
+        }
+        _update_realtime_counters();
+        if (_result_cache_ctx != nullptr && _result_cache_ctx->copying()) {
+            _cache_result_block(*block, *eof);
+        }
+        if (!*eof || _rs_readers_to_read.empty()) {
+            break;
+        }
+        RETURN_IF_ERROR(_open_reader_for_next_rowset());
     }
-    _update_realtime_counters();
     return Status::OK();
 }
 
@@ -483,6 +651,10 @@ Status NewOlapScanner::close(RuntimeState* state) {
     // deconstructor in reader references runtime state
     // so that it will core
     _tablet_reader_params.rs_readers.clear();
+    _rowset_reader_params.rs_readers.clear();
+    _rs_readers_to_read.clear();
+    _reading_rs_reader.reset();
+    _result_cache_ctx.reset();
     _tablet_reader.reset();
 
     RETURN_IF_ERROR(VScanner::close(state));
@@ -20,6 +20,7 @@
 #include <gen_cpp/PaloInternalService_types.h>
 #include <stdint.h>
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -33,6 +34,7 @@
 #include "olap/rowset/rowset_reader.h"
 #include "olap/tablet.h"
 #include "olap/tablet_schema.h"
+#include "runtime/cache/intermediate_result_cache.h"
 #include "vec/exec/scan/vscanner.h"
 
 namespace doris {
@@ -74,6 +76,7 @@ public:
 protected:
     Status _get_block_impl(RuntimeState* state, Block* block, bool* eos) override;
     void _update_counters_before_close() override;
+    Status _push_down_late_arrival_filters() override;
 
 private:
     void _update_realtime_counters();
@@ -84,6 +87,16 @@ private:
                                       const std::vector<FunctionFilter>& function_filters);
 
     Status _init_return_columns();
+    // the columns read by the tablet reader, all key columns are read if rows are aggregated
+    void _init_reader_return_columns(TabletReader::ReaderParams* reader_params);
+
+    bool _can_use_result_cache() const;
+    bool _can_cache_result_by_rowset() const;
+    // Look up the output in the intermediate result cache, returns false if the whole tablet
+    // must be read by the tablet reader.
+    bool _lookup_result_cache();
+    Status _open_reader_for_next_rowset();
+    void _cache_result_block(const Block& block, bool eof);
 
     bool _aggregation;
     bool _need_agg_finalize;
@@ -96,11 +109,30 @@ private:
 
     TabletReader::ReaderParams _tablet_reader_params;
     std::unique_ptr<TabletReader> _tablet_reader;
+    // num of late arrival filters of scan node which are pushed down to _tablet_reader
+    size_t _late_arrival_bloom_filter_num = 0;
+    size_t _late_arrival_in_filter_num = 0;
 
     std::vector<uint32_t> _return_columns;
     std::unordered_set<uint32_t> _tablet_columns_convert_to_null_set;
     std::vector<TCondition> _compound_filters;
 
+    // ========= intermediate result cache ==========
+    // whether the output of the scanner only depends on the plan, the tablet and the version
+    bool _use_result_cache = false;
+    // whether the output is cached per rowset instead of per tablet version
+    bool _cache_result_by_rowset = false;
+    // whether the rows of each rowset are merged by the storage keys before being cached, so
+    // that the cache holds the storage merged rows of the rowset
+    bool _aggregate_rowset = false;
+    std::unique_ptr<ResultCacheScanContext> _result_cache_ctx;
+    // false if all output is replayed from the cache
+    bool _tablet_reader_opened = false;
+    // the rowsets which are not cached, each of them is read by its own tablet reader
+    std::deque<RowsetReaderSharedPtr> _rs_readers_to_read;
+    RowsetReaderSharedPtr _reading_rs_reader;
+    TabletReader::ReaderParams _rowset_reader_params;
+
     // ========= profiles ==========
     int64_t _compressed_bytes_read = 0;
     int64_t _raw_rows_read = 0;
@@ -61,6 +61,7 @@ public:
             }
         }
         _current_used_bytes -= (*block)->allocated_bytes();
+        _reserve_queued_bytes(false);
         return Status::OK();
     }
 
@@ -121,6 +122,7 @@ public:
             }
         }
         _current_used_bytes += local_bytes;
+        _reserve_queued_bytes(true);
     }
 
     bool empty_in_queue(int id) override {
@@ -170,6 +172,19 @@ public:
     }
 
 private:
+    // Reserve the memory of the blocks in the queues like ScannerContext does, a denied
+    // reservation only reduces the concurrency of the scanners.
+    void _reserve_queued_bytes(bool growing) {
+        if (!_mem_reservation.enabled()) {
+            return;
+        }
+        std::lock_guard l(_transfer_lock);
+        bool granted = _mem_reservation.reserve_to(_current_used_bytes);
+        if (growing) {
+            _mem_reservation_denied = !granted;
+        }
+    }
+
     int _max_queue_size = 1;
     int _next_queue_to_feed = 0;
     std::vector<std::unique_ptr<std::mutex>> _queue_mutexs;
@@ -85,6 +85,7 @@ Status ScannerContext::init() {
     _newly_create_free_blocks_num = _parent->_newly_create_free_blocks_num;
     _queued_blocks_memory_usage = _parent->_queued_blocks_memory_usage;
     _scanner_wait_batch_timer = _parent->_scanner_wait_batch_timer;
+    _mem_reservation.init(_state->query_mem_reservation(), _scanner_profile.get());
     // 2. Calculate how many blocks need to be preallocated.
     // The calculation logic is as follows:
     //  1. Assuming that at most M rows can be scanned in one scan(config::doris_scanner_row_num),
@@ -164,6 +165,8 @@ void ScannerContext::append_blocks_to_queue(std::vector<vectorized::BlockUPtr>&
         _blocks_queue.push_back(std::move(b));
     }
     blocks.clear();
+    // The blocks are queued anyway, a denied reservation only reduces the concurrency.
+    _mem_reservation_denied = !_mem_reservation.reserve_to(_cur_bytes_in_queue);
     _blocks_queue_added_cv.notify_one();
     _queued_blocks_memory_usage->add(_cur_bytes_in_queue - old_bytes_in_queue);
 }
@@ -209,6 +212,7 @@ Status ScannerContext::get_block_from_queue(RuntimeState* state, vectorized::Blo
         auto block_bytes = (*block)->allocated_bytes();
         _cur_bytes_in_queue -= block_bytes;
         _queued_blocks_memory_usage->add(-block_bytes);
+        _mem_reservation.reserve_to(_cur_bytes_in_queue);
         return Status::OK();
     } else {
         *eos = _is_finished;
@@ -287,6 +291,7 @@ void ScannerContext::clear_and_join(VScanNode* node, RuntimeState* state) {
     _close_and_clear_scanners(node, state);
 
     _blocks_queue.clear();
+    _mem_reservation.reserve_to(0);
 }
 
 bool ScannerContext::no_schedule() {
@@ -354,7 +359,7 @@ void ScannerContext::get_next_batch_of_scanners(std::list<VScannerSPtr>* current
         thread_slot_num = _free_blocks.size() / _block_per_scanner;
         thread_slot_num += (_free_blocks.size() % _block_per_scanner != 0);
         thread_slot_num = std::min(thread_slot_num, _max_thread_num - _num_running_scanners);
-        if (thread_slot_num <= 0) {
+        if (thread_slot_num <= 0 || _mem_reservation_denied) {
             thread_slot_num = 1;
         }
     }
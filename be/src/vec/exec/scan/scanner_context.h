@@ -29,6 +29,7 @@
 
 #include "common/factory_creator.h"
 #include "common/status.h"
+#include "runtime/memory/mem_reservation.h"
 #include "util/lock.h"
 #include "util/runtime_profile.h"
 #include "vec/core/block.h"
@@ -221,6 +222,11 @@ protected:
     int64_t _cur_bytes_in_queue = 0;
     // The max limit bytes of blocks in blocks queue
     int64_t _max_bytes_in_queue;
+    // Memory reserved for the blocks in blocks queue, use _transfer_lock to protect it.
+    // If the reservation is denied, only one scanner is scheduled at a time until
+    // a later reservation is granted.
+    OperatorMemReservation _mem_reservation;
+    std::atomic_bool _mem_reservation_denied = false;
 
     doris::vectorized::ScannerScheduler* _scanner_scheduler;
     // List "scanners" saves all "unfinished" scanners.
@@ -1331,8 +1331,14 @@ Status VScanNode::try_append_late_arrival_runtime_filter(int* arrived_rf_num) {
             ++current_arrived_rf_num;
             continue;
         } else if (_runtime_filter_ctxs[i].runtime_filter->is_ready()) {
+            size_t pre_size = vexprs.size();
             _runtime_filter_ctxs[i].runtime_filter->get_prepared_vexprs(&vexprs, _row_descriptor,
                                                                         _state);
+            if (_should_push_down_late_arrival_runtime_filter()) {
+                for (size_t j = pre_size; j < vexprs.size(); ++j) {
+                    _push_down_late_arrival_runtime_filter(vexprs[j]);
+                }
+            }
             ++current_arrived_rf_num;
             _runtime_filter_ctxs[i].apply_mark = true;
         }
@@ -1349,6 +1355,37 @@ Status VScanNode::try_append_late_arrival_runtime_filter(int* arrived_rf_num) {
     return Status::OK();
 }
 
+void VScanNode::_push_down_late_arrival_runtime_filter(VExpr* rf_expr) {
+    auto* expr = const_cast<VExpr*>(rf_expr->get_impl());
+    if (expr == nullptr || expr->children().empty() ||
+        expr->children()[0]->node_type() != TExprNodeType::SLOT_REF) {
+        return;
+    }
+    auto* slot_ref = reinterpret_cast<const VSlotRef*>(expr->children()[0]);
+    auto entry = _slot_id_to_value_range.find(slot_ref->slot_id());
+    if (entry == _slot_id_to_value_range.end()) {
+        return;
+    }
+    // same as runtime filters arrived in time, only filters on key column can be used
+    // to prune data in storage
+    SlotDescriptor* slot = entry->second.first;
+    if (!_is_key_column(slot->col_name())) {
+        return;
+    }
+    if (TExprNodeType::BLOOM_PRED == expr->node_type()) {
+        _late_arrival_filter_predicates.bloom_filters.emplace_back(slot->col_name(),
+                                                                   expr->get_bloom_filter_func());
+    } else if (TExprNodeType::IN_PRED == expr->node_type() && expr->get_set_func() != nullptr) {
+        _late_arrival_filter_predicates.in_filters.emplace_back(slot->col_name(),
+                                                                expr->get_set_func());
+    }
+}
+
+FilterPredicates VScanNode::late_arrival_filter_predicates() {
+    std::unique_lock l(_rf_locks);
+    return _late_arrival_filter_predicates;
+}
+
 Status VScanNode::clone_vconjunct_ctx(VExprContext** _vconjunct_ctx) {
     if (_vconjunct_ctx_ptr) {
         std::unique_lock l(_rf_locks);
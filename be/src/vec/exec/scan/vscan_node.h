@@ -144,6 +144,10 @@ public:
     // Return num of filters which are applied already.
     Status try_append_late_arrival_runtime_filter(int* arrived_rf_num);
 
+    // Get filters of late arrived runtime filters which can be pushed down to storage.
+    // Filters are only appended, so scanners can skip the ones they have applied.
+    FilterPredicates late_arrival_filter_predicates();
+
     // Clone current vconjunct_ctx to _vconjunct_ctx, if exists.
     Status clone_vconjunct_ctx(VExprContext** _vconjunct_ctx);
 
@@ -230,6 +234,10 @@ protected:
 
     virtual PushDownType _should_push_down_bitmap_filter() { return PushDownType::UNACCEPTABLE; }
 
+    // Return true if runtime filters which arrive after scanners started can still be
+    // pushed down to the storage layer to prune data.
+    virtual bool _should_push_down_late_arrival_runtime_filter() { return false; }
+
     virtual PushDownType _should_push_down_is_null_predicate() {
         return PushDownType::UNACCEPTABLE;
     }
@@ -282,6 +290,9 @@ protected:
     bool _opened = false;
 
     FilterPredicates _filter_predicates {};
+    // Runtime filters arrived after scanners started, which will be pushed down to the
+    // storage layer of running scanners. Protected by _rf_locks.
+    FilterPredicates _late_arrival_filter_predicates {};
 
     // Save all function predicates which may be pushed down to data source.
     std::vector<FunctionFilter> _push_down_functions;
@@ -381,6 +392,8 @@ private:
     Status _normalize_predicate(VExpr* conjunct_expr_root, VExpr** output_expr);
     Status _eval_const_conjuncts(VExpr* vexpr, VExprContext* expr_ctx, PushDownType* pdt);
 
+    void _push_down_late_arrival_runtime_filter(VExpr* rf_expr);
+
     Status _normalize_bloom_filter(VExpr* expr, VExprContext* expr_ctx, SlotDescriptor* slot,
                                    PushDownType* pdt);
 
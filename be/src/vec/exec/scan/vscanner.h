@@ -76,6 +76,10 @@ protected:
     // Filter the output block finally.
     Status _filter_output_block(Block* block);
 
+    // Push late arrived runtime filters down to the data source, if it can use them
+    // to skip data which is not read yet.
+    virtual Status _push_down_late_arrival_filters() { return Status::OK(); }
+
     // Not virtual, all child will call this method explictly
     Status prepare(RuntimeState* state, VExprContext* vconjunct_ctx_ptr);
 
@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/streaming_preagg_pass_through.h"
+
+#include <algorithm>
+
+namespace doris::vectorized {
+
+int streaming_ht_cache_level(size_t ht_mem) {
+    int cache_level = 0;
+    while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
+           ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
+        ++cache_level;
+    }
+    return cache_level;
+}
+
+bool StreamingPreaggPassThrough::should_pass_through(size_t rows) {
+    if (!_pass_through) {
+        return false;
+    }
+    if (_pass_through_rows_left > 0) {
+        _pass_through_rows_left -= rows;
+        return true;
+    }
+    // Probe back: aggregate the next sample to check whether the reduction has improved.
+    _pass_through = false;
+    ++_probe_back_count;
+    return false;
+}
+
+bool StreamingPreaggPassThrough::update(size_t input_rows, size_t new_groups, int64_t probe_ns,
+                                        size_t ht_mem) {
+    _window_input_rows += input_rows;
+    _window_new_groups += new_groups;
+    _window_probe_ns += probe_ns;
+    if (_window_input_rows < SAMPLE_ROWS) {
+        return false;
+    }
+
+    _reduction = static_cast<double>(_window_input_rows) / std::max<int64_t>(_window_new_groups, 1);
+    _probe_ns_per_row = static_cast<double>(_window_probe_ns) / _window_input_rows;
+    _window_input_rows = 0;
+    _window_new_groups = 0;
+    _window_probe_ns = 0;
+
+    int cache_level = streaming_ht_cache_level(ht_mem);
+    if (_baseline_probe_ns_per_row == 0) {
+        _baseline_probe_ns_per_row = _probe_ns_per_row;
+    } else if (_probe_ns_per_row > _baseline_probe_ns_per_row * PROBE_COST_FACTOR &&
+               cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE) {
+        ++cache_level;
+    }
+
+    if (_reduction > STREAMING_HT_MIN_REDUCTION[cache_level].streaming_ht_min_reduction) {
+        _pass_through_interval = 0;
+        return true;
+    }
+
+    _pass_through_interval = _pass_through_interval == 0
+                                     ? MIN_PASS_THROUGH_ROWS
+                                     : std::min(_pass_through_interval * 2, MAX_PASS_THROUGH_ROWS);
+    _pass_through_rows_left = _pass_through_interval;
+    _pass_through = true;
+    ++_switch_count;
+    return true;
+}
+
+} // namespace doris::vectorized
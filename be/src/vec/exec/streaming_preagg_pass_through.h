@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace doris::vectorized {
+
+/// The minimum reduction factor (input rows divided by output rows) to grow hash tables
+/// in a streaming preaggregation, given that the hash tables are currently the given
+/// size or above. The sizes roughly correspond to hash table sizes where the bucket
+/// arrays will fit in  a cache level. Intuitively, we don't want the working set of the
+/// aggregation to expand to the next level of cache unless we're reducing the input
+/// enough to outweigh the increased memory latency we'll incur for each hash table
+/// lookup.
+///
+/// Note that the current reduction achieved is not always a good estimate of the
+/// final reduction. It may be biased either way depending on the ordering of the
+/// input. If the input order is random, we will underestimate the final reduction
+/// factor because the probability of a row having the same key as a previous row
+/// increases as more input is processed.  If the input order is correlated with the
+/// key, skew may bias the estimate. If high cardinality keys appear first, we
+/// may overestimate and if low cardinality keys appear first, we underestimate.
+/// To estimate the eventual reduction achieved, we estimate the final reduction
+/// using the planner's estimated input cardinality and the assumption that input
+/// is in a random order. This means that we assume that the reduction factor will
+/// increase over time.
+struct StreamingHtMinReductionEntry {
+    // Use 'streaming_ht_min_reduction' if the total size of hash table bucket directories in
+    // bytes is greater than this threshold.
+    int min_ht_mem;
+    // The minimum reduction factor to expand the hash tables.
+    double streaming_ht_min_reduction;
+};
+
+// TODO: experimentally tune these values and also programmatically get the cache size
+// of the machine that we're running on.
+static constexpr StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
+        // Expand up to L2 cache always.
+        {0, 0.0},
+        // Expand into L3 cache if we look like we're getting some reduction.
+        // At present, The L2 cache is generally 1024k or more
+        {1024 * 1024, 1.1},
+        // Expand into main memory if we're getting a significant reduction.
+        // The L3 cache is generally 16MB or more
+        {16 * 1024 * 1024, 2.0},
+};
+
+static constexpr int STREAMING_HT_MIN_REDUCTION_SIZE =
+        sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
+
+// Index of the entry of STREAMING_HT_MIN_REDUCTION for a hash table of ht_mem bytes.
+int streaming_ht_cache_level(size_t ht_mem);
+
+/// Decides whether the streaming preaggregation passes rows through without aggregation.
+///
+/// The reduction achieved is re-evaluated after every SAMPLE_ROWS rows inserted into the hash
+/// table. When the reduction does not justify the cost of the lookups, the following rows are
+/// passed through. After MIN_PASS_THROUGH_ROWS rows the hash table is probed again with a new
+/// sample, and the interval doubles each time the probe confirms the decision, up to
+/// MAX_PASS_THROUGH_ROWS.
+class StreamingPreaggPassThrough {
+public:
+    static constexpr int64_t SAMPLE_ROWS = 64 * 1024;
+    static constexpr int64_t MIN_PASS_THROUGH_ROWS = 1024 * 1024;
+    static constexpr int64_t MAX_PASS_THROUGH_ROWS = 64 * 1024 * 1024;
+    /// If the lookup cost per row grows beyond this factor of the cost measured while the hash
+    /// table was small, most lookups miss the cache, so the reduction required to keep
+    /// aggregating is taken from the next level of STREAMING_HT_MIN_REDUCTION.
+    static constexpr double PROBE_COST_FACTOR = 2.0;
+
+    // Returns true if the next `rows` input rows should be passed through. Once the interval
+    // is used up it returns false, so that the next sample is aggregated again.
+    bool should_pass_through(size_t rows);
+
+    // Records `input_rows` rows inserted into a hash table of `ht_mem` bytes, which added
+    // `new_groups` groups in `probe_ns`. Returns true if this completed a sample, the
+    // reduction and lookup cost of it are returned by reduction() and probe_ns_per_row().
+    bool update(size_t input_rows, size_t new_groups, int64_t probe_ns, size_t ht_mem);
+
+    bool is_passing_through() const { return _pass_through; }
+    int64_t pass_through_interval() const { return _pass_through_interval; }
+    int64_t switch_count() const { return _switch_count; }
+    int64_t probe_back_count() const { return _probe_back_count; }
+    double reduction() const { return _reduction; }
+    double probe_ns_per_row() const { return _probe_ns_per_row; }
+
+private:
+    bool _pass_through = false;
+    int64_t _pass_through_rows_left = 0;
+    int64_t _pass_through_interval = 0;
+
+    int64_t _window_input_rows = 0;
+    int64_t _window_new_groups = 0;
+    int64_t _window_probe_ns = 0;
+    double _baseline_probe_ns_per_row = 0;
+
+    double _reduction = 0;
+    double _probe_ns_per_row = 0;
+    int64_t _switch_count = 0;
+    int64_t _probe_back_count = 0;
+};
+
+} // namespace doris::vectorized
@@ -30,10 +30,12 @@
 #include "runtime/block_spill_manager.h"
 #include "runtime/define_primitive_type.h"
 #include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
 #include "runtime/memory/mem_tracker.h"
 #include "runtime/runtime_state.h"
 #include "runtime/thread_context.h"
 #include "util/telemetry/telemetry.h"
+#include "util/threadpool.h"
 #include "vec/common/hash_table/hash_table_key_holder.h"
 #include "vec/common/hash_table/hash_table_utils.h"
 #include "vec/common/hash_table/string_hash_table.h"
@@ -56,49 +58,6 @@ namespace doris::vectorized {
 // Here is an empirical value.
 static constexpr size_t HASH_MAP_PREFETCH_DIST = 16;
 
-/// The minimum reduction factor (input rows divided by output rows) to grow hash tables
-/// in a streaming preaggregation, given that the hash tables are currently the given
-/// size or above. The sizes roughly correspond to hash table sizes where the bucket
-/// arrays will fit in  a cache level. Intuitively, we don't want the working set of the
-/// aggregation to expand to the next level of cache unless we're reducing the input
-/// enough to outweigh the increased memory latency we'll incur for each hash table
-/// lookup.
-///
-/// Note that the current reduction achieved is not always a good estimate of the
-/// final reduction. It may be biased either way depending on the ordering of the
-/// input. If the input order is random, we will underestimate the final reduction
-/// factor because the probability of a row having the same key as a previous row
-/// increases as more input is processed.  If the input order is correlated with the
-/// key, skew may bias the estimate. If high cardinality keys appear first, we
-/// may overestimate and if low cardinality keys appear first, we underestimate.
-/// To estimate the eventual reduction achieved, we estimate the final reduction
-/// using the planner's estimated input cardinality and the assumption that input
-/// is in a random order. This means that we assume that the reduction factor will
-/// increase over time.
-struct StreamingHtMinReductionEntry {
-    // Use 'streaming_ht_min_reduction' if the total size of hash table bucket directories in
-    // bytes is greater than this threshold.
-    int min_ht_mem;
-    // The minimum reduction factor to expand the hash tables.
-    double streaming_ht_min_reduction;
-};
-
-// TODO: experimentally tune these values and also programmatically get the cache size
-// of the machine that we're running on.
-static constexpr StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
-        // Expand up to L2 cache always.
-        {0, 0.0},
-        // Expand into L3 cache if we look like we're getting some reduction.
-        // At present, The L2 cache is generally 1024k or more
-        {1024 * 1024, 1.1},
-        // Expand into main memory if we're getting a significant reduction.
-        // The L3 cache is generally 16MB or more
-        {16 * 1024 * 1024, 2.0},
-};
-
-static constexpr int STREAMING_HT_MIN_REDUCTION_SIZE =
-        sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
-
 AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
                                  const DescriptorTbl& descs)
         : ExecNode(pool, tnode, descs),
@@ -121,6 +80,11 @@ AggregationNode::AggregationNode(ObjectPool* pool, const TPlanNode& tnode,
           _hash_table_iterate_timer(nullptr),
           _insert_keys_to_column_timer(nullptr),
           _streaming_agg_timer(nullptr),
+          _streaming_agg_pass_through_rows_counter(nullptr),
+          _streaming_agg_pass_through_switch_counter(nullptr),
+          _streaming_agg_probe_back_counter(nullptr),
+          _streaming_agg_reduction_ratio(nullptr),
+          _streaming_agg_probe_ns_per_row(nullptr),
           _hash_table_size_counter(nullptr),
           _hash_table_input_counter(nullptr),
           _max_row_size_counter(nullptr) {
@@ -166,16 +130,6 @@ Status AggregationNode::init(const TPlanNode& tnode, RuntimeState* state) {
     const auto& agg_functions = tnode.agg_node.aggregate_functions;
     _external_agg_bytes_threshold = state->external_agg_bytes_threshold();
 
-    if (_external_agg_bytes_threshold > 0) {
-        size_t spill_partition_count_bits = 4;
-        if (state->query_options().__isset.external_agg_partition_bits) {
-            spill_partition_count_bits = state->query_options().external_agg_partition_bits;
-        }
-
-        _spill_partition_helper =
-                std::make_unique<SpillPartitionHelper>(spill_partition_count_bits);
-    }
-
     _is_merge = std::any_of(agg_functions.cbegin(), agg_functions.cend(),
                             [](const auto& e) { return e.nodes[0].agg_expr.is_merge_agg; });
     return Status::OK();
@@ -323,6 +277,17 @@ void AggregationNode::_init_hash_method(std::vector<VExprContext*>& probe_exprs)
     }
 }
 
+void AggregationNode::_init_partitioned_threshold() {
+    std::visit(
+            [&](auto&& agg_method) {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                    agg_method.data.set_partitioned_threshold(_partitioned_threshold);
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+}
+
 Status AggregationNode::prepare_profile(RuntimeState* state) {
     auto* memory_usage = runtime_profile()->create_child("PeakMemoryUsage", true, true);
     runtime_profile()->add_child(memory_usage, false, nullptr);
@@ -344,10 +309,34 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
     _hash_table_iterate_timer = ADD_TIMER(runtime_profile(), "HashTableIterateTime");
     _insert_keys_to_column_timer = ADD_TIMER(runtime_profile(), "InsertKeysToColumnTime");
     _streaming_agg_timer = ADD_TIMER(runtime_profile(), "StreamingAggTime");
+    _streaming_agg_pass_through_rows_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingAggPassThroughRows", TUnit::UNIT);
+    _streaming_agg_pass_through_switch_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingAggPassThroughSwitchCount", TUnit::UNIT);
+    _mem_reservation.init(state->query_mem_reservation(), runtime_profile());
+    _streaming_agg_probe_back_counter =
+            ADD_COUNTER(runtime_profile(), "StreamingAggProbeBackCount", TUnit::UNIT);
+    _streaming_agg_reduction_ratio =
+            ADD_COUNTER(runtime_profile(), "StreamingAggReductionRatio", TUnit::DOUBLE_VALUE);
+    _streaming_agg_probe_ns_per_row =
+            ADD_COUNTER(runtime_profile(), "StreamingAggProbeNsPerRow", TUnit::DOUBLE_VALUE);
     _hash_table_size_counter = ADD_COUNTER(runtime_profile(), "HashTableSize", TUnit::UNIT);
     _hash_table_input_counter = ADD_COUNTER(runtime_profile(), "HashTableInputCount", TUnit::UNIT);
     _max_row_size_counter = ADD_COUNTER(runtime_profile(), "MaxRowSizeInBytes", TUnit::UNIT);
     COUNTER_SET(_max_row_size_counter, (int64_t)0);
+
+    // the hash table is spilled once it grows over the threshold or its memory reservation
+    // is denied
+    if (_external_agg_bytes_threshold > 0 || _mem_reservation.enabled()) {
+        size_t spill_partition_count_bits = 4;
+        if (state->query_options().__isset.external_agg_partition_bits) {
+            spill_partition_count_bits = state->query_options().external_agg_partition_bits;
+        }
+
+        _spill_partition_helper =
+                std::make_unique<SpillPartitionHelper>(spill_partition_count_bits);
+    }
+
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
     _output_tuple_desc = state->desc_tbl().get_tuple_descriptor(_output_tuple_id);
     DCHECK_EQ(_intermediate_tuple_desc->slots().size(), _output_tuple_desc->slots().size());
@@ -431,6 +420,8 @@ Status AggregationNode::prepare_profile(RuntimeState* state) {
         _executor.close = std::bind<void>(&AggregationNode::_close_without_key, this);
     } else {
         _init_hash_method(_probe_expr_ctxs);
+        _partitioned_threshold = state->partitioned_hash_agg_rows_threshold();
+        _init_partitioned_threshold();
 
         std::visit(
                 [&](auto&& agg_method) {
@@ -486,6 +477,10 @@ Status AggregationNode::prepare(RuntimeState* state) {
 
     RETURN_IF_ERROR(ExecNode::prepare(state));
     RETURN_IF_ERROR(prepare_profile(state));
+    _runtime_state = state;
+    _all_evaluators_builtin =
+            std::all_of(_aggregate_evaluators.begin(), _aggregate_evaluators.end(),
+                        [](const AggFnEvaluator* evaluator) { return evaluator->is_builtin(); });
     return Status::OK();
 }
 
@@ -615,7 +610,12 @@ void AggregationNode::release_resource(RuntimeState* state) {
     if (_hash_table_size_counter) {
         std::visit(
                 [&](auto&& agg_method) {
+                    using HashTableType = std::decay_t<decltype(agg_method.data)>;
                     COUNTER_SET(_hash_table_size_counter, int64_t(agg_method.data.size()));
+                    if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                        COUNTER_UPDATE(_build_table_convert_timer,
+                                       agg_method.data.get_convert_timer_value());
+                    }
                 },
                 _agg_data->_aggregated_method_variant);
     }
@@ -842,11 +842,7 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
                 if (ht_rows == 0) return true;
 
                 // Find the appropriate reduction factor in our table for the current hash table sizes.
-                int cache_level = 0;
-                while (cache_level + 1 < STREAMING_HT_MIN_REDUCTION_SIZE &&
-                       ht_mem >= STREAMING_HT_MIN_REDUCTION[cache_level + 1].min_ht_mem) {
-                    ++cache_level;
-                }
+                int cache_level = streaming_ht_cache_level(ht_mem);
 
                 // Compare the number of rows in the hash table with the number of input rows that
                 // were aggregated into it. Exclude passed through rows from this calculation since
@@ -882,6 +878,25 @@ bool AggregationNode::_should_expand_preagg_hash_tables() {
             _agg_data->_aggregated_method_variant);
 }
 
+bool AggregationNode::_should_pass_through_preagg(size_t rows) {
+    const bool pass_through = _preagg_pass_through.should_pass_through(rows);
+    COUNTER_SET(_streaming_agg_probe_back_counter, _preagg_pass_through.probe_back_count());
+    return pass_through;
+}
+
+void AggregationNode::_update_preagg_reduction(size_t input_rows, size_t new_groups,
+                                               int64_t probe_ns) {
+    const size_t ht_mem = std::visit(
+            [&](auto&& agg_method) { return agg_method.data.get_buffer_size_in_bytes(); },
+            _agg_data->_aggregated_method_variant);
+    if (_preagg_pass_through.update(input_rows, new_groups, probe_ns, ht_mem)) {
+        COUNTER_SET(_streaming_agg_reduction_ratio, _preagg_pass_through.reduction());
+        COUNTER_SET(_streaming_agg_probe_ns_per_row, _preagg_pass_through.probe_ns_per_row());
+        COUNTER_SET(_streaming_agg_pass_through_switch_counter,
+                    _preagg_pass_through.switch_count());
+    }
+}
+
 size_t AggregationNode::_memory_usage() const {
     size_t usage = 0;
     std::visit(
@@ -932,7 +947,12 @@ Status AggregationNode::_reset_hash_table() {
                                 _align_aggregate_states));
                 HashTableType new_hash_table;
                 hash_table = std::move(new_hash_table);
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                    hash_table.set_partitioned_threshold(_partitioned_threshold);
+                }
                 _agg_arena_pool.reset(new Arena);
+                _parallel_merge_arenas.clear();
+                _parallel_result_eos = false;
                 return Status::OK();
             },
             _agg_data->_aggregated_method_variant);
@@ -1111,18 +1131,27 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
     // pressure. In either case we should always use the remaining space in the hash table
     // to avoid wasting memory.
     // But for fixed hash map, it never need to expand
+    //
+    // Besides, if the observed reduction of recent batches is too low, the rows are passed
+    // through until the next probe, see _update_preagg_reduction().
     bool ret_flag = false;
+    const bool pass_through = _should_pass_through_preagg(rows);
     RETURN_IF_ERROR(std::visit(
             [&](auto&& agg_method) -> Status {
-                if (auto& hash_tbl = agg_method.data; hash_tbl.add_elem_size_overflow(rows)) {
+                if (auto& hash_tbl = agg_method.data;
+                    pass_through || hash_tbl.add_elem_size_overflow(rows)) {
                     /// If too much memory is used during the pre-aggregation stage,
                     /// it is better to output the data directly without performing further aggregation.
                     const bool used_too_much_memory =
                             (_external_agg_bytes_threshold > 0 &&
                              _memory_usage() > _external_agg_bytes_threshold);
                     // do not try to do agg, just init and serialize directly return the out_block
-                    if (!_should_expand_preagg_hash_tables() || used_too_much_memory) {
+                    // the hash table doubles its buffer when it expands
+                    if (pass_through || !_should_expand_preagg_hash_tables() ||
+                        used_too_much_memory ||
+                        !_mem_reservation.reserve_to(_memory_usage() * 2)) {
                         SCOPED_TIMER(_streaming_agg_timer);
+                        COUNTER_UPDATE(_streaming_agg_pass_through_rows_counter, rows);
                         ret_flag = true;
 
                         // will serialize value data to string column.
@@ -1211,7 +1240,13 @@ Status AggregationNode::_pre_agg_with_serialized_key(doris::vectorized::Block* i
             _agg_data->_aggregated_method_variant));
 
     if (!ret_flag) {
-        RETURN_IF_CATCH_EXCEPTION(_emplace_into_hash_table(_places.data(), key_columns, rows));
+        const size_t groups_before = _get_hash_table_size();
+        int64_t probe_ns = 0;
+        {
+            SCOPED_RAW_TIMER(&probe_ns);
+            RETURN_IF_CATCH_EXCEPTION(_emplace_into_hash_table(_places.data(), key_columns, rows));
+        }
+        _update_preagg_reduction(rows, _get_hash_table_size() - groups_before, probe_ns);
 
         for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
             RETURN_IF_ERROR(_aggregate_evaluators[i]->execute_batch_add(
@@ -1403,13 +1438,17 @@ Status AggregationNode::_spill_hash_table(HashTableCtxType& agg_method, HashTabl
 }
 
 Status AggregationNode::_try_spill_disk(bool eos) {
-    if (_external_agg_bytes_threshold == 0) {
+    if (_spill_partition_helper == nullptr) {
+        // neither the threshold nor memory reservation is enabled
         return Status::OK();
     }
     return std::visit(
             [&](auto&& agg_method) -> Status {
                 auto& hash_table = agg_method.data;
-                if (!eos && _memory_usage() < _external_agg_bytes_threshold) {
+                // the hash table grows in the reservation with or without the threshold
+                const bool below_threshold = _external_agg_bytes_threshold == 0 ||
+                                             _memory_usage() < _external_agg_bytes_threshold;
+                if (!eos && below_threshold && _mem_reservation.reserve_to(_memory_usage())) {
                     return Status::OK();
                 }
 
@@ -1418,7 +1457,9 @@ Status AggregationNode::_try_spill_disk(bool eos) {
                 }
 
                 RETURN_IF_ERROR(_spill_hash_table(agg_method, hash_table));
-                return _reset_hash_table();
+                RETURN_IF_ERROR(_reset_hash_table());
+                _mem_reservation.reserve_to(_memory_usage());
+                return Status::OK();
             },
             _agg_data->_aggregated_method_variant);
 }
@@ -1483,6 +1524,10 @@ Status AggregationNode::_get_with_serialized_key_result(RuntimeState* state, Blo
 
 Status AggregationNode::_get_result_with_serialized_key_non_spill(RuntimeState* state, Block* block,
                                                                   bool* eos) {
+    if (_should_get_result_in_parallel()) {
+        return _get_result_in_parallel(state, block, eos);
+    }
+
     // non-nullable column(id in `_make_nullable_keys`) will be converted to nullable.
     bool mem_reuse = _make_nullable_keys.empty() && block->mem_reuse();
 
@@ -1582,6 +1627,262 @@ Status AggregationNode::_get_result_with_serialized_key_non_spill(RuntimeState*
     return Status::OK();
 }
 
+size_t AggregationNode::_num_parallel_agg_tasks(size_t rows, size_t max_tasks) const {
+    ThreadPool* thread_pool = ExecEnv::GetInstance()->agg_thread_pool();
+    int32_t min_rows_per_task = config::parallel_agg_min_rows_per_task;
+    if (thread_pool == nullptr || min_rows_per_task <= 0 || !_all_evaluators_builtin) {
+        return 1;
+    }
+    return std::min({rows / min_rows_per_task, size_t(thread_pool->max_threads()), max_tasks});
+}
+
+// Rows of keys in the same sub table are merged by the same task, so each aggregate state is
+// only touched by one thread. Returns the number of tasks, rows are merged serially if it's 1.
+size_t AggregationNode::_split_rows_for_parallel_merge(size_t rows) {
+    return std::visit(
+            [&](auto&& agg_method) -> size_t {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table &&
+                              HashTableTraits<HashTableType>::is_phmap) {
+                    auto& data = agg_method.data;
+                    if (!data.is_partitioned()) {
+                        return 1;
+                    }
+                    size_t num_tasks =
+                            _num_parallel_agg_tasks(rows, HashTableType::get_sub_table_count());
+                    if (num_tasks <= 1) {
+                        return 1;
+                    }
+
+                    _parallel_merge_rows.resize(num_tasks);
+                    for (auto& task_rows : _parallel_merge_rows) {
+                        task_rows.clear();
+                    }
+                    // all rows of the null key are merged by the first task
+                    AggregateDataPtr null_key_data =
+                            data.has_null_key_data() ? data.get_null_key_data() : nullptr;
+                    for (uint32_t i = 0; i < rows; ++i) {
+                        size_t task = 0;
+                        if (_places[i] != null_key_data) {
+                            task = HashTableType::get_sub_table_idx(_hash_values[i]) % num_tasks;
+                        }
+                        _parallel_merge_rows[task].push_back(i);
+                    }
+                    while (_parallel_merge_arenas.size() < num_tasks) {
+                        _parallel_merge_arenas.emplace_back(new Arena);
+                    }
+                    return num_tasks;
+                } else {
+                    return 1;
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+}
+
+// Merges the states deserialized into _deserialize_buffer into _places by the rows split by
+// _split_rows_for_parallel_merge(), the first task is run by this thread.
+Status AggregationNode::_merge_in_parallel(AggFnEvaluator* evaluator, size_t offset,
+                                           size_t num_tasks) {
+    const IAggregateFunction* function = evaluator->function().get();
+    size_t size_of_data = function->size_of_data();
+    const char* rhs = _deserialize_buffer.data();
+    auto merge_rows = [&](size_t task) -> Status {
+        Arena* arena = _parallel_merge_arenas[task].get();
+        RETURN_IF_CATCH_EXCEPTION({
+            for (uint32_t row : _parallel_merge_rows[task]) {
+                function->merge(_places[row] + offset, rhs + size_of_data * row, arena);
+            }
+        });
+        return Status::OK();
+    };
+
+    std::vector<Status> statuses(num_tasks);
+    auto token = ExecEnv::GetInstance()->agg_thread_pool()->new_token(
+            ThreadPool::ExecutionMode::CONCURRENT);
+    for (size_t task = 1; task < num_tasks; ++task) {
+        auto st = token->submit_func([this, &merge_rows, status = &statuses[task], task]() {
+            SCOPED_ATTACH_TASK(_runtime_state);
+            *status = merge_rows(task);
+        });
+        if (!st.ok()) {
+            // the pool is shut down, merge the rows by this thread
+            statuses[task] = merge_rows(task);
+        }
+    }
+    statuses[0] = merge_rows(0);
+    token->wait();
+
+    for (const auto& status : statuses) {
+        RETURN_IF_ERROR(status);
+    }
+    return Status::OK();
+}
+
+size_t AggregationNode::_parallel_merge_arena_size() const {
+    size_t size = 0;
+    for (const auto& arena : _parallel_merge_arenas) {
+        size += arena->size();
+    }
+    return size;
+}
+
+bool AggregationNode::_should_get_result_in_parallel() {
+    if (!_parallel_result_blocks.empty() || _parallel_result_eos) {
+        return true;
+    }
+    return std::visit(
+            [&](auto&& agg_method) -> bool {
+                using HashTableType = std::decay_t<decltype(agg_method.data)>;
+                if constexpr (HashTableTraits<HashTableType>::is_partitioned_table) {
+                    return agg_method.data.is_partitioned() &&
+                           _num_parallel_agg_tasks(agg_method.data.size(),
+                                                   std::numeric_limits<size_t>::max()) > 1;
+                } else {
+                    return false;
+                }
+            },
+            _agg_data->_aggregated_method_variant);
+}
+
+// Returns the result blocks finalized by _finalize_results_in_parallel() one by one.
+Status AggregationNode::_get_result_in_parallel(RuntimeState* state, Block* block, bool* eos) {
+    if (_parallel_result_blocks.empty() && !_parallel_result_eos) {
+        RETURN_IF_ERROR(_finalize_results_in_parallel(state));
+    }
+
+    if (_parallel_result_blocks.empty()) {
+        *block = VectorizedUtils::create_columns_with_type_and_name(_row_descriptor);
+        *eos = true;
+        return Status::OK();
+    }
+    *block = std::move(_parallel_result_blocks.front());
+    _parallel_result_blocks.pop_front();
+    *eos = _parallel_result_blocks.empty() && _parallel_result_eos;
+    return Status::OK();
+}
+
+// Takes the next batch of groups for each task from the aggregate data container, the tasks
+// insert the keys and the finalized states of their batch into a result block in parallel.
+Status AggregationNode::_finalize_results_in_parallel(RuntimeState* state) {
+    SCOPED_TIMER(_get_results_timer);
+    const size_t batch_size = state->batch_size();
+    return std::visit(
+            [&](auto&& agg_method) -> Status {
+                using KeyType = std::decay_t<decltype(agg_method.iterator->get_first())>;
+                using AggMethodType = std::decay_t<decltype(agg_method)>;
+                agg_method.init_once();
+                _aggregate_data_container->init_once();
+                auto& iter = _aggregate_data_container->iterator;
+
+                size_t max_tasks = ExecEnv::GetInstance()->agg_thread_pool()->max_threads();
+                std::vector<std::vector<KeyType>> keys(max_tasks);
+                std::vector<std::vector<AggregateDataPtr>> values(max_tasks);
+                size_t num_tasks = 0;
+                {
+                    SCOPED_TIMER(_hash_table_iterate_timer);
+                    for (; num_tasks < max_tasks && iter != _aggregate_data_container->end();
+                         ++num_tasks) {
+                        keys[num_tasks].reserve(batch_size);
+                        values[num_tasks].reserve(batch_size);
+                        while (iter != _aggregate_data_container->end() &&
+                               keys[num_tasks].size() < batch_size) {
+                            keys[num_tasks].push_back(iter.get_key<KeyType>());
+                            values[num_tasks].push_back(iter.get_aggregate_data());
+                            ++iter;
+                        }
+                    }
+                }
+
+                int key_size = _probe_expr_ctxs.size();
+                std::vector<Block> blocks(num_tasks);
+                auto finalize_batch = [&](size_t task) -> Status {
+                    auto columns_with_schema =
+                            VectorizedUtils::create_columns_with_type_and_name(_row_descriptor);
+                    size_t num_rows = keys[task].size();
+                    MutableColumns key_columns;
+                    MutableColumns value_columns;
+                    RETURN_IF_CATCH_EXCEPTION({
+                        for (int i = 0; i < key_size; ++i) {
+                            key_columns.emplace_back(columns_with_schema[i].type->create_column());
+                        }
+                        for (int i = key_size; i < columns_with_schema.size(); ++i) {
+                            value_columns.emplace_back(
+                                    columns_with_schema[i].type->create_column());
+                        }
+                        AggMethodType::insert_keys_into_columns(keys[task], key_columns, num_rows,
+                                                                _probe_key_sz);
+                        for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                            _aggregate_evaluators[i]->insert_result_info_vec(
+                                    values[task], _offsets_of_aggregate_states[i],
+                                    value_columns[i].get(), num_rows);
+                        }
+                    });
+
+                    MutableColumns columns;
+                    for (auto& column : key_columns) {
+                        columns.emplace_back(std::move(column));
+                    }
+                    for (auto& column : value_columns) {
+                        columns.emplace_back(std::move(column));
+                    }
+                    blocks[task] = columns_with_schema;
+                    blocks[task].set_columns(std::move(columns));
+                    return Status::OK();
+                };
+
+                std::vector<Status> statuses(num_tasks);
+                auto token = ExecEnv::GetInstance()->agg_thread_pool()->new_token(
+                        ThreadPool::ExecutionMode::CONCURRENT);
+                for (size_t task = 1; task < num_tasks; ++task) {
+                    auto st = token->submit_func(
+                            [this, &finalize_batch, status = &statuses[task], task]() {
+                                SCOPED_ATTACH_TASK(_runtime_state);
+                                *status = finalize_batch(task);
+                            });
+                    if (!st.ok()) {
+                        // the pool is shut down, finalize the batch by this thread
+                        statuses[task] = finalize_batch(task);
+                    }
+                }
+                if (num_tasks > 0) {
+                    statuses[0] = finalize_batch(0);
+                }
+                token->wait();
+
+                for (size_t task = 0; task < num_tasks; ++task) {
+                    RETURN_IF_ERROR(statuses[task]);
+                    _parallel_result_blocks.push_back(std::move(blocks[task]));
+                }
+
+                if (iter == _aggregate_data_container->end()) {
+                    if (agg_method.data.has_null_key_data()) {
+                        // only one key of group by support wrap null key
+                        DCHECK(key_size == 1);
+                        auto columns_with_schema =
+                                VectorizedUtils::create_columns_with_type_and_name(_row_descriptor);
+                        MutableColumns columns(columns_with_schema.size());
+                        for (int i = 0; i < columns.size(); ++i) {
+                            columns[i] = columns_with_schema[i].type->create_column();
+                        }
+                        DCHECK(columns[0]->is_nullable());
+                        columns[0]->insert_data(nullptr, 0);
+                        auto mapped = agg_method.data.get_null_key_data();
+                        for (size_t i = 0; i < _aggregate_evaluators.size(); ++i) {
+                            _aggregate_evaluators[i]->insert_result_info(
+                                    mapped + _offsets_of_aggregate_states[i],
+                                    columns[key_size + i].get());
+                        }
+                        Block null_key_block = columns_with_schema;
+                        null_key_block.set_columns(std::move(columns));
+                        _parallel_result_blocks.push_back(std::move(null_key_block));
+                    }
+                    _parallel_result_eos = true;
+                }
+                return Status::OK();
+            },
+            _agg_data->_aggregated_method_variant);
+}
+
 Status AggregationNode::_serialize_with_serialized_key_result(RuntimeState* state, Block* block,
                                                               bool* eos) {
     if (_spill_context.has_data) {
@@ -1752,7 +2053,7 @@ void AggregationNode::_update_memusage_with_serialized_key() {
     std::visit(
             [&](auto&& agg_method) -> void {
                 auto& data = agg_method.data;
-                auto arena_memory_usage = _agg_arena_pool->size() +
+                auto arena_memory_usage = _agg_arena_pool->size() + _parallel_merge_arena_size() +
                                           _aggregate_data_container->memory_usage() -
                                           _mem_usage_record.used_in_arena;
                 mem_tracker()->consume(arena_memory_usage);
@@ -1762,8 +2063,9 @@ void AggregationNode::_update_memusage_with_serialized_key() {
                 COUNTER_UPDATE(_hash_table_memory_usage,
                                data.get_buffer_size_in_bytes() - _mem_usage_record.used_in_state);
                 _mem_usage_record.used_in_state = data.get_buffer_size_in_bytes();
-                _mem_usage_record.used_in_arena =
-                        _agg_arena_pool->size() + _aggregate_data_container->memory_usage();
+                _mem_usage_record.used_in_arena = _agg_arena_pool->size() +
+                                                  _parallel_merge_arena_size() +
+                                                  _aggregate_data_container->memory_usage();
             },
             _agg_data->_aggregated_method_variant);
 }
@@ -1795,6 +2097,8 @@ void AggregationNode::_release_mem() {
     _aggregate_data_container = nullptr;
     _agg_profile_arena = nullptr;
     _agg_arena_pool = nullptr;
+    _parallel_merge_arenas.clear();
+    _parallel_result_blocks.clear();
     _preagg_block.clear();
 
     PODArray<AggregateDataPtr> tmp_places;
@@ -23,6 +23,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -37,6 +38,7 @@
 #include "common/global_types.h"
 #include "common/status.h"
 #include "exec/exec_node.h"
+#include "runtime/memory/mem_reservation.h"
 #include "util/runtime_profile.h"
 #include "vec/aggregate_functions/aggregate_function.h"
 #include "vec/columns/column.h"
@@ -63,6 +65,7 @@
 #include "vec/core/block_spill_writer.h"
 #include "vec/core/column_with_type_and_name.h"
 #include "vec/core/types.h"
+#include "vec/exec/streaming_preagg_pass_through.h"
 #include "vec/exprs/vectorized_agg_fn.h"
 #include "vec/exprs/vexpr.h"
 #include "vec/exprs/vexpr_context.h"
@@ -440,14 +443,17 @@ using AggregatedDataWithUInt32Key = PHHashMap<UInt32, AggregateDataPtr, HashCRC3
 using AggregatedDataWithUInt64Key = PHHashMap<UInt64, AggregateDataPtr, HashCRC32<UInt64>>;
 using AggregatedDataWithUInt128Key = PHHashMap<UInt128, AggregateDataPtr, HashCRC32<UInt128>>;
 using AggregatedDataWithUInt256Key = PHHashMap<UInt256, AggregateDataPtr, HashCRC32<UInt256>>;
+// The phase2 (merge/final) hash tables may hold all the distinct keys of the query, so they
+// start as a single table and are converted to a partitioned (two level) table once they grow
+// beyond `partitioned_hash_agg_rows_threshold`, which amortizes the cost of resizing.
 using AggregatedDataWithUInt32KeyPhase2 =
-        PHHashMap<UInt32, AggregateDataPtr, HashMixWrapper<UInt32>>;
+        PHPartitionedHashMap<UInt32, AggregateDataPtr, HashMixWrapper<UInt32>>;
 using AggregatedDataWithUInt64KeyPhase2 =
-        PHHashMap<UInt64, AggregateDataPtr, HashMixWrapper<UInt64>>;
+        PHPartitionedHashMap<UInt64, AggregateDataPtr, HashMixWrapper<UInt64>>;
 using AggregatedDataWithUInt128KeyPhase2 =
-        PHHashMap<UInt128, AggregateDataPtr, HashMixWrapper<UInt128>>;
+        PHPartitionedHashMap<UInt128, AggregateDataPtr, HashMixWrapper<UInt128>>;
 using AggregatedDataWithUInt256KeyPhase2 =
-        PHHashMap<UInt256, AggregateDataPtr, HashMixWrapper<UInt256>>;
+        PHPartitionedHashMap<UInt256, AggregateDataPtr, HashMixWrapper<UInt256>>;
 
 using AggregatedDataWithNullableUInt8Key = AggregationDataWithNullKey<AggregatedDataWithUInt8Key>;
 using AggregatedDataWithNullableUInt16Key = AggregationDataWithNullKey<AggregatedDataWithUInt16Key>;
@@ -916,6 +922,9 @@ private:
     size_t _total_size_of_aggregate_states = 0;
 
     size_t _external_agg_bytes_threshold;
+    // the hash table is spilled, or the streaming preagg passes rows through, once the memory
+    // for it can not be reserved
+    OperatorMemReservation _mem_reservation;
     size_t _partitioned_threshold = 0;
 
     AggregatedDataVariantsUPtr _agg_data;
@@ -939,6 +948,11 @@ private:
     RuntimeProfile::Counter* _hash_table_iterate_timer;
     RuntimeProfile::Counter* _insert_keys_to_column_timer;
     RuntimeProfile::Counter* _streaming_agg_timer;
+    RuntimeProfile::Counter* _streaming_agg_pass_through_rows_counter;
+    RuntimeProfile::Counter* _streaming_agg_pass_through_switch_counter;
+    RuntimeProfile::Counter* _streaming_agg_probe_back_counter;
+    RuntimeProfile::Counter* _streaming_agg_reduction_ratio;
+    RuntimeProfile::Counter* _streaming_agg_probe_ns_per_row;
     RuntimeProfile::Counter* _hash_table_size_counter;
     RuntimeProfile::Counter* _hash_table_input_counter;
     RuntimeProfile::Counter* _max_row_size_counter;
@@ -951,6 +965,9 @@ private:
     bool _should_expand_hash_table = true;
     bool _child_eos = false;
 
+    // adaptive pass-through of streaming preaggregation, see _update_preagg_reduction()
+    StreamingPreaggPassThrough _preagg_pass_through;
+
     bool _should_limit_output = false;
     bool _reach_limit = false;
     bool _agg_data_created_without_key = false;
@@ -961,12 +978,27 @@ private:
     std::vector<AggregateDataPtr> _values;
     std::unique_ptr<AggregateDataContainer> _aggregate_data_container;
 
+    RuntimeState* _runtime_state = nullptr;
+    // java and rpc udafs are always merged and finalized by the query thread
+    bool _all_evaluators_builtin = false;
+    // rows of the merged block and arenas of the parallel merge tasks, the arenas hold memory
+    // of the aggregate states until the hash table is reset
+    std::vector<std::vector<uint32_t>> _parallel_merge_rows;
+    std::vector<ArenaUPtr> _parallel_merge_arenas;
+    // result blocks finalized in parallel which are not returned yet
+    std::deque<Block> _parallel_result_blocks;
+    bool _parallel_result_eos = false;
+
 private:
     void _release_self_resource(RuntimeState* state);
     /// Return true if we should keep expanding hash tables in the preagg. If false,
     /// the preagg should pass through any rows it can't fit in its tables.
     bool _should_expand_preagg_hash_tables();
 
+    bool _should_pass_through_preagg(size_t rows);
+
+    void _update_preagg_reduction(size_t input_rows, size_t new_groups, int64_t probe_ns);
+
     size_t _get_hash_table_size();
 
     void _make_nullable_output_key(Block* block);
@@ -984,6 +1016,16 @@ private:
     Status _get_with_serialized_key_result(RuntimeState* state, Block* block, bool* eos);
     Status _get_result_with_serialized_key_non_spill(RuntimeState* state, Block* block, bool* eos);
 
+    // The aggregate states of partitioned hash tables are merged and finalized by the agg thread
+    // pool, the tasks attach to the query so that their memory is tracked by it.
+    size_t _num_parallel_agg_tasks(size_t rows, size_t max_tasks) const;
+    size_t _split_rows_for_parallel_merge(size_t rows);
+    Status _merge_in_parallel(AggFnEvaluator* evaluator, size_t offset, size_t num_tasks);
+    bool _should_get_result_in_parallel();
+    Status _get_result_in_parallel(RuntimeState* state, Block* block, bool* eos);
+    Status _finalize_results_in_parallel(RuntimeState* state);
+    size_t _parallel_merge_arena_size() const;
+
     Status _merge_spilt_data();
 
     Status _get_result_with_spilt_data(RuntimeState* state, Block* block, bool* eos);
@@ -1000,6 +1042,7 @@ private:
     void _update_memusage_with_serialized_key();
     void _close_with_serialized_key();
     void _init_hash_method(std::vector<VExprContext*>& probe_exprs);
+    void _init_partitioned_threshold();
 
     template <typename AggState, typename AggMethod>
     void _pre_serialize_key_if_need(AggState& state, AggMethod& agg_method,
@@ -1142,6 +1185,7 @@ private:
             }
         } else {
             _emplace_into_hash_table(_places.data(), key_columns, rows);
+            size_t num_merge_tasks = _split_rows_for_parallel_merge(rows);
 
             for (int i = 0; i < _aggregate_evaluators.size(); ++i) {
                 if (_aggregate_evaluators[i]->is_merge() || for_spill) {
@@ -1178,9 +1222,15 @@ private:
                                 _deserialize_buffer.data(), rows);
                     });
 
-                    _aggregate_evaluators[i]->function()->merge_vec(
-                            _places.data(), _offsets_of_aggregate_states[i],
-                            _deserialize_buffer.data(), _agg_arena_pool.get(), rows);
+                    if (num_merge_tasks > 1) {
+                        RETURN_IF_ERROR(_merge_in_parallel(_aggregate_evaluators[i],
+                                                           _offsets_of_aggregate_states[i],
+                                                           num_merge_tasks));
+                    } else {
+                        _aggregate_evaluators[i]->function()->merge_vec(
+                                _places.data(), _offsets_of_aggregate_states[i],
+                                _deserialize_buffer.data(), _agg_arena_pool.get(), rows);
+                    }
                 } else {
                     RETURN_IF_ERROR(_aggregate_evaluators[i]->execute_batch_add(
                             block, _offsets_of_aggregate_states[i], _places.data(),
@@ -99,6 +99,8 @@ public:
     static std::string debug_string(const std::vector<AggFnEvaluator*>& exprs);
     std::string debug_string() const;
     bool is_merge() const { return _is_merge; }
+    // java and rpc udafs must not be called by several threads at the same time
+    bool is_builtin() const { return _fn.binary_type == TFunctionBinaryType::BUILTIN; }
     const std::vector<VExprContext*>& input_exprs_ctxs() const { return _input_exprs_ctxs; }
 
 private:
@@ -23,6 +23,7 @@
 #include <parallel_hashmap/phmap.h>
 #include <simdjson/simdjson.h> // IWYU pragma: keep
 #include <stddef.h>
+#include <string.h>
 
 #include <algorithm>
 #include <memory>
@@ -98,6 +99,7 @@ public:
 };
 
 SimpleObjectPool<JSONDataParser<SimdJSONParser>> parsers_pool;
+SimpleObjectPool<JSONToVariantParser> variant_parsers_pool;
 
 using Node = typename ColumnObject::Subcolumns::Node;
 /// Visitor that keeps @num_dimensions_to_keep dimensions in arrays
@@ -191,6 +193,20 @@ bool try_insert_default_from_nested(const std::shared_ptr<Node>& entry,
     return true;
 }
 
+/// Insert default values to subcolumns missed in a document.
+void insert_defaults_to_missed_subcolumns(
+        ColumnObject& column_object, const phmap::flat_hash_set<StringRef, StringRefHash>& paths) {
+    const auto& subcolumns = column_object.get_subcolumns();
+    for (const auto& entry : subcolumns) {
+        if (!paths.contains(entry->path.get_path())) {
+            bool inserted = try_insert_default_from_nested(entry, subcolumns);
+            if (!inserted) {
+                entry->data.insertDefault();
+            }
+        }
+    }
+}
+
 template <typename ParserImpl>
 Status parse_json_to_variant(IColumn& column, const char* src, size_t length,
                              JSONDataParser<ParserImpl>* parser) {
@@ -248,16 +264,167 @@ Status parse_json_to_variant(IColumn& column, const char* src, size_t length,
         }
         RETURN_IF_ERROR(st);
     }
-    // /// Insert default values to missed subcolumns.
-    const auto& subcolumns = column_object.get_subcolumns();
-    for (const auto& entry : subcolumns) {
-        if (!paths_set.contains(entry->path.get_path())) {
-            bool inserted = try_insert_default_from_nested(entry, subcolumns);
+    insert_defaults_to_missed_subcolumns(column_object, paths_set);
+    column_object.incr_num_rows();
+    return Status::OK();
+}
+
+JSONToVariantParser::JSONToVariantParser()
+        : _fallback_parser(std::make_unique<JSONDataParser<SimdJSONParser>>()) {}
+
+JSONToVariantParser::~JSONToVariantParser() = default;
+
+Status JSONToVariantParser::parse(IColumn& column, const StringRef& json) {
+    auto& column_object = assert_cast<ColumnObject&>(column);
+    if (!_collect(json.data, json.size)) {
+        return parse_json_to_variant(column, json.data, json.size, _fallback_parser.get());
+    }
+    return _insert(column_object);
+}
+
+bool JSONToVariantParser::_collect(const char* src, size_t length) {
+    _paths.clear();
+    _values.clear();
+    _builder.pop_back(_builder.get_parts().size());
+    // empty string is an empty object for JSONDataParser
+    if (length == 0) {
+        return false;
+    }
+    if (_buffer.size() < length + simdjson::SIMDJSON_PADDING) {
+        _buffer.resize(length + simdjson::SIMDJSON_PADDING);
+    }
+    memcpy(_buffer.data(), src, length);
+    try {
+        simdjson::ondemand::document doc = _parser.iterate(_buffer.data(), length, _buffer.size());
+        if (doc.type() != simdjson::ondemand::json_type::object) {
+            return false;
+        }
+        if (!_traverse(doc.get_value()) || !doc.at_end()) {
+            return false;
+        }
+    } catch (simdjson::simdjson_error&) {
+        return false;
+    }
+    // JSONDataParser reports the ambiguous paths
+    phmap::flat_hash_set<StringRef, StringRefHash> paths_set;
+    for (const auto& path : _paths) {
+        if (!paths_set.insert(path.get_path()).second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JSONToVariantParser::_traverse(simdjson::ondemand::value value) {
+    switch (value.type()) {
+    case simdjson::ondemand::json_type::object: {
+        for (auto field : value.get_object()) {
+            std::string_view key = field.unescaped_key();
+            _builder.append(key, false);
+            if (!_traverse(field.value())) {
+                return false;
+            }
+            _builder.pop_back();
+        }
+        return true;
+    }
+    case simdjson::ondemand::json_type::number: {
+        ScalarValue scalar;
+        simdjson::ondemand::number_type number_type = value.get_number_type();
+        switch (number_type) {
+        case simdjson::ondemand::number_type::signed_integer:
+            scalar.type = ScalarValue::Type::INT64;
+            scalar.int64_value = value.get_int64();
+            break;
+        case simdjson::ondemand::number_type::floating_point_number:
+            scalar.type = ScalarValue::Type::FLOAT64;
+            scalar.float64_value = value.get_double();
+            break;
+        default:
+            // unsigned integers out of the range of Int64
+            return false;
+        }
+        _paths.emplace_back(_builder.get_parts());
+        _values.push_back(scalar);
+        return true;
+    }
+    case simdjson::ondemand::json_type::string: {
+        ScalarValue scalar;
+        scalar.type = ScalarValue::Type::STRING;
+        scalar.string_value = value.get_string();
+        _paths.emplace_back(_builder.get_parts());
+        _values.push_back(scalar);
+        return true;
+    }
+    case simdjson::ondemand::json_type::boolean: {
+        ScalarValue scalar;
+        scalar.type = ScalarValue::Type::BOOL;
+        scalar.bool_value = value.get_bool();
+        _paths.emplace_back(_builder.get_parts());
+        _values.push_back(scalar);
+        return true;
+    }
+    case simdjson::ondemand::json_type::null:
+        // null values are filled by defaults of subcolumns
+        return true;
+    default:
+        return false;
+    }
+}
+
+Status JSONToVariantParser::_insert(ColumnObject& column_object) {
+    phmap::flat_hash_set<StringRef, StringRefHash> paths_set;
+    size_t num_rows = column_object.size();
+    for (size_t i = 0; i < _paths.size(); ++i) {
+        const auto& path = _paths[i];
+        const auto& value = _values[i];
+        paths_set.insert(path.get_path());
+        if (!column_object.has_subcolumn(path)) {
+            column_object.add_sub_column(path, num_rows);
+        }
+        auto* subcolumn = column_object.get_subcolumn(path);
+        if (!subcolumn) {
+            return Status::DataQualityError(
+                    fmt::format("Failed to find sub column {}", path.get_path()));
+        }
+        assert(subcolumn->size() == num_rows);
+        bool inserted = false;
+        Field field;
+        switch (value.type) {
+        case ScalarValue::Type::INT64:
+            inserted = subcolumn->try_insert_int64(value.int64_value);
+            field = value.int64_value;
+            break;
+        case ScalarValue::Type::FLOAT64:
+            inserted = subcolumn->try_insert_float64(value.float64_value);
+            field = value.float64_value;
+            break;
+        case ScalarValue::Type::BOOL:
+            inserted = subcolumn->try_insert_bool(value.bool_value);
+            field = value.bool_value;
+            break;
+        case ScalarValue::Type::STRING:
+            inserted = subcolumn->try_insert_string(
+                    StringRef(value.string_value.data(), value.string_value.size()));
             if (!inserted) {
-                entry->data.insertDefault();
+                field = value.string_value;
             }
+            break;
         }
+        if (inserted) {
+            continue;
+        }
+        // the subcolumn is empty or its type has to be widened
+        FieldInfo field_info;
+        RETURN_IF_ERROR(get_field_info(field, &field_info));
+        Status st = subcolumn->insert(std::move(field), std::move(field_info));
+        if (st.is_invalid_argument()) {
+            return Status::DataQualityError(
+                    fmt::format("Failed to insert field {}", st.to_string()));
+        }
+        RETURN_IF_ERROR(st);
     }
+    insert_defaults_to_missed_subcolumns(column_object, paths_set);
     column_object.incr_num_rows();
     return Status::OK();
 }
@@ -274,9 +441,9 @@ Status parse_json_to_variant(IColumn& column, const StringRef& json,
 }
 
 Status parse_json_to_variant(IColumn& column, const std::vector<StringRef>& jsons) {
-    auto parser = parsers_pool.get([] { return new JSONDataParser<SimdJSONParser>(); });
+    auto parser = variant_parsers_pool.get([] { return new JSONToVariantParser(); });
     for (StringRef str : jsons) {
-        RETURN_IF_ERROR(parse_json_to_variant(column, str.data, str.size, parser.get()));
+        RETURN_IF_ERROR(parser->parse(column, str));
     }
     return Status::OK();
 }
@@ -17,11 +17,18 @@
 #pragma once
 
 #include <common/status.h>
+#include <simdjson/simdjson.h> // IWYU pragma: keep
+#include <stddef.h>
 
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "vec/columns/column.h"
 #include "vec/common/string_ref.h"
+#include "vec/core/types.h"
+#include "vec/json/path_in_data.h"
 
 namespace doris {
 namespace vectorized {
@@ -34,6 +41,48 @@ class JSONDataParser;
 } // namespace doris
 
 namespace doris::vectorized {
+class ColumnObject;
+
+// Parses JSON documents into ColumnObject with simdjson on demand API. Scalar values of
+// documents made of objects and scalars are pushed into the typed parts of subcolumns
+// directly, without boxing them into Field and inferring their types one by one. The type
+// of a subcolumn is only widened through Subcolumn::insert when a value conflicts with it.
+// Documents containing arrays, invalid documents and documents with ambiguous paths are
+// parsed by JSONDataParser.
+class JSONToVariantParser {
+public:
+    JSONToVariantParser();
+    ~JSONToVariantParser();
+
+    // parse a single json into column object
+    Status parse(IColumn& column, const StringRef& json);
+
+private:
+    struct ScalarValue {
+        enum class Type { INT64, FLOAT64, BOOL, STRING };
+        Type type;
+        union {
+            Int64 int64_value;
+            Float64 float64_value;
+            bool bool_value;
+        };
+        std::string_view string_value;
+    };
+
+    // collect paths and values of the document, return false if it can't be parsed by
+    // the on demand path
+    bool _collect(const char* src, size_t length);
+    bool _traverse(simdjson::ondemand::value value);
+    Status _insert(ColumnObject& column_object);
+
+    simdjson::ondemand::parser _parser;
+    // padded copy of the document
+    std::string _buffer;
+    PathInDataBuilder _builder;
+    std::vector<PathInData> _paths;
+    std::vector<ScalarValue> _values;
+    std::unique_ptr<JSONDataParser<SimdJSONParser>> _fallback_parser;
+};
 
 // parse a batch of json strings into column object
 Status parse_json_to_variant(IColumn& column, const std::vector<StringRef>& jsons);
@@ -17,6 +17,7 @@
 
 #include "vec/olap/vertical_merge_iterator.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <gen_cpp/olap_file.pb.h>
 #include <stdlib.h>
@@ -82,6 +83,7 @@ Status RowSourcesBuffer::append(const std::vector<RowSource>& row_sources) {
 
 Status RowSourcesBuffer::seek_to_begin() {
     _buf_idx = 0;
+    _read_offset = 0;
     if (_fd > 0) {
         auto offset = lseek(_fd, 0, SEEK_SET);
         if (offset != 0) {
@@ -93,6 +95,23 @@ Status RowSourcesBuffer::seek_to_begin() {
     return Status::OK();
 }
 
+Status RowSourcesBuffer::clone_for_read(std::unique_ptr<RowSourcesBuffer>* reader) const {
+    auto clone = std::make_unique<RowSourcesBuffer>(_tablet_id, _tablet_path, _reader_type);
+    if (_fd > 0) {
+        DCHECK(_buffer->empty());
+        clone->_fd = ::dup(_fd);
+        if (clone->_fd < 0) {
+            LOG(WARNING) << "failed to dup row source buffer file, errno=" << errno;
+            return Status::InternalError("failed to dup row source buffer file");
+        }
+    } else {
+        clone->_buffer->insert_range_from(*_buffer, 0, _buffer->size());
+    }
+    clone->_total_size = _total_size;
+    *reader = std::move(clone);
+    return Status::OK();
+}
+
 Status RowSourcesBuffer::has_remaining() {
     if (_buf_idx < _buffer->size()) {
         return Status::OK();
@@ -207,7 +226,7 @@ Status RowSourcesBuffer::_serialize() {
 
 Status RowSourcesBuffer::_deserialize() {
     size_t rows = 0;
-    ssize_t bytes_read = ::read(_fd, &rows, sizeof(rows));
+    ssize_t bytes_read = ::pread(_fd, &rows, sizeof(rows), _read_offset);
     if (bytes_read == 0) {
         LOG(WARNING) << "end of row source buffer file";
         return Status::EndOfFile("end of row source buffer file");
@@ -215,14 +234,16 @@ Status RowSourcesBuffer::_deserialize() {
         LOG(WARNING) << "failed to read buffer size from file, bytes_read=" << bytes_read;
         return Status::InternalError("failed to read buffer size from file");
     }
+    _read_offset += bytes_read;
     _buffer->resize(rows);
     auto& internal_data = _buffer->get_data();
-    bytes_read = ::read(_fd, internal_data.data(), rows * sizeof(UInt16));
+    bytes_read = ::pread(_fd, internal_data.data(), rows * sizeof(UInt16), _read_offset);
     if (bytes_read != rows * sizeof(UInt16)) {
         LOG(WARNING) << "failed to read buffer data from file, bytes_read=" << bytes_read
                      << ", expect bytes=" << rows * sizeof(UInt16);
         return Status::InternalError("failed to read buffer data from file");
     }
+    _read_offset += bytes_read;
     return Status::OK();
 }
 
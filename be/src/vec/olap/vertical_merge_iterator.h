@@ -123,6 +123,11 @@ public:
     // return continous agg_flag=true count from index
     size_t continuous_agg_count(uint64_t index);
 
+    // Create a read-only copy positioned at the beginning, so several value column
+    // groups can be merged concurrently. Must be called after the key group is
+    // finished and the buffer is flushed.
+    Status clone_for_read(std::unique_ptr<RowSourcesBuffer>* reader) const;
+
 private:
     Status _create_buffer_file();
     Status _serialize();
@@ -138,6 +143,9 @@ private:
     ReaderType _reader_type;
     uint64_t _buf_idx = 0;
     int _fd = -1;
+    // read position in the buffer file, reads use pread so cloned readers sharing
+    // the same file don't disturb each other
+    off_t _read_offset = 0;
     ColumnUInt16::MutablePtr _buffer;
     uint64_t _total_size = 0;
 };
@@ -55,6 +55,31 @@ bool SharedHashTableController::should_build_hash_table(const TUniqueId& fragmen
     return false;
 }
 
+bool SharedHashTableController::share_hash_table_at_runtime(
+        const TUniqueId& fragment_instance_id, int my_node_id,
+        SharedHashTableContextPtr* context) {
+    DCHECK(!_pipeline_engine_enabled);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_builder_fragment_ids.find(my_node_id) == _builder_fragment_ids.cend()) {
+        _builder_fragment_ids.insert({my_node_id, fragment_instance_id});
+        auto it = _shared_contexts.find(my_node_id);
+        if (it == _shared_contexts.cend()) {
+            it = _shared_contexts.insert({my_node_id, std::make_shared<SharedHashTableContext>()})
+                         .first;
+        }
+        *context = it->second;
+        return true;
+    }
+    // the context is erased once the builder signals
+    auto it = _shared_contexts.find(my_node_id);
+    if (it == _shared_contexts.cend()) {
+        *context = nullptr;
+        return true;
+    }
+    *context = it->second;
+    return false;
+}
+
 SharedHashTableContextPtr SharedHashTableController::get_context(int my_node_id) {
     std::lock_guard<std::mutex> lock(_mutex);
     auto it = _shared_contexts.find(my_node_id);
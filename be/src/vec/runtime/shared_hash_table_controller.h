@@ -75,6 +75,12 @@ public:
     void signal(int my_node_id, Status status);
     Status wait_for_signal(RuntimeState* state, const SharedHashTableContextPtr& context);
     bool should_build_hash_table(const TUniqueId& fragment_instance_id, int my_node_id);
+    /// For broadcast joins which decide to share the hash table while building it. Returns true
+    /// if the instance should go on building the hash table, `context` is set to the shared
+    /// context if the hash table is shared with other instances, it's null if the builder of
+    /// the node finished already and the instance builds its own hash table.
+    bool share_hash_table_at_runtime(const TUniqueId& fragment_instance_id, int my_node_id,
+                                     SharedHashTableContextPtr* context);
     void set_pipeline_engine_enabled(bool enabled) { _pipeline_engine_enabled = enabled; }
 
 private:
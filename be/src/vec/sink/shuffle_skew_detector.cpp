@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/shuffle_skew_detector.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+namespace doris::vectorized {
+
+ShuffleSkewDetector::ShuffleSkewDetector(size_t capacity, uint32_t sample_interval)
+        : _capacity(capacity), _sample_interval(std::max<uint32_t>(sample_interval, 1)) {
+    DCHECK_GT(capacity, 0);
+    _counters.reserve(capacity);
+    _index.reserve(capacity);
+}
+
+void ShuffleSkewDetector::add(const uint64_t* hashes, size_t rows) {
+    size_t i = _next_sample;
+    for (; i < rows; i += _sample_interval) {
+        _add_sample(hashes[i]);
+    }
+    _next_sample = i - rows;
+}
+
+void ShuffleSkewDetector::_add_sample(uint64_t hash) {
+    ++_num_sampled_rows;
+    auto it = _index.find(hash);
+    if (it != _index.end()) {
+        ++_counters[it->second].count;
+        return;
+    }
+    if (_counters.size() < _capacity) {
+        _index.emplace(hash, _counters.size());
+        _counters.push_back({hash, 1, 0});
+        return;
+    }
+    // replace the key with the min count, the new key may have occurred that many times
+    auto min_it = std::min_element(
+            _counters.begin(), _counters.end(),
+            [](const Counter& lhs, const Counter& rhs) { return lhs.count < rhs.count; });
+    _index.erase(min_it->hash);
+    _index.emplace(hash, min_it - _counters.begin());
+    min_it->hash = hash;
+    min_it->error = min_it->count;
+    ++min_it->count;
+}
+
+std::vector<ShuffleSkewDetector::HeavyHitter> ShuffleSkewDetector::heavy_hitters(
+        double min_fraction) const {
+    std::vector<HeavyHitter> res;
+    if (_num_sampled_rows == 0) {
+        return res;
+    }
+    for (const auto& counter : _counters) {
+        double fraction = static_cast<double>(counter.count - counter.error) / _num_sampled_rows;
+        if (fraction >= min_fraction) {
+            res.push_back({counter.hash, fraction});
+        }
+    }
+    std::sort(res.begin(), res.end(), [](const HeavyHitter& lhs, const HeavyHitter& rhs) {
+        return lhs.fraction > rhs.fraction;
+    });
+    return res;
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace doris::vectorized {
+
+// Finds heavy hitters among the partition key hashes of a hash shuffle with the
+// Space-Saving algorithm over a sample of rows. Keeps at most `capacity` counters, the
+// count of a key is overestimated by at most total / capacity of the sampled rows.
+class ShuffleSkewDetector {
+public:
+    struct HeavyHitter {
+        uint64_t hash;
+        // estimated fraction of rows with the key
+        double fraction;
+    };
+
+    ShuffleSkewDetector(size_t capacity, uint32_t sample_interval);
+
+    // add hashes of the partition keys of `rows` rows, one of every `sample_interval`
+    // rows is sampled
+    void add(const uint64_t* hashes, size_t rows);
+
+    // keys which are guaranteed to have at least `min_fraction` of the sampled rows,
+    // ordered by their fractions descending
+    std::vector<HeavyHitter> heavy_hitters(double min_fraction) const;
+
+    uint64_t num_sampled_rows() const { return _num_sampled_rows; }
+
+private:
+    void _add_sample(uint64_t hash);
+
+    struct Counter {
+        uint64_t hash;
+        uint64_t count;
+        // max overestimation of count
+        uint64_t error;
+    };
+
+    size_t _capacity;
+    uint32_t _sample_interval;
+    // row offset of the next sample in the next block
+    uint32_t _next_sample = 0;
+    uint64_t _num_sampled_rows = 0;
+    std::vector<Counter> _counters;
+    std::unordered_map<uint64_t, size_t> _index;
+};
+
+} // namespace doris::vectorized
@@ -51,6 +51,7 @@
 #include "vec/exprs/vexpr.h"
 #include "vec/runtime/vdata_stream_mgr.h"
 #include "vec/runtime/vdata_stream_recvr.h"
+#include "vec/sink/shuffle_skew_detector.h"
 
 namespace doris::vectorized {
 
@@ -141,17 +142,36 @@ Status Channel::send_local_block(bool eos) {
     return Status::OK();
 }
 
-Status Channel::send_local_block(Block* block) {
+Status Channel::send_local_block(Block* block, bool can_be_moved) {
     SCOPED_TIMER(_parent->_local_send_timer);
     if (_recvr_is_valid()) {
         COUNTER_UPDATE(_parent->_local_bytes_send_counter, block->bytes());
         COUNTER_UPDATE(_parent->_local_sent_rows, block->rows());
         COUNTER_UPDATE(_parent->_blocks_sent_counter, 1);
-        _local_recvr->add_block(block, _parent->_sender_id, false);
+        if (can_be_moved) {
+            // hand the columns over to the receiver instead of copying them, the caller
+            // keeps a block of the same schema with empty columns to reuse
+            Block empty_block = block->clone_empty();
+            _local_recvr->add_block(block, _parent->_sender_id, true);
+            block->swap(empty_block);
+        } else {
+            _local_recvr->add_block(block, _parent->_sender_id, false);
+        }
     }
     return Status::OK();
 }
 
+void BroadcastPBlockHolder::move_column_values_to_attachment() {
+    _column_values_attachment.clear();
+    // large block is sent by http brpc, which embeds the column values by itself
+    if (!config::transfer_broadcast_block_by_attachment || pblock.column_values().empty() ||
+        pblock.column_values().size() >= MIN_HTTP_BRPC_SIZE) {
+        return;
+    }
+    _column_values_attachment.append(pblock.column_values());
+    pblock.clear_column_values();
+}
+
 Status Channel::send_block(PBlock* block, bool eos) {
     SCOPED_TIMER(_parent->_brpc_send_timer);
     COUNTER_UPDATE(_parent->_blocks_sent_counter, 1);
@@ -295,6 +315,8 @@ VDataStreamSender::VDataStreamSender(RuntimeState* state, ObjectPool* pool, int
           _split_block_hash_compute_timer(nullptr),
           _split_block_distribute_by_channel_timer(nullptr),
           _blocks_sent_counter(nullptr),
+          _skewed_keys_counter(nullptr),
+          _max_channel_rows_counter(nullptr),
           _local_bytes_send_counter(nullptr),
           _dest_node_id(sink.dest_node_id),
           _transfer_large_data_by_brpc(config::transfer_large_data_by_brpc) {
@@ -363,6 +385,8 @@ VDataStreamSender::VDataStreamSender(ObjectPool* pool, int sender_id, const RowD
           _split_block_hash_compute_timer(nullptr),
           _split_block_distribute_by_channel_timer(nullptr),
           _blocks_sent_counter(nullptr),
+          _skewed_keys_counter(nullptr),
+          _max_channel_rows_counter(nullptr),
           _local_bytes_send_counter(nullptr),
           _dest_node_id(dest_node_id) {
     _cur_pb_block = &_pb_block1;
@@ -401,6 +425,8 @@ VDataStreamSender::VDataStreamSender(ObjectPool* pool, const RowDescriptor& row_
           _split_block_hash_compute_timer(nullptr),
           _split_block_distribute_by_channel_timer(nullptr),
           _blocks_sent_counter(nullptr),
+          _skewed_keys_counter(nullptr),
+          _max_channel_rows_counter(nullptr),
           _local_bytes_send_counter(nullptr),
           _dest_node_id(0) {
     _cur_pb_block = &_pb_block1;
@@ -453,6 +479,12 @@ Status VDataStreamSender::prepare(RuntimeState* state) {
             _new_shuffle_hash_method = _state->query_options().enable_new_shuffle_hash_method;
         }
         RETURN_IF_ERROR(VExpr::prepare(_partition_expr_ctxs, state, _row_desc));
+        if (_part_type == TPartitionType::HASH_PARTITIONED && _channels.size() > 1 &&
+            config::shuffle_skew_sample_interval > 0) {
+            _skew_detector = std::make_unique<ShuffleSkewDetector>(
+                    SKEW_DETECTOR_CAPACITY, config::shuffle_skew_sample_interval);
+            _channel_rows.resize(_channels.size(), 0);
+        }
     } else {
         RETURN_IF_ERROR(VExpr::prepare(_partition_expr_ctxs, state, _row_desc));
     }
@@ -470,6 +502,8 @@ Status VDataStreamSender::prepare(RuntimeState* state) {
     _split_block_distribute_by_channel_timer =
             ADD_TIMER(profile(), "SplitBlockDistributeByChannelTime");
     _blocks_sent_counter = ADD_COUNTER(profile(), "BlocksSent", TUnit::UNIT);
+    _skewed_keys_counter = ADD_COUNTER(profile(), "SkewedKeys", TUnit::UNIT);
+    _max_channel_rows_counter = ADD_COUNTER(profile(), "MaxChannelRows", TUnit::UNIT);
     _overall_throughput = profile()->add_derived_counter(
             "OverallThroughput", TUnit::BYTES_PER_SECOND,
             std::bind<int64_t>(&RuntimeProfile::units_per_second, _bytes_sent_counter,
@@ -487,6 +521,7 @@ Status VDataStreamSender::open(RuntimeState* state) {
         RETURN_IF_ERROR(_channels[i]->init(state));
         if (_channels[i]->is_local()) {
             local_size++;
+            _last_local_channel_idx = i;
         }
     }
     _only_local_exchange = local_size == _channels.size();
@@ -505,8 +540,9 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
         // 2. send block
         // 3. rollover block
         if (_only_local_exchange) {
-            for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_local_block(block));
+            for (int i = 0; i < _channels.size(); ++i) {
+                RETURN_IF_ERROR(
+                        _channels[i]->send_local_block(block, i == _last_local_channel_idx));
             }
         } else if (_enable_pipeline_exec) {
             BroadcastPBlockHolder* block_holder = nullptr;
@@ -515,14 +551,16 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                 SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
                 RETURN_IF_ERROR(
                         serialize_block(block, block_holder->get_block(), _channels.size()));
+                block_holder->move_column_values_to_attachment();
             }
 
-            for (auto channel : _channels) {
-                if (channel->is_local()) {
-                    RETURN_IF_ERROR(channel->send_local_block(block));
+            for (int i = 0; i < _channels.size(); ++i) {
+                if (_channels[i]->is_local()) {
+                    RETURN_IF_ERROR(
+                            _channels[i]->send_local_block(block, i == _last_local_channel_idx));
                 } else {
                     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
-                    RETURN_IF_ERROR(channel->send_block(block_holder, eos));
+                    RETURN_IF_ERROR(_channels[i]->send_block(block_holder, eos));
                 }
             }
         } else {
@@ -531,12 +569,13 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                 RETURN_IF_ERROR(serialize_block(block, _cur_pb_block, _channels.size()));
             }
 
-            for (auto channel : _channels) {
-                if (channel->is_local()) {
-                    RETURN_IF_ERROR(channel->send_local_block(block));
+            for (int i = 0; i < _channels.size(); ++i) {
+                if (_channels[i]->is_local()) {
+                    RETURN_IF_ERROR(
+                            _channels[i]->send_local_block(block, i == _last_local_channel_idx));
                 } else {
                     SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
-                    RETURN_IF_ERROR(channel->send_block(_cur_pb_block, eos));
+                    RETURN_IF_ERROR(_channels[i]->send_block(_cur_pb_block, eos));
                 }
             }
             // rollover
@@ -547,7 +586,7 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
         Channel* current_channel = _channels[_current_channel_idx];
         // 2. serialize, send and rollover block
         if (current_channel->is_local()) {
-            RETURN_IF_ERROR(current_channel->send_local_block(block));
+            RETURN_IF_ERROR(current_channel->send_local_block(block, true));
         } else {
             SCOPED_CONSUME_MEM_TRACKER(_mem_tracker.get());
             RETURN_IF_ERROR(serialize_block(block, current_channel->ch_cur_pb_block()));
@@ -585,7 +624,7 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                     block->get_by_position(result[j]).column->update_hashes_with_value(siphashs);
                 }
                 for (int i = 0; i < rows; i++) {
-                    hashes[i] = siphashs[i].get64() % element_size;
+                    hashes[i] = siphashs[i].get64();
                 }
             } else {
                 SCOPED_TIMER(_split_block_hash_compute_timer);
@@ -593,9 +632,17 @@ Status VDataStreamSender::send(RuntimeState* state, Block* block, bool eos) {
                 for (int j = 0; j < result_size; ++j) {
                     block->get_by_position(result[j]).column->update_hashes_with_value(hashes);
                 }
-
+            }
+            if (_skew_detector) {
+                // feed the full hashes, keys of the same channel are told apart
+                _skew_detector->add(hashes, rows);
+            }
+            for (int i = 0; i < rows; i++) {
+                hashes[i] = hashes[i] % element_size;
+            }
+            if (_skew_detector) {
                 for (int i = 0; i < rows; i++) {
-                    hashes[i] = hashes[i] % element_size;
+                    ++_channel_rows[hashes[i]];
                 }
             }
 
@@ -650,11 +697,43 @@ Status VDataStreamSender::close(RuntimeState* state, Status exec_status) {
             final_st = st;
         }
     }
+    _report_skew();
     VExpr::close(_partition_expr_ctxs, state);
     DataSink::close(state, exec_status);
     return final_st;
 }
 
+void VDataStreamSender::_report_skew() {
+    if (!_skew_detector || _skew_detector->num_sampled_rows() == 0) {
+        return;
+    }
+    int64_t total_rows = 0;
+    int64_t max_rows = 0;
+    for (auto rows : _channel_rows) {
+        total_rows += rows;
+        max_rows = std::max(max_rows, rows);
+    }
+    COUNTER_SET(_max_channel_rows_counter, max_rows);
+
+    auto hot_keys = _skew_detector->heavy_hitters(config::shuffle_skew_key_min_fraction);
+    if (hot_keys.empty()) {
+        return;
+    }
+    COUNTER_SET(_skewed_keys_counter, static_cast<int64_t>(hot_keys.size()));
+    fmt::memory_buffer buf;
+    for (const auto& key : hot_keys) {
+        fmt::format_to(buf, "{}hash={:x}, fraction={:.2f}, channel={}",
+                       buf.size() == 0 ? "" : "; ", key.hash, key.fraction,
+                       key.hash % _channels.size());
+    }
+    _profile->add_info_string("SkewedKeys", fmt::to_string(buf));
+    LOG(INFO) << "skewed hash shuffle, fragment instance "
+              << print_id(_state->fragment_instance_id()) << ", dest node " << _dest_node_id
+              << ", max channel rows " << max_rows << ", avg channel rows "
+              << total_rows / static_cast<int64_t>(_channel_rows.size()) << ", keys "
+              << fmt::to_string(buf);
+}
+
 Status VDataStreamSender::serialize_block(Block* src, PBlock* dest, int num_receivers) {
     {
         SCOPED_TIMER(_serialize_batch_timer);
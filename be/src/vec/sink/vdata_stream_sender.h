@@ -19,6 +19,7 @@
 
 #include <brpc/controller.h>
 #include <butil/errno.h>
+#include <butil/iobuf.h>
 #include <fmt/format.h>
 #include <gen_cpp/Partitions_types.h>
 #include <gen_cpp/Types_types.h>
@@ -66,6 +67,7 @@ class ExchangeSinkOperator;
 
 namespace vectorized {
 class Channel;
+class ShuffleSkewDetector;
 
 template <typename T>
 struct AtomicWrapper {
@@ -98,9 +100,16 @@ public:
 
     PBlock* get_block() { return &pblock; }
 
+    // Move the serialized column values out of the PBlock into an IOBuf. Requests to all
+    // channels reference the blocks of the IOBuf as attachment instead of each copying the
+    // column values. The attachment is empty if the column values are kept in the PBlock.
+    void move_column_values_to_attachment();
+    const butil::IOBuf& column_values_attachment() const { return _column_values_attachment; }
+
 private:
     AtomicWrapper<uint32_t> _ref_count;
     PBlock pblock;
+    butil::IOBuf _column_values_attachment;
 };
 
 class VDataStreamSender : public DataSink {
@@ -145,7 +154,12 @@ protected:
     friend class Channel;
     friend class pipeline::ExchangeSinkBuffer;
 
+    // number of partition keys tracked by the skew detector
+    static constexpr size_t SKEW_DETECTOR_CAPACITY = 64;
+
     void _roll_pb_block();
+    // report partition keys of a hash shuffle which take a large share of the rows
+    void _report_skew();
     Status _get_next_available_buffer(BroadcastPBlockHolder** holder);
 
     Status get_partition_column_result(Block* block, int* result) const {
@@ -210,6 +224,8 @@ protected:
     RuntimeProfile::Counter* _split_block_hash_compute_timer;
     RuntimeProfile::Counter* _split_block_distribute_by_channel_timer;
     RuntimeProfile::Counter* _blocks_sent_counter;
+    RuntimeProfile::Counter* _skewed_keys_counter;
+    RuntimeProfile::Counter* _max_channel_rows_counter;
 
     std::unique_ptr<MemTracker> _mem_tracker;
 
@@ -227,6 +243,13 @@ protected:
 
     bool _new_shuffle_hash_method = false;
     bool _only_local_exchange = false;
+    // the last channel whose receiver is in this process, -1 if there is none. A block sent
+    // to several channels is moved, instead of copied, to the receiver of this channel.
+    int _last_local_channel_idx = -1;
+    // finds the partition keys which take a large share of rows of a hash shuffle
+    std::unique_ptr<ShuffleSkewDetector> _skew_detector;
+    // rows sent to each channel of a hash shuffle
+    std::vector<int64_t> _channel_rows;
     bool _enable_pipeline_exec = false;
 };
 
@@ -290,7 +313,9 @@ public:
 
     Status send_local_block(bool eos = false);
 
-    Status send_local_block(Block* block);
+    // The columns of `block` are moved to the receiver if `can_be_moved`, then `block` is
+    // left with empty columns, otherwise they are copied.
+    Status send_local_block(Block* block, bool can_be_moved = false);
     // Flush buffered rows and close channel. This function don't wait the response
     // of close operation, client should call close_wait() to finish channel's close.
     // We split one close operation into two phases in order to make multiple channels
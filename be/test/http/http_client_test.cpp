@@ -22,6 +22,9 @@
 #include <unistd.h>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
 
 #include "gtest/gtest_pred_impl.h"
 #include "http/ev_http_server.h"
@@ -29,6 +32,7 @@
 #include "http/http_handler.h"
 #include "http/http_headers.h"
 #include "http/http_request.h"
+#include "http/http_status.h"
 #include "http/utils.h"
 
 namespace doris {
@@ -73,8 +77,17 @@ public:
     }
 };
 
+static const std::string s_download_file = "./.http_client_test_download_file.dat";
+
+// serves s_download_file like the download handler of BE does
+class HttpClientTestFileHandler : public HttpHandler {
+public:
+    void handle(HttpRequest* req) override { do_file_response(s_download_file, req); }
+};
+
 static HttpClientTestSimpleGetHandler s_simple_get_handler = HttpClientTestSimpleGetHandler();
 static HttpClientTestSimplePostHandler s_simple_post_handler = HttpClientTestSimplePostHandler();
+static HttpClientTestFileHandler s_file_handler = HttpClientTestFileHandler();
 static EvHttpServer* s_server = nullptr;
 static int real_port = 0;
 static std::string hostname = "";
@@ -89,13 +102,39 @@ public:
         s_server->register_handler(GET, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(HEAD, "/simple_get", &s_simple_get_handler);
         s_server->register_handler(POST, "/simple_post", &s_simple_post_handler);
+        s_server->register_handler(GET, "/download_file", &s_file_handler);
         s_server->start();
         real_port = s_server->get_real_port();
         EXPECT_NE(0, real_port);
         hostname = "http://127.0.0.1:" + std::to_string(real_port);
     }
 
-    static void TearDownTestCase() { delete s_server; }
+    static void TearDownTestCase() {
+        delete s_server;
+        unlink(s_download_file.c_str());
+    }
+
+    static std::string file_content() {
+        std::string content;
+        for (int i = 0; i < 1000; ++i) {
+            content += std::to_string(i) + ",";
+        }
+        return content;
+    }
+
+    static void write_file(const std::string& path, const std::string& content) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << content;
+    }
+
+    static std::string read_file(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    void SetUp() override { write_file(s_download_file, file_content()); }
 };
 
 TEST_F(HttpClientTest, get_normal) {
@@ -177,4 +216,67 @@ TEST_F(HttpClientTest, post_failed) {
     EXPECT_TRUE(boost::algorithm::contains(st.to_string(), not_found));
 }
 
+// A resumed download gets the rest of the file with 206 and keeps the downloaded bytes
+TEST_F(HttpClientTest, download_resume) {
+    std::string content = file_content();
+    std::string local_file = ".http_client_test_resume.dat";
+    size_t offset = 1000;
+    // bytes after the offset were not completely written by the failed download
+    write_file(local_file, content.substr(0, offset) + "garbage");
+
+    HttpClient client;
+    EXPECT_TRUE(client.init(hostname + "/download_file").ok());
+    auto st = client.download(local_file, offset);
+    EXPECT_TRUE(st.ok()) << st;
+    EXPECT_EQ(HttpStatus::PARTIAL_CONTENT, client.get_http_status());
+    uint64_t len = 0;
+    EXPECT_TRUE(client.get_content_length(&len).ok());
+    EXPECT_EQ(content.size() - offset, len);
+    EXPECT_EQ(content, read_file(local_file));
+    unlink(local_file.c_str());
+}
+
+// A download from the start gets the whole file with 200
+TEST_F(HttpClientTest, download_file) {
+    std::string local_file = ".http_client_test_file.dat";
+    write_file(local_file, "stale content of a previous download");
+
+    HttpClient client;
+    EXPECT_TRUE(client.init(hostname + "/download_file").ok());
+    auto st = client.download(local_file);
+    EXPECT_TRUE(st.ok()) << st;
+    EXPECT_EQ(HttpStatus::OK, client.get_http_status());
+    EXPECT_EQ(file_content(), read_file(local_file));
+    unlink(local_file.c_str());
+}
+
+// A range starting at the end of the file is rejected with 416
+TEST_F(HttpClientTest, download_range_not_satisfiable) {
+    std::string content = file_content();
+    std::string local_file = ".http_client_test_416.dat";
+    write_file(local_file, content);
+
+    HttpClient client;
+    EXPECT_TRUE(client.init(hostname + "/download_file").ok());
+    auto st = client.download(local_file, content.size());
+    EXPECT_FALSE(st.ok());
+    EXPECT_EQ(HttpStatus::REQUESTED_RANGE_NOT_SATISFIED, client.get_http_status());
+    unlink(local_file.c_str());
+}
+
+// A server ignoring the range sends the whole file with 200, the local file is rewritten
+TEST_F(HttpClientTest, download_resume_range_ignored) {
+    std::string local_file = ".http_client_test_range_ignored.dat";
+    write_file(local_file, "tesXXXXXXXXXX");
+
+    HttpClient client;
+    EXPECT_TRUE(client.init(hostname + "/simple_get").ok());
+    client.set_basic_auth("test1", "");
+    auto st = client.download(local_file, 3);
+    EXPECT_TRUE(st.ok()) << st;
+    EXPECT_EQ(HttpStatus::OK, client.get_http_status());
+    EXPECT_EQ("test1", read_file(local_file));
+    unlink(local_file.c_str());
+}
+
 } // namespace doris
@@ -96,4 +96,24 @@ TEST_F(HttpUtilsTest, parse_basic_auth) {
     }
 }
 
+TEST_F(HttpUtilsTest, parse_range_start) {
+    int64_t start = -1;
+    EXPECT_TRUE(parse_range_start("bytes=0-", &start));
+    EXPECT_EQ(0, start);
+    EXPECT_TRUE(parse_range_start("bytes=1024-", &start));
+    EXPECT_EQ(1024, start);
+
+    // only "bytes=<start>-" is supported
+    EXPECT_FALSE(parse_range_start("", &start));
+    EXPECT_FALSE(parse_range_start("bytes=", &start));
+    EXPECT_FALSE(parse_range_start("bytes=-", &start));
+    EXPECT_FALSE(parse_range_start("bytes=-100", &start));
+    EXPECT_FALSE(parse_range_start("bytes=0-99", &start));
+    EXPECT_FALSE(parse_range_start("bytes=0-99,200-", &start));
+    EXPECT_FALSE(parse_range_start("bytes=abc-", &start));
+    EXPECT_FALSE(parse_range_start("bytes=-1-", &start));
+    EXPECT_FALSE(parse_range_start("items=10-", &start));
+    EXPECT_FALSE(parse_range_start("10-", &start));
+}
+
 } // namespace doris
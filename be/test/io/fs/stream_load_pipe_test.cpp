@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "io/fs/stream_load_pipe.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+#include <string.h>
+
+#include <memory>
+
+#include "gtest/gtest_pred_impl.h"
+#include "util/byte_buffer.h"
+
+namespace doris::io {
+
+class StreamLoadPipeTest : public testing::Test {
+public:
+    StreamLoadPipeTest() = default;
+    ~StreamLoadPipeTest() override = default;
+};
+
+// a whole buffer only referenced by the pipe is handed over to the reader without a copy
+TEST_F(StreamLoadPipeTest, read_one_message_without_copy) {
+    StreamLoadPipe pipe;
+    auto buf = ByteBuffer::allocate(8);
+    buf->put_bytes("abcd", 4);
+    buf->flip();
+    auto* ptr = reinterpret_cast<uint8_t*>(buf->ptr);
+    EXPECT_TRUE(pipe.append(buf).ok());
+    buf.reset();
+    EXPECT_TRUE(pipe.finish().ok());
+
+    std::unique_ptr<uint8_t[]> data;
+    size_t length = 0;
+    EXPECT_TRUE(pipe.read_one_message(&data, &length).ok());
+    EXPECT_EQ(ptr, data.get());
+    EXPECT_EQ(4, length);
+    EXPECT_EQ(0, memcmp("abcd", data.get(), 4));
+
+    EXPECT_TRUE(pipe.read_one_message(&data, &length).ok());
+    EXPECT_EQ(nullptr, data.get());
+    EXPECT_EQ(0, length);
+}
+
+// the buffer is copied if someone else still references it
+TEST_F(StreamLoadPipeTest, read_one_message_shared_buffer) {
+    StreamLoadPipe pipe;
+    auto buf = ByteBuffer::allocate(8);
+    buf->put_bytes("abcd", 4);
+    buf->flip();
+    EXPECT_TRUE(pipe.append(buf).ok());
+    EXPECT_TRUE(pipe.finish().ok());
+
+    std::unique_ptr<uint8_t[]> data;
+    size_t length = 0;
+    EXPECT_TRUE(pipe.read_one_message(&data, &length).ok());
+    EXPECT_NE(reinterpret_cast<uint8_t*>(buf->ptr), data.get());
+    EXPECT_EQ(4, length);
+    EXPECT_EQ(0, memcmp("abcd", data.get(), 4));
+    EXPECT_FALSE(buf->has_remaining());
+}
+
+} // namespace doris::io
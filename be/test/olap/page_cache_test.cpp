@@ -20,6 +20,10 @@
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "gtest/gtest_pred_impl.h"
 
 namespace doris {
@@ -248,4 +252,37 @@ TEST(StoragePageCacheTest, mixed_pages) {
     }
 }
 
+// A page is read by one reader at a time, the others wait and look it up afterwards
+TEST(StoragePageCacheTest, inflight_reads) {
+    StoragePageCache cache(kNumShards * 2048, 0, kNumShards);
+    StoragePageCache::CacheKey key("abc", 0);
+    StoragePageCache::CacheKey other_key("abc", 1);
+
+    EXPECT_TRUE(cache.begin_read(key));
+    // reads of other pages are not blocked
+    EXPECT_TRUE(cache.begin_read(other_key));
+    cache.end_read(other_key);
+
+    std::atomic<bool> waiter_done = false;
+    bool waiter_should_read = true;
+    std::thread waiter([&]() {
+        waiter_should_read = cache.begin_read(key);
+        waiter_done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(waiter_done);
+
+    PageCacheHandle handle;
+    cache.insert(key, Slice(new char[1024], 1024), &handle, segment_v2::DATA_PAGE, false);
+    cache.end_read(key);
+    waiter.join();
+    EXPECT_TRUE(waiter_done);
+    EXPECT_FALSE(waiter_should_read);
+    EXPECT_TRUE(cache.lookup(key, &handle, segment_v2::DATA_PAGE));
+
+    // the key is released, the next reader reads the page itself
+    EXPECT_TRUE(cache.begin_read(key));
+    cache.end_read(key);
+}
+
 } // namespace doris
@@ -42,18 +42,26 @@
 #include "gtest/gtest_pred_impl.h"
 #include "io/fs/local_file_system.h"
 #include "io/fs/s3_file_system.h"
+#include "olap/comparison_predicate.h"
 #include "olap/data_dir.h"
+#include "olap/late_arrival_predicates.h"
 #include "olap/olap_common.h"
 #include "olap/options.h"
 #include "olap/rowset/rowset.h"
+#include "olap/rowset/rowset_factory.h"
 #include "olap/rowset/rowset_meta.h"
 #include "olap/rowset/rowset_reader.h"
+#include "olap/rowset/rowset_reader_context.h"
+#include "olap/rowset/rowset_writer.h"
 #include "olap/rowset/rowset_writer_context.h"
 #include "olap/rowset/segment_v2/segment.h"
 #include "olap/storage_engine.h"
 #include "olap/tablet_schema.h"
 #include "runtime/exec_env.h"
 #include "util/s3_util.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
 
 namespace Aws {
 namespace S3 {
@@ -308,4 +316,76 @@ TEST_F(BetaRowsetTest, ReadTest) {
     }
 }
 
+TEST_F(BetaRowsetTest, LateArrivalPredicatesPruneUnreadRows) {
+    TabletSchemaSPtr tablet_schema = std::make_shared<TabletSchema>();
+    create_tablet_schema(tablet_schema);
+
+    // one segment of ascending k1, the zone maps of its pages don't overlap
+    const int32_t num_rows = 200000;
+    RowsetSharedPtr rowset;
+    {
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(tablet_schema, &writer_context);
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, false, &rowset_writer)
+                            .ok());
+
+        vectorized::Block block = tablet_schema->create_block();
+        auto columns = block.mutate_columns();
+        for (int32_t i = 0; i < num_rows; ++i) {
+            for (auto& column : columns) {
+                column->insert_data(reinterpret_cast<const char*>(&i), sizeof(i));
+            }
+        }
+        block.set_columns(std::move(columns));
+        ASSERT_TRUE(rowset_writer->add_block(&block).ok());
+        ASSERT_TRUE(rowset_writer->flush().ok());
+        rowset = rowset_writer->build();
+        ASSERT_NE(rowset, nullptr);
+        ASSERT_EQ(rowset->num_rows(), num_rows);
+    }
+
+    OlapReaderStatistics stats;
+    RowsetReaderContext reader_context;
+    reader_context.tablet_schema = tablet_schema;
+    reader_context.reader_type = READER_QUERY;
+    reader_context.need_ordered_result = false;
+    std::vector<uint32_t> return_columns = {0, 1, 2};
+    reader_context.return_columns = &return_columns;
+    reader_context.stats = &stats;
+    reader_context.late_arrival_predicates = std::make_shared<LateArrivalPredicates>();
+    RowsetReaderSharedPtr rowset_reader;
+    create_and_init_rowset_reader(rowset.get(), reader_context, &rowset_reader);
+
+    int32_t num_rows_read = 0;
+    int32_t max_k1 = -1;
+    Status st;
+    do {
+        vectorized::Block block = tablet_schema->create_block(return_columns);
+        st = rowset_reader->next_block(&block);
+        if (num_rows_read == 0) {
+            ASSERT_TRUE(st.ok()) << st;
+            // the runtime filter arrives after the first batch, k1 = 10 only matches the
+            // first page
+            reader_context.late_arrival_predicates->append(
+                    {new ComparisonPredicateBase<TYPE_INT, PredicateType::EQ>(0, 10)});
+        }
+        if (block.rows() > 0) {
+            const auto& k1 = assert_cast<const vectorized::ColumnNullable&>(
+                                     *block.get_by_position(0).column)
+                                     .get_nested_column();
+            max_k1 = std::max<int32_t>(max_k1, k1.get_int(block.rows() - 1));
+        }
+        num_rows_read += block.rows();
+    } while (st.ok());
+    EXPECT_TRUE(st.is<END_OF_FILE>()) << st;
+
+    // the rows of the first batch and the rest of the first page are read, the other pages
+    // are pruned by their zone maps
+    EXPECT_GT(num_rows_read, 0);
+    EXPECT_LT(num_rows_read, num_rows);
+    EXPECT_EQ(max_k1, num_rows_read - 1);
+    EXPECT_EQ(stats.rows_stats_filtered, num_rows - num_rows_read);
+}
+
 } // namespace doris
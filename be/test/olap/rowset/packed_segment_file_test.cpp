@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/packed_segment_file.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/file_reader.h"
+#include "io/fs/file_reader_options.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "util/slice.h"
+
+namespace doris {
+
+class PackedSegmentFileTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/packed_segment_file_test";
+
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+    }
+    void TearDown() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+    void write_file(const std::string& path, const std::string& content) {
+        io::FileWriterPtr file_writer;
+        ASSERT_TRUE(io::global_local_filesystem()->create_file(path, &file_writer).ok());
+        ASSERT_TRUE(file_writer->append(content).ok());
+        ASSERT_TRUE(file_writer->close().ok());
+    }
+};
+
+TEST_F(PackedSegmentFileTest, PackAndRead) {
+    io::FileSystemSPtr local_fs = io::global_local_filesystem();
+    std::string seg_content(3000, 'a');
+    std::string idx_content = "inverted index";
+    write_file(kTestDir + "/rs1_0.dat", seg_content);
+    write_file(kTestDir + "/rs1_0_10000.idx", idx_content);
+
+    std::string packed_path = kTestDir + "/rs1_packed.dat";
+    ASSERT_TRUE(PackedSegmentFile::pack(local_fs,
+                                        {kTestDir + "/rs1_0.dat", kTestDir + "/rs1_0_10000.idx"},
+                                        {"0.dat", "0_10000.idx"}, packed_path)
+                        .ok());
+
+    // packed under another rowset id, e.g. a hard link made by clone
+    std::shared_ptr<PackedSegmentFileSystem> packed_fs;
+    ASSERT_TRUE(PackedSegmentFileSystem::open(local_fs, packed_path, kTestDir, "rs2_",
+                                              io::FileReaderOptions::DEFAULT, &packed_fs)
+                        .ok());
+    EXPECT_EQ(2, packed_fs->entries().size());
+
+    bool exists = false;
+    EXPECT_TRUE(packed_fs->exists(kTestDir + "/rs2_0.dat", &exists).ok());
+    EXPECT_TRUE(exists);
+    EXPECT_TRUE(packed_fs->exists(kTestDir + "/rs1_0.dat", &exists).ok());
+    EXPECT_FALSE(exists);
+    EXPECT_TRUE(packed_fs->exists(kTestDir + "/rs2_1.dat", &exists).ok());
+    EXPECT_FALSE(exists);
+
+    int64_t file_size = 0;
+    EXPECT_TRUE(packed_fs->file_size(kTestDir + "/rs2_0_10000.idx", &file_size).ok());
+    EXPECT_EQ(idx_content.size(), file_size);
+
+    std::vector<io::FileInfo> files;
+    EXPECT_TRUE(packed_fs->list(kTestDir, true, &files, &exists).ok());
+    EXPECT_TRUE(exists);
+    EXPECT_EQ(2, files.size());
+
+    io::FileReaderSPtr file_reader;
+    ASSERT_TRUE(packed_fs->open_file(kTestDir + "/rs2_0_10000.idx", &file_reader).ok());
+    EXPECT_EQ(idx_content.size(), file_reader->size());
+    EXPECT_EQ(packed_fs, file_reader->fs());
+    std::string buf(100, '\0');
+    size_t bytes_read = 0;
+    // reads are bounded by the entry
+    EXPECT_TRUE(file_reader->read_at(9, Slice(buf.data(), buf.size()), &bytes_read).ok());
+    EXPECT_EQ(5, bytes_read);
+    EXPECT_EQ("index", buf.substr(0, bytes_read));
+
+    ASSERT_TRUE(packed_fs->open_file(kTestDir + "/rs2_0.dat", &file_reader).ok());
+    EXPECT_TRUE(file_reader->read_at(2990, Slice(buf.data(), buf.size()), &bytes_read).ok());
+    EXPECT_EQ(10, bytes_read);
+    EXPECT_EQ(std::string(10, 'a'), buf.substr(0, bytes_read));
+
+    EXPECT_FALSE(packed_fs->open_file(kTestDir + "/rs2_1.dat", &file_reader).ok());
+    EXPECT_FALSE(packed_fs->delete_file(kTestDir + "/rs2_0.dat").ok());
+}
+
+TEST_F(PackedSegmentFileTest, BadPackedFile) {
+    io::FileSystemSPtr local_fs = io::global_local_filesystem();
+    std::string packed_path = kTestDir + "/rs1_packed.dat";
+    write_file(packed_path, "not a packed segment file");
+    std::shared_ptr<PackedSegmentFileSystem> packed_fs;
+    auto st = PackedSegmentFileSystem::open(local_fs, packed_path, kTestDir, "rs1_",
+                                            io::FileReaderOptions::DEFAULT, &packed_fs);
+    EXPECT_TRUE(st.is<ErrorCode::CORRUPTION>()) << st;
+}
+
+} // namespace doris
@@ -0,0 +1,193 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/rowset/segment_v2/page_io.h"
+
+#include <gen_cpp/segment_v2.pb.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/file_reader.h"
+#include "io/fs/file_writer.h"
+#include "io/fs/local_file_system.h"
+#include "olap/olap_common.h"
+#include "olap/page_cache.h"
+#include "olap/rowset/segment_v2/page_handle.h"
+#include "olap/rowset/segment_v2/page_pointer.h"
+
+namespace doris {
+namespace segment_v2 {
+
+class PageIOTest : public testing::Test {
+public:
+    const std::string kTestDir = "./ut_dir/page_io_test";
+
+    void SetUp() override {
+        EXPECT_TRUE(io::global_local_filesystem()->delete_and_create_directory(kTestDir).ok());
+        // as if the page prefetcher is enabled
+        StoragePageCache::instance()->set_dedupe_inflight_reads(true);
+    }
+    void TearDown() override {
+        StoragePageCache::instance()->set_dedupe_inflight_reads(false);
+        EXPECT_TRUE(io::global_local_filesystem()->delete_directory(kTestDir).ok());
+    }
+
+    void write_page(const std::string& filename, io::FileReaderSPtr* file_reader,
+                    PagePointer* page_pointer) {
+        auto fs = io::global_local_filesystem();
+        std::string body(4096, 'x');
+        PageFooterPB footer;
+        footer.set_type(DATA_PAGE);
+        footer.set_uncompressed_size(body.size());
+        io::FileWriterPtr file_writer;
+        EXPECT_TRUE(fs->create_file(filename, &file_writer).ok());
+        EXPECT_TRUE(PageIO::write_page(file_writer.get(), {Slice(body)}, footer, page_pointer)
+                            .ok());
+        EXPECT_TRUE(file_writer->close().ok());
+        EXPECT_TRUE(fs->open_file(filename, file_reader).ok());
+    }
+
+    PageReadOptions read_options(io::FileReader* file_reader, const PagePointer& page_pointer,
+                                 OlapReaderStatistics* stats) {
+        PageReadOptions opts;
+        opts.file_reader = file_reader;
+        opts.page_pointer = page_pointer;
+        opts.stats = stats;
+        opts.type = DATA_PAGE;
+        return opts;
+    }
+};
+
+// A reader waits for the page being read by another thread and takes it from the page cache
+TEST_F(PageIOTest, wait_for_inflight_read) {
+    io::FileReaderSPtr file_reader;
+    PagePointer page_pointer;
+    write_page(kTestDir + "/wait_for_inflight_read.dat", &file_reader, &page_pointer);
+
+    auto cache = StoragePageCache::instance();
+    StoragePageCache::CacheKey cache_key(file_reader->path().native(), page_pointer.offset);
+    EXPECT_TRUE(cache->begin_read(cache_key));
+
+    OlapReaderStatistics stats;
+    Status st;
+    PageHandle handle;
+    Slice body;
+    PageFooterPB footer;
+    std::thread reader([&]() {
+        st = PageIO::read_and_decompress_page(
+                read_options(file_reader.get(), page_pointer, &stats), &handle, &body, &footer);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // read the page bypassing the cache and insert it, like the page prefetcher does
+    {
+        OlapReaderStatistics prefetch_stats;
+        auto opts = read_options(file_reader.get(), page_pointer, &prefetch_stats);
+        opts.use_page_cache = false;
+        PageHandle prefetch_handle;
+        Slice prefetch_body;
+        PageFooterPB prefetch_footer;
+        EXPECT_TRUE(PageIO::read_and_decompress_page(opts, &prefetch_handle, &prefetch_body,
+                                                     &prefetch_footer)
+                            .ok());
+        Slice page = prefetch_handle.data();
+        char* buf = new char[page.size];
+        memcpy(buf, page.data, page.size);
+        PageCacheHandle cache_handle;
+        cache->insert(cache_key, Slice(buf, page.size), &cache_handle, DATA_PAGE, false);
+    }
+    cache->end_read(cache_key);
+    reader.join();
+
+    EXPECT_TRUE(st.ok()) << st;
+    EXPECT_EQ(1, stats.cached_pages_num);
+    EXPECT_EQ(0, stats.compressed_bytes_read);
+    EXPECT_EQ(4096, body.size);
+    EXPECT_EQ(std::string(4096, 'x'), body.to_string());
+    EXPECT_EQ(4096, footer.uncompressed_size());
+}
+
+// Concurrent readers of a page missing in the page cache read it from the file only once
+TEST_F(PageIOTest, concurrent_reads_read_page_once) {
+    io::FileReaderSPtr file_reader;
+    PagePointer page_pointer;
+    write_page(kTestDir + "/concurrent_reads_read_page_once.dat", &file_reader, &page_pointer);
+
+    const int num_readers = 8;
+    std::vector<OlapReaderStatistics> stats(num_readers);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&, i]() {
+            PageHandle handle;
+            Slice body;
+            PageFooterPB footer;
+            EXPECT_TRUE(PageIO::read_and_decompress_page(
+                                read_options(file_reader.get(), page_pointer, &stats[i]),
+                                &handle, &body, &footer)
+                                .ok());
+            EXPECT_EQ(std::string(4096, 'x'), body.to_string());
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    int64_t compressed_bytes_read = 0;
+    int64_t cached_pages_num = 0;
+    for (auto& s : stats) {
+        compressed_bytes_read += s.compressed_bytes_read;
+        cached_pages_num += s.cached_pages_num;
+    }
+    EXPECT_EQ(static_cast<int64_t>(page_pointer.size), compressed_bytes_read);
+    EXPECT_EQ(num_readers - 1, cached_pages_num);
+}
+
+// Without the page prefetcher, a reader doesn't track or wait for in-flight reads
+TEST_F(PageIOTest, no_dedupe_without_prefetcher) {
+    StoragePageCache::instance()->set_dedupe_inflight_reads(false);
+    io::FileReaderSPtr file_reader;
+    PagePointer page_pointer;
+    write_page(kTestDir + "/no_dedupe_without_prefetcher.dat", &file_reader, &page_pointer);
+
+    auto cache = StoragePageCache::instance();
+    StoragePageCache::CacheKey cache_key(file_reader->path().native(), page_pointer.offset);
+    EXPECT_TRUE(cache->begin_read(cache_key));
+
+    OlapReaderStatistics stats;
+    PageHandle handle;
+    Slice body;
+    PageFooterPB footer;
+    EXPECT_TRUE(PageIO::read_and_decompress_page(
+                        read_options(file_reader.get(), page_pointer, &stats), &handle, &body,
+                        &footer)
+                        .ok());
+    EXPECT_EQ(0, stats.cached_pages_num);
+    EXPECT_EQ(static_cast<int64_t>(page_pointer.size), stats.compressed_bytes_read);
+    EXPECT_EQ(std::string(4096, 'x'), body.to_string());
+    cache->end_read(cache_key);
+}
+
+} // namespace segment_v2
+} // namespace doris
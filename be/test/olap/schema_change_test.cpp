@@ -0,0 +1,229 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/schema_change.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "runtime/memory/mem_tracker.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/assert_cast.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+
+namespace doris {
+
+class SchemaChangeRunWriterTest : public testing::Test {
+public:
+    static std::unique_ptr<vectorized::Block> create_block(int32_t id) {
+        auto column = vectorized::ColumnInt32::create();
+        for (int i = 0; i < 1024; ++i) {
+            column->insert_value(id);
+        }
+        auto block = vectorized::Block::create_unique();
+        block->insert({std::move(column), std::make_shared<vectorized::DataTypeInt32>(), "id"});
+        return block;
+    }
+
+    static int32_t block_id(const vectorized::Block& block) {
+        return assert_cast<const vectorized::ColumnInt32&>(*block.get_by_position(0).column)
+                .get_element(0);
+    }
+
+    // records the blocks of the runs and the max number of runs written concurrently
+    SchemaChangeRunWriter::WriteRunFunc write_run_func(int sleep_ms = 20) {
+        return [this, sleep_ms](const SchemaChangeRunWriter::Blocks& blocks, size_t run_index,
+                                RowsetSharedPtr* rowset, uint64_t* merged_rows) {
+            int running = ++_running;
+            int max_running = _max_running.load();
+            while (running > max_running &&
+                   !_max_running.compare_exchange_weak(max_running, running)) {
+            }
+            int64_t usage = SchemaChangeRunWriter::total_mem_usage();
+            int64_t max_usage = _max_total_mem_usage.load();
+            while (usage > max_usage &&
+                   !_max_total_mem_usage.compare_exchange_weak(max_usage, usage)) {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+            {
+                std::lock_guard<std::mutex> l(_lock);
+                if (_runs.size() <= run_index) {
+                    _runs.resize(run_index + 1);
+                }
+                for (const auto& block : blocks) {
+                    _runs[run_index].push_back(block_id(*block));
+                }
+            }
+            --_running;
+            *rowset = nullptr;
+            *merged_rows = 1;
+            if (_fail_run >= 0 && run_index == static_cast<size_t>(_fail_run)) {
+                return Status::InternalError("failed to write run");
+            }
+            return Status::OK();
+        };
+    }
+
+    // the runs hold the blocks in the order they are added
+    void check_runs(int num_blocks) {
+        std::vector<int32_t> ids;
+        for (const auto& run : _runs) {
+            EXPECT_FALSE(run.empty());
+            ids.insert(ids.end(), run.begin(), run.end());
+        }
+        ASSERT_EQ(num_blocks, ids.size());
+        for (int i = 0; i < num_blocks; ++i) {
+            EXPECT_EQ(i, ids[i]);
+        }
+    }
+
+protected:
+    std::atomic<int> _running = 0;
+    std::atomic<int> _max_running = 0;
+    std::atomic<int64_t> _max_total_mem_usage = 0;
+    int _fail_run = -1;
+    std::mutex _lock;
+    std::vector<std::vector<int32_t>> _runs;
+};
+
+TEST_F(SchemaChangeRunWriterTest, WriteRunsInParallel) {
+    const int64_t block_bytes = create_block(0)->allocated_bytes();
+    const int num_threads = 4;
+    const int num_blocks = 40;
+    // runs of 2 blocks
+    const int64_t mem_limit = block_bytes * 2 * (num_threads + 1);
+    MemTracker mem_tracker("SchemaChangeRunWriterTest");
+    std::vector<RowsetSharedPtr> rowsets;
+    uint64_t merged_rows = 0;
+    {
+        SchemaChangeRunWriter writer(num_threads, mem_limit, 0, &mem_tracker, write_run_func());
+        for (int i = 0; i < num_blocks; ++i) {
+            ASSERT_TRUE(writer.add_block(create_block(i)).ok());
+        }
+        ASSERT_TRUE(writer.finish(&rowsets, &merged_rows).ok());
+    }
+    EXPECT_EQ(num_blocks / 2, rowsets.size());
+    EXPECT_EQ(num_blocks / 2, _runs.size());
+    EXPECT_EQ(rowsets.size(), merged_rows);
+    check_runs(num_blocks);
+    EXPECT_GT(_max_running.load(), 1);
+    // the run being read and the runs in flight are bounded by the memory limit
+    EXPECT_LE(mem_tracker.peak_consumption(), mem_limit);
+    EXPECT_EQ(0, mem_tracker.consumption());
+    EXPECT_EQ(0, SchemaChangeRunWriter::total_mem_usage());
+}
+
+// Runs in flight can't take all the memory, reading waits for them to be written
+TEST_F(SchemaChangeRunWriterTest, WaitForRunsInFlight) {
+    const int64_t block_bytes = create_block(0)->allocated_bytes();
+    const int num_threads = 8;
+    const int num_blocks = 30;
+    // runs of a single block, at most 3 of them in memory
+    const int64_t mem_limit = block_bytes * 3;
+    MemTracker mem_tracker("SchemaChangeRunWriterTest");
+    std::vector<RowsetSharedPtr> rowsets;
+    uint64_t merged_rows = 0;
+    {
+        SchemaChangeRunWriter writer(num_threads, mem_limit, 0, &mem_tracker, write_run_func());
+        for (int i = 0; i < num_blocks; ++i) {
+            ASSERT_TRUE(writer.add_block(create_block(i)).ok());
+            EXPECT_LE(mem_tracker.consumption(), mem_limit);
+        }
+        ASSERT_TRUE(writer.finish(&rowsets, &merged_rows).ok());
+    }
+    EXPECT_EQ(num_blocks, rowsets.size());
+    check_runs(num_blocks);
+    EXPECT_LE(_max_running.load(), 3);
+    EXPECT_LE(mem_tracker.peak_consumption(), mem_limit);
+    EXPECT_EQ(0, mem_tracker.consumption());
+}
+
+// All sorting schema changes of the BE share the total memory limit
+TEST_F(SchemaChangeRunWriterTest, TotalMemLimit) {
+    const int64_t block_bytes = create_block(0)->allocated_bytes();
+    const int num_blocks = 20;
+    const int64_t total_mem_limit = block_bytes * 2;
+    MemTracker mem_tracker("SchemaChangeRunWriterTest");
+    std::vector<RowsetSharedPtr> rowsets;
+    uint64_t merged_rows = 0;
+    {
+        SchemaChangeRunWriter writer(4, block_bytes * 100, total_mem_limit, &mem_tracker,
+                                     write_run_func());
+        for (int i = 0; i < num_blocks; ++i) {
+            ASSERT_TRUE(writer.add_block(create_block(i)).ok());
+            EXPECT_LE(SchemaChangeRunWriter::total_mem_usage(), total_mem_limit);
+        }
+        ASSERT_TRUE(writer.finish(&rowsets, &merged_rows).ok());
+    }
+    check_runs(num_blocks);
+    EXPECT_LE(_max_total_mem_usage.load(), total_mem_limit);
+    EXPECT_EQ(0, SchemaChangeRunWriter::total_mem_usage());
+}
+
+// Without a pool the runs are written by the reading thread
+TEST_F(SchemaChangeRunWriterTest, WriteRunsInline) {
+    const int64_t block_bytes = create_block(0)->allocated_bytes();
+    const int num_blocks = 10;
+    MemTracker mem_tracker("SchemaChangeRunWriterTest");
+    std::vector<RowsetSharedPtr> rowsets;
+    uint64_t merged_rows = 0;
+    {
+        SchemaChangeRunWriter writer(1, block_bytes * 3, 0, &mem_tracker, write_run_func(0));
+        for (int i = 0; i < num_blocks; ++i) {
+            ASSERT_TRUE(writer.add_block(create_block(i)).ok());
+        }
+        ASSERT_TRUE(writer.finish(&rowsets, &merged_rows).ok());
+    }
+    // runs of 3 blocks
+    EXPECT_EQ(4, rowsets.size());
+    check_runs(num_blocks);
+    EXPECT_EQ(1, _max_running.load());
+    EXPECT_EQ(0, mem_tracker.consumption());
+}
+
+TEST_F(SchemaChangeRunWriterTest, RunFailed) {
+    const int64_t block_bytes = create_block(0)->allocated_bytes();
+    _fail_run = 2;
+    MemTracker mem_tracker("SchemaChangeRunWriterTest");
+    {
+        SchemaChangeRunWriter writer(2, block_bytes * 3, 0, &mem_tracker, write_run_func());
+        Status st;
+        for (int i = 0; i < 20 && st.ok(); ++i) {
+            st = writer.add_block(create_block(i));
+        }
+        if (st.ok()) {
+            std::vector<RowsetSharedPtr> rowsets;
+            uint64_t merged_rows = 0;
+            st = writer.finish(&rowsets, &merged_rows);
+        }
+        EXPECT_FALSE(st.ok());
+    }
+    EXPECT_EQ(0, mem_tracker.consumption());
+    EXPECT_EQ(0, SchemaChangeRunWriter::total_mem_usage());
+}
+
+} // namespace doris
@@ -245,4 +245,31 @@ TEST(TabletMetaTest, TestDeleteBitmap) {
     }
 }
 
+TEST(TabletMetaTest, TestFoldDeleteBitmapVersions) {
+    DeleteBitmap dbmp(10087);
+    RowsetId rowset_id {2, 0, 1, 1};
+    for (uint32_t ver = 1; ver <= 10; ++ver) {
+        dbmp.add({rowset_id, 0, ver}, ver);
+        dbmp.add({rowset_id, 1, ver}, ver + 100);
+    }
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 20);
+
+    EXPECT_EQ(dbmp.fold_versions(6), 10);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 10);
+    EXPECT_EQ(dbmp.get({rowset_id, 0, 6})->cardinality(), 6);
+    EXPECT_EQ(dbmp.get({rowset_id, 1, 6})->cardinality(), 6);
+    EXPECT_EQ(dbmp.get({rowset_id, 0, 1}), nullptr);
+    EXPECT_EQ(dbmp.get({rowset_id, 0, 7})->cardinality(), 1);
+
+    // versions >= the folded version see the same rows
+    EXPECT_TRUE(dbmp.contains_agg({rowset_id, 0, 6}, 1));
+    EXPECT_TRUE(dbmp.contains_agg({rowset_id, 1, 10}, 110));
+    EXPECT_EQ(dbmp.get_agg({rowset_id, 1, 10})->cardinality(), 10);
+
+    // nothing left to fold
+    EXPECT_EQ(dbmp.fold_versions(6), 0);
+    EXPECT_EQ(dbmp.fold_versions(7), 2);
+    ASSERT_EQ(dbmp.delete_bitmap.size(), 8);
+}
+
 } // namespace doris
@@ -254,6 +254,65 @@ TEST_F(TabletMgrTest, DropTablet) {
     EXPECT_FALSE(dir_exist);
 }
 
+TEST_F(TabletMgrTest, LazyLoadTablet) {
+    TColumnType col_type;
+    col_type.__set_type(TPrimitiveType::SMALLINT);
+    TColumn col1;
+    col1.__set_column_name("col1");
+    col1.__set_column_type(col_type);
+    col1.__set_is_key(true);
+    std::vector<TColumn> cols;
+    cols.push_back(col1);
+    TTabletSchema tablet_schema;
+    tablet_schema.__set_short_key_column_count(1);
+    tablet_schema.__set_schema_hash(3333);
+    tablet_schema.__set_keys_type(TKeysType::AGG_KEYS);
+    tablet_schema.__set_storage_type(TStorageType::COLUMN);
+    tablet_schema.__set_columns(cols);
+    TCreateTabletReq create_tablet_req;
+    create_tablet_req.__set_tablet_schema(tablet_schema);
+    create_tablet_req.__set_tablet_id(112);
+    create_tablet_req.__set_version(2);
+    std::vector<DataDir*> data_dirs;
+    data_dirs.push_back(_data_dir);
+    Status create_st = _tablet_mgr->create_tablet(create_tablet_req, data_dirs);
+    EXPECT_TRUE(create_st == Status::OK());
+    TabletSharedPtr tablet = _tablet_mgr->get_tablet(112);
+    EXPECT_TRUE(tablet != nullptr);
+    std::string meta_binary;
+    EXPECT_TRUE(tablet->tablet_meta()->serialize(&meta_binary).ok());
+    Status drop_st = _tablet_mgr->drop_tablet(112, create_tablet_req.replica_id, false);
+    EXPECT_TRUE(drop_st == Status::OK());
+    tablet.reset();
+
+    // load the tablet again without init
+    Status load_st = _tablet_mgr->load_tablet_from_meta(_data_dir, 112, 3333, meta_binary, false,
+                                                        false, false, false, true);
+    EXPECT_TRUE(load_st.ok()) << load_st;
+    auto tablets = _tablet_mgr->get_all_tablet([](Tablet* t) { return t->tablet_id() == 112; });
+    EXPECT_EQ(1, tablets.size());
+    EXPECT_FALSE(tablets[0]->init_succeeded());
+
+    // get_tablet_without_init() doesn't init the tablet
+    tablet = _tablet_mgr->get_tablet_without_init(112);
+    EXPECT_TRUE(tablet != nullptr);
+    EXPECT_FALSE(tablet->init_succeeded());
+    tablet.reset();
+
+    // get_tablet() inits the tablet
+    tablet = _tablet_mgr->get_tablet(112);
+    EXPECT_TRUE(tablet != nullptr);
+    EXPECT_TRUE(tablet->init_succeeded());
+    EXPECT_TRUE(tablet->rowset_with_max_version() != nullptr);
+
+    drop_st = _tablet_mgr->drop_tablet(112, create_tablet_req.replica_id, false);
+    EXPECT_TRUE(drop_st == Status::OK());
+    tablets.clear();
+    tablet.reset();
+    Status trash_st = _tablet_mgr->start_trash_sweep();
+    EXPECT_TRUE(trash_st == Status::OK());
+}
+
 TEST_F(TabletMgrTest, GetRowsetId) {
     // normal case
     {
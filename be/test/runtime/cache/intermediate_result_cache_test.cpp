@@ -0,0 +1,240 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/cache/intermediate_result_cache.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris {
+
+static vectorized::Block create_block(int start, int rows) {
+    auto int_column = vectorized::ColumnVector<vectorized::Int32>::create();
+    auto string_column = vectorized::ColumnString::create();
+    for (int i = start; i < start + rows; ++i) {
+        int_column->insert_value(i);
+        std::string str = "value_" + std::to_string(i);
+        string_column->insert_data(str.data(), str.size());
+    }
+    vectorized::Block block;
+    block.insert({std::move(int_column), std::make_shared<vectorized::DataTypeInt32>(), "int"});
+    block.insert(
+            {std::move(string_column), std::make_shared<vectorized::DataTypeString>(), "string"});
+    return block;
+}
+
+TEST(IntermediateResultCacheTest, AppendBlock) {
+    auto src = create_block(0, 10);
+    auto dst = src.clone_empty();
+    IntermediateResultCache::append_block(src, &dst);
+    IntermediateResultCache::append_block(create_block(10, 5), &dst);
+    ASSERT_EQ(15, dst.rows());
+    for (int i = 0; i < 15; ++i) {
+        EXPECT_EQ(i, dst.get_by_position(0).column->get_int(i));
+        EXPECT_EQ("value_" + std::to_string(i),
+                  dst.get_by_position(1).column->get_data_at(i).to_string());
+    }
+    // the copy does not share columns with the source
+    src.clear();
+    EXPECT_EQ(15, dst.rows());
+}
+
+TEST(IntermediateResultCacheTest, LookupAndInsert) {
+    if (IntermediateResultCache::instance() == nullptr) {
+        IntermediateResultCache::create_global_cache(1024 * 1024);
+    }
+    auto cache = IntermediateResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+
+    IntermediateResultCache::Key key(1, 10001, 3);
+    IntermediateResultCache::CacheHandle handle;
+    EXPECT_FALSE(cache->lookup(key, &handle));
+
+    IntermediateResultCache::Blocks blocks;
+    blocks.push_back(create_block(0, 100));
+    blocks.push_back(create_block(100, 50));
+    cache->insert(key, std::move(blocks));
+
+    ASSERT_TRUE(cache->lookup(key, &handle));
+    ASSERT_TRUE(handle.valid());
+    ASSERT_EQ(2, handle.blocks().size());
+    EXPECT_EQ(100, handle.blocks()[0].rows());
+    EXPECT_EQ(50, handle.blocks()[1].rows());
+
+    // any part of the key differs
+    IntermediateResultCache::CacheHandle other;
+    EXPECT_FALSE(cache->lookup({2, 10001, 3}, &other));
+    EXPECT_FALSE(cache->lookup({1, 10002, 3}, &other));
+    EXPECT_FALSE(cache->lookup({1, 10001, 4}, &other));
+}
+
+TEST(IntermediateResultCacheTest, RowsetKey) {
+    if (IntermediateResultCache::instance() == nullptr) {
+        IntermediateResultCache::create_global_cache(1024 * 1024);
+    }
+    auto cache = IntermediateResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+
+    RowsetId rowset_id;
+    rowset_id.init(2, 100, 0, 0);
+    RowsetId other_rowset_id;
+    other_rowset_id.init(2, 101, 0, 0);
+
+    IntermediateResultCache::Blocks blocks;
+    blocks.push_back(create_block(0, 10));
+    cache->insert({7, rowset_id}, std::move(blocks));
+    // an empty rowset is cached without blocks
+    cache->insert({7, other_rowset_id}, {});
+
+    IntermediateResultCache::CacheHandle handle;
+    ASSERT_TRUE(cache->lookup({7, rowset_id}, &handle));
+    ASSERT_EQ(1, handle.blocks().size());
+    EXPECT_EQ(10, handle.blocks()[0].rows());
+    ASSERT_TRUE(cache->lookup({7, other_rowset_id}, &handle));
+    EXPECT_TRUE(handle.blocks().empty());
+    EXPECT_FALSE(cache->lookup({8, rowset_id}, &handle));
+}
+
+// The rowsets of a scanner are looked up in order, the hit ones are replayed and the missed
+// ones are read and cached one by one.
+TEST(IntermediateResultCacheTest, ScanContextByRowset) {
+    if (IntermediateResultCache::instance() == nullptr) {
+        IntermediateResultCache::create_global_cache(1024 * 1024);
+    }
+    auto cache = IntermediateResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+
+    std::vector<RowsetId> rowset_ids(4);
+    for (size_t i = 0; i < rowset_ids.size(); ++i) {
+        rowset_ids[i].init(2, 200 + i, 0, 0);
+    }
+    const int64_t digest = 11;
+    // the first scan misses all rowsets and caches them
+    {
+        ResultCacheScanContext ctx(cache, 1024 * 1024);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_FALSE(ctx.lookup(IntermediateResultCache::RowsetKey(digest, rowset_ids[i])));
+        }
+        for (int i = 0; i < 3; ++i) {
+            ctx.begin_entry();
+            EXPECT_TRUE(ctx.copying());
+            ctx.add_block(create_block(i * 100, 10));
+            ctx.add_block(create_block(i * 100 + 10, 10));
+            ctx.finish_entry(IntermediateResultCache::RowsetKey(digest, rowset_ids[i]));
+            EXPECT_FALSE(ctx.copying());
+        }
+        auto block = create_block(0, 0);
+        EXPECT_FALSE(ctx.next_cached_block(&block));
+    }
+    // a new rowset is added, only it is read
+    {
+        ResultCacheScanContext ctx(cache, 1024 * 1024);
+        std::vector<size_t> missed;
+        for (size_t i = 0; i < rowset_ids.size(); ++i) {
+            if (!ctx.lookup(IntermediateResultCache::RowsetKey(digest, rowset_ids[i]))) {
+                missed.push_back(i);
+            }
+        }
+        ASSERT_EQ(1, missed.size());
+        EXPECT_EQ(3, missed[0]);
+
+        // the cached rowsets are replayed in order
+        auto block = create_block(0, 0);
+        while (ctx.next_cached_block(&block)) {
+        }
+        ASSERT_EQ(60, block.rows());
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 20; ++j) {
+                EXPECT_EQ(i * 100 + j, block.get_by_position(0).column->get_int(i * 20 + j));
+            }
+        }
+
+        // an empty rowset is cached too
+        ctx.begin_entry();
+        ctx.add_block(create_block(0, 0));
+        ctx.finish_entry(IntermediateResultCache::RowsetKey(digest, rowset_ids[3]));
+    }
+    IntermediateResultCache::CacheHandle handle;
+    ASSERT_TRUE(cache->lookup(IntermediateResultCache::RowsetKey(digest, rowset_ids[3]), &handle));
+    EXPECT_TRUE(handle.blocks().empty());
+    // another plan doesn't hit the entries
+    EXPECT_FALSE(
+            cache->lookup(IntermediateResultCache::RowsetKey(digest + 1, rowset_ids[0]), &handle));
+}
+
+// The output larger than the max entry bytes is not cached
+TEST(IntermediateResultCacheTest, ScanContextEntryTooLarge) {
+    if (IntermediateResultCache::instance() == nullptr) {
+        IntermediateResultCache::create_global_cache(1024 * 1024);
+    }
+    auto cache = IntermediateResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+
+    auto block = create_block(0, 100);
+    ResultCacheScanContext ctx(cache, block.allocated_bytes() * 2);
+    IntermediateResultCache::Key key(12, 10001, 5);
+    EXPECT_FALSE(ctx.lookup(key));
+    ctx.begin_entry();
+    for (int i = 0; i < 3; ++i) {
+        ctx.add_block(block);
+    }
+    EXPECT_FALSE(ctx.copying());
+    ctx.finish_entry(key);
+    EXPECT_FALSE(ctx.lookup(key));
+
+    // the next entry is cached again
+    ctx.begin_entry();
+    ctx.add_block(block);
+    ctx.finish_entry(key);
+    EXPECT_TRUE(ctx.lookup(key));
+    auto replayed = block.clone_empty();
+    ASSERT_TRUE(ctx.next_cached_block(&replayed));
+    EXPECT_EQ(100, replayed.rows());
+    EXPECT_FALSE(ctx.next_cached_block(&replayed));
+}
+
+TEST(IntermediateResultCacheTest, MemTracking) {
+    if (IntermediateResultCache::instance() == nullptr) {
+        IntermediateResultCache::create_global_cache(1024 * 1024);
+    }
+    auto cache = IntermediateResultCache::instance();
+    ASSERT_NE(nullptr, cache);
+
+    int64_t consumption = cache->mem_consumption();
+    IntermediateResultCache::Blocks blocks;
+    blocks.push_back(create_block(0, 1000));
+    int64_t bytes = blocks[0].allocated_bytes();
+    cache->insert({9, 10001, 1}, std::move(blocks));
+#ifdef USE_MEM_TRACKER
+    // the cached blocks are consumed by the cache's tracker
+    EXPECT_GE(cache->mem_consumption() - consumption, bytes);
+#endif
+    IntermediateResultCache::CacheHandle handle;
+    ASSERT_TRUE(cache->lookup({9, 10001, 1}, &handle));
+    EXPECT_EQ(bytes, handle.blocks()[0].allocated_bytes());
+}
+
+} // namespace doris
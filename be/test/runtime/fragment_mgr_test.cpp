@@ -28,8 +28,11 @@
 #include "common/config.h"
 #include "exec/data_sink.h"
 #include "gtest/gtest_pred_impl.h"
+#include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/memory/mem_tracker_limiter.h"
 #include "runtime/plan_fragment_executor.h"
+#include "runtime/query_context.h"
 #include "runtime/runtime_state.h"
 
 namespace doris {
@@ -145,4 +148,67 @@ TEST_F(FragmentMgrTest, OfferPoolFailed) {
     }
 }
 
+static TExecPlanFragmentParams create_desc_tbl_params(int64_t digest, int num_tuples) {
+    TExecPlanFragmentParams params;
+    for (int i = 0; i < num_tuples; ++i) {
+        TTupleDescriptor tuple_desc;
+        tuple_desc.__set_id(i);
+        tuple_desc.__set_byteSize(0);
+        tuple_desc.__set_numNullBytes(0);
+        params.desc_tbl.tupleDescriptors.push_back(tuple_desc);
+    }
+    params.__set_desc_tbl_digest(digest);
+    return params;
+}
+
+static std::shared_ptr<QueryContext> get_desc_tbl(FragmentMgr* mgr,
+                                                  const TExecPlanFragmentParams& params) {
+    auto query_ctx = QueryContext::create_shared(1, nullptr, TQueryOptions());
+    query_ctx->query_mem_tracker =
+            std::make_shared<MemTrackerLimiter>(MemTrackerLimiter::Type::QUERY, "DescTblCache");
+    EXPECT_TRUE(mgr->_get_desc_tbl(params, query_ctx.get()).ok());
+    return query_ctx;
+}
+
+TEST_F(FragmentMgrTest, DescTblCache) {
+    config::fragment_desc_tbl_cache_capacity = 2;
+    FragmentMgr mgr(nullptr);
+
+    // hit
+    auto ctx1 = get_desc_tbl(&mgr, create_desc_tbl_params(1, 1));
+    auto ctx2 = get_desc_tbl(&mgr, create_desc_tbl_params(1, 1));
+    EXPECT_TRUE(ctx1->desc_tbl != nullptr);
+    EXPECT_EQ(ctx1->desc_tbl, ctx2->desc_tbl);
+    EXPECT_EQ(ctx1->shared_desc_tbl_pool, ctx2->shared_desc_tbl_pool);
+
+    // miss
+    auto ctx3 = get_desc_tbl(&mgr, create_desc_tbl_params(2, 1));
+    EXPECT_NE(ctx1->desc_tbl, ctx3->desc_tbl);
+
+    // a collision of the digests is rebuilt and replaces the cached table
+    auto ctx4 = get_desc_tbl(&mgr, create_desc_tbl_params(1, 2));
+    EXPECT_NE(ctx1->desc_tbl, ctx4->desc_tbl);
+    EXPECT_TRUE(ctx4->desc_tbl->get_tuple_descriptor(1) != nullptr);
+    auto ctx5 = get_desc_tbl(&mgr, create_desc_tbl_params(1, 2));
+    EXPECT_EQ(ctx4->desc_tbl, ctx5->desc_tbl);
+
+    // digest 1 is used after digest 2, so digest 2 is evicted by digest 3
+    auto ctx6 = get_desc_tbl(&mgr, create_desc_tbl_params(3, 1));
+    EXPECT_EQ(2, mgr._desc_tbl_cache.size());
+    EXPECT_FALSE(mgr._desc_tbl_cache.exists(2));
+    auto ctx7 = get_desc_tbl(&mgr, create_desc_tbl_params(2, 1));
+    EXPECT_NE(ctx3->desc_tbl, ctx7->desc_tbl);
+    // an evicted table lives as long as its queries
+    EXPECT_TRUE(ctx3->desc_tbl->get_tuple_descriptor(0) != nullptr);
+
+    // no caching without a digest
+    TExecPlanFragmentParams params = create_desc_tbl_params(1, 2);
+    params.__isset.desc_tbl_digest = false;
+    auto ctx8 = get_desc_tbl(&mgr, params);
+    EXPECT_NE(ctx5->desc_tbl, ctx8->desc_tbl);
+    EXPECT_EQ(nullptr, ctx8->shared_desc_tbl_pool);
+
+    config::fragment_desc_tbl_cache_capacity = 1024;
+}
+
 } // namespace doris
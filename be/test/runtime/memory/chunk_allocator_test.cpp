@@ -19,6 +19,11 @@
 
 #include <gtest/gtest.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "common/config.h"
 #include "common/status.h"
 #include "runtime/memory/chunk.h"
@@ -36,4 +41,119 @@ TEST(ChunkAllocatorTest, Normal) {
         ChunkAllocator::instance()->free(chunk);
     }
 }
+
+TEST(ChunkAllocatorTest, ThreadCache) {
+    auto allocator = ChunkAllocator::instance();
+    allocator->clear();
+    int64_t thread_cache_bytes = config::chunk_allocator_thread_cache_bytes;
+    size_t reserve_bytes_limit = allocator->_reserve_bytes_limit;
+    config::chunk_allocator_thread_cache_bytes = 2L << 20;
+    allocator->_reserve_bytes_limit = 64L << 20;
+
+    // run in a new thread to start with an empty thread cache
+    std::thread thread([allocator]() {
+        Chunk chunk;
+        ASSERT_TRUE(allocator->allocate_align(8192, &chunk).ok());
+        uint8_t* data = chunk.data;
+        allocator->free(chunk);
+        // reused from the thread cache
+        ASSERT_TRUE(allocator->allocate_align(8192, &chunk).ok());
+        EXPECT_EQ(data, chunk.data);
+        allocator->free(chunk);
+
+        // overflow the thread cache, the oldest chunks are returned in batches
+        std::vector<Chunk> chunks(100);
+        for (auto& c : chunks) {
+            ASSERT_TRUE(allocator->allocate_align(16384, &c).ok());
+        }
+        for (auto& c : chunks) {
+            allocator->free(c);
+        }
+        ASSERT_TRUE(allocator->allocate_align(16384, &chunk).ok());
+        EXPECT_EQ(chunks.back().data, chunk.data);
+        allocator->free(chunk);
+    });
+    thread.join();
+    // the cached chunks are returned to the arenas when the thread exits
+    EXPECT_EQ(0, allocator->_thread_cached_bytes.load());
+    EXPECT_EQ(100 * 16384 + 8192, allocator->mem_consumption());
+    allocator->clear();
+    EXPECT_EQ(0, allocator->mem_consumption());
+
+    config::chunk_allocator_thread_cache_bytes = thread_cache_bytes;
+    allocator->_reserve_bytes_limit = reserve_bytes_limit;
+}
+
+TEST(ChunkAllocatorTest, ClearIdleThreadCache) {
+    auto allocator = ChunkAllocator::instance();
+    allocator->clear();
+    int64_t thread_cache_bytes = config::chunk_allocator_thread_cache_bytes;
+    int64_t consume_min_size_bytes = config::mem_tracker_consume_min_size_bytes;
+    size_t reserve_bytes_limit = allocator->_reserve_bytes_limit;
+    config::chunk_allocator_thread_cache_bytes = 2L << 20;
+    config::mem_tracker_consume_min_size_bytes = 1;
+    allocator->_reserve_bytes_limit = 64L << 20;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool cached = false;
+    bool cleared = false;
+    std::thread thread([&]() {
+        Chunk chunk;
+        ASSERT_TRUE(allocator->allocate_align(8192, &chunk).ok());
+        allocator->free(chunk);
+        std::unique_lock<std::mutex> l(mutex);
+        cached = true;
+        cv.notify_all();
+        // stay idle until the cache is cleared by another thread
+        cv.wait(l, [&]() { return cleared; });
+    });
+    {
+        std::unique_lock<std::mutex> l(mutex);
+        cv.wait(l, [&]() { return cached; });
+    }
+    // the chunk cached by the idle thread is counted and freed
+    EXPECT_EQ(8192, allocator->mem_consumption());
+    allocator->clear();
+    EXPECT_EQ(0, allocator->mem_consumption());
+    {
+        std::lock_guard<std::mutex> l(mutex);
+        cleared = true;
+        cv.notify_all();
+    }
+    thread.join();
+
+    config::chunk_allocator_thread_cache_bytes = thread_cache_bytes;
+    config::mem_tracker_consume_min_size_bytes = consume_min_size_bytes;
+    allocator->_reserve_bytes_limit = reserve_bytes_limit;
+}
+
+TEST(ChunkAllocatorTest, ThreadCacheInReserveLimit) {
+    auto allocator = ChunkAllocator::instance();
+    allocator->clear();
+    int64_t thread_cache_bytes = config::chunk_allocator_thread_cache_bytes;
+    int64_t consume_min_size_bytes = config::mem_tracker_consume_min_size_bytes;
+    size_t reserve_bytes_limit = allocator->_reserve_bytes_limit;
+    config::chunk_allocator_thread_cache_bytes = 2L << 20;
+    config::mem_tracker_consume_min_size_bytes = 1;
+    allocator->_reserve_bytes_limit = 16384;
+
+    std::thread thread([allocator]() {
+        std::vector<Chunk> chunks(4);
+        for (auto& c : chunks) {
+            ASSERT_TRUE(allocator->allocate_align(8192, &c).ok());
+        }
+        for (auto& c : chunks) {
+            allocator->free(c);
+        }
+        // only two chunks fit in the reserve limit, the others are freed to the system
+        EXPECT_EQ(16384, allocator->mem_consumption());
+    });
+    thread.join();
+    allocator->clear();
+
+    config::chunk_allocator_thread_cache_bytes = thread_cache_bytes;
+    config::mem_tracker_consume_min_size_bytes = consume_min_size_bytes;
+    allocator->_reserve_bytes_limit = reserve_bytes_limit;
+}
 } // namespace doris
@@ -0,0 +1,116 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/memory/mem_reservation.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+
+#include "common/config.h"
+#include "gtest/gtest_pred_impl.h"
+#include "util/runtime_profile.h"
+
+namespace doris {
+
+TEST(MemReservationTest, Hierarchy) {
+    auto root = std::make_shared<MemReservation>("root", 1000, nullptr);
+    auto group = std::make_shared<MemReservation>("group", 600, root);
+    auto query1 = std::make_shared<MemReservation>("query1", 500, group);
+    auto query2 = std::make_shared<MemReservation>("query2", -1, group);
+
+    EXPECT_TRUE(query1->try_reserve(400));
+    // exceeds the limit of query1
+    EXPECT_FALSE(query1->try_reserve(200));
+    // exceeds the limit of group, query2 is rolled back
+    EXPECT_FALSE(query2->try_reserve(300));
+    EXPECT_EQ(0, query2->reserved());
+    EXPECT_TRUE(query2->try_reserve(200));
+    EXPECT_EQ(600, group->reserved());
+    EXPECT_EQ(600, root->reserved());
+
+    query1->release(400);
+    EXPECT_EQ(0, query1->reserved());
+    EXPECT_EQ(200, group->reserved());
+    EXPECT_EQ(200, root->reserved());
+    query2->release(200);
+    EXPECT_EQ(0, root->reserved());
+}
+
+TEST(MemReservationTest, FairShare) {
+    auto old_watermark = config::mem_reservation_fair_share_watermark_percent;
+    config::mem_reservation_fair_share_watermark_percent = 80;
+    auto root = std::make_shared<MemReservation>("root", 1000, nullptr);
+    auto group1 = std::make_shared<MemReservation>("group1", -1, root, 1);
+    auto group2 = std::make_shared<MemReservation>("group2", -1, root, 3);
+
+    // group1 may use the spare memory before root is nearly full
+    EXPECT_TRUE(group1->try_reserve(700));
+    EXPECT_TRUE(group2->try_reserve(100));
+    // then each group is limited to its fair share, 250 and 750
+    EXPECT_FALSE(group1->try_reserve(10));
+    EXPECT_TRUE(group2->try_reserve(150));
+    // exceeds the limit of root
+    EXPECT_FALSE(group2->try_reserve(100));
+    EXPECT_EQ(250, group2->reserved());
+
+    // the fair shares of both groups become 500
+    group2->set_share(1);
+    group1->release(250);
+    EXPECT_TRUE(group2->try_reserve(100));
+    EXPECT_TRUE(group1->try_reserve(40));
+    EXPECT_FALSE(group1->try_reserve(20));
+
+    group1->release(490);
+    group2->release(350);
+    EXPECT_EQ(0, root->reserved());
+    config::mem_reservation_fair_share_watermark_percent = old_watermark;
+}
+
+TEST(MemReservationTest, OperatorMemReservation) {
+    RuntimeProfile profile("test");
+    auto query = std::make_shared<MemReservation>("query", 1000, nullptr);
+    {
+        OperatorMemReservation op;
+        op.init(query, &profile);
+        EXPECT_TRUE(op.reserve_to(600));
+        EXPECT_TRUE(op.try_reserve(300));
+        EXPECT_FALSE(op.reserve_to(1100));
+        EXPECT_EQ(900, op.reserved());
+        EXPECT_TRUE(op.reserve_to(100));
+        EXPECT_EQ(100, query->reserved());
+        EXPECT_EQ(900, profile.get_counter("MemReserved")->value());
+        EXPECT_EQ(1, profile.get_counter("MemReservationDenied")->value());
+    }
+    // released when destroyed
+    EXPECT_EQ(0, query->reserved());
+
+    // reserves nothing without a reservation
+    OperatorMemReservation op;
+    op.init(nullptr, &profile);
+    EXPECT_TRUE(op.reserve_to(1L << 40));
+
+    // no counters without a profile
+    OperatorMemReservation no_profile;
+    no_profile.init(query, nullptr);
+    EXPECT_TRUE(no_profile.reserve_to(800));
+    EXPECT_FALSE(no_profile.reserve_to(1100));
+    EXPECT_EQ(800, query->reserved());
+}
+
+} // namespace doris
@@ -27,9 +27,11 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "common/compiler_util.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/split.h"
 #include "gutil/strings/substitute.h"
@@ -50,16 +52,33 @@
 #include "olap/tablet_schema.h"
 #include "olap/tablet_schema_helper.h"
 #include "olap/types.h"
+#include "runtime/memory/chunk_allocator.h"
 #include "testutil/test_util.h"
+#include "util/cpu_info.h"
 #include "util/debug_util.h"
+#include "util/hash_util.hpp"
+#include "util/sharded_map.h"
+#include "vec/columns/column_object.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/common/pod_array.h"
+#include "vec/core/block.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+#include "vec/json/json_parser.h"
+#include "vec/json/parse2column.h"
+#include "vec/json/simd_json_parser.h"
 
 DEFINE_string(operation, "Custom",
               "valid operation: Custom, BinaryDictPageEncode, BinaryDictPageDecode, SegmentScan, "
               "SegmentWrite, "
-              "SegmentScanByFile, SegmentWriteByFile");
+              "SegmentScanByFile, SegmentWriteByFile, JsonToVariant, SortBlock, "
+              "FragmentRegistry, PODArrayGrowth");
 DEFINE_string(input_file, "./sample.dat", "input file directory");
 DEFINE_string(column_type, "int,varchar", "valid type: int, char, varchar, string");
 DEFINE_string(rows_number, "10000", "rows number");
+DEFINE_string(json_keys, "200", "number of keys in each json document");
 DEFINE_string(iterations, "10",
               "run times, this is set to 0 means the number of iterations is automatically set ");
 
@@ -84,6 +103,11 @@ std::string get_usage(const std::string& progname) {
           "--iterations=10\n";
     ss << "./benchmark_tool --operation=SegmentWriteByFile --input_file=./sample.dat "
           "--iterations=10\n";
+    ss << "./benchmark_tool --operation=JsonToVariant --rows_number=10000 --json_keys=200 "
+          "--iterations=10\n";
+    ss << "./benchmark_tool --operation=SortBlock --rows_number=1000000 --iterations=10\n";
+    ss << "./benchmark_tool --operation=FragmentRegistry --rows_number=100000 --iterations=10\n";
+    ss << "./benchmark_tool --operation=PODArrayGrowth --rows_number=100000000 --iterations=10\n";
 
     ss << "Sampe data file format: \n"
        << "The first line defines Shcema\n"
@@ -107,6 +131,8 @@ public:
 
     virtual void init() {}
     virtual void run() {}
+    // number of items processed by one run, reported as items per second
+    virtual int64_t items_per_run() { return 0; }
 
     void register_bm() {
         auto bm = benchmark::RegisterBenchmark(_name.c_str(), [&](benchmark::State& state) {
@@ -119,6 +145,9 @@ public:
                 state.ResumeTiming();
                 this->run();
             }
+            if (this->items_per_run() > 0) {
+                state.SetItemsProcessed(state.iterations() * this->items_per_run());
+            }
         });
         if (_iterations != 0) {
             bm->Iterations(_iterations);
@@ -495,6 +524,216 @@ private:
     OlapReaderStatistics stats;
 };
 
+// Parse json documents into a variant column, items per second is documents per second.
+// `by_field` parses with JSONDataParser which boxes every value into Field, otherwise
+// JSONToVariantParser is used.
+class JsonToVariantBenchmark : public BaseBenchmark {
+public:
+    JsonToVariantBenchmark(const std::string& name, int iterations, int rows_num, int keys_num,
+                           bool by_field)
+            : BaseBenchmark(name, iterations), _by_field(by_field) {
+        std::mt19937 rng(rows_num);
+        for (int i = 0; i < rows_num; ++i) {
+            std::stringstream ss;
+            ss << "{";
+            for (int k = 0; k < keys_num; ++k) {
+                if (k > 0) {
+                    ss << ",";
+                }
+                // mix of integers, doubles, strings, bools and nested objects
+                switch (k % 5) {
+                case 0:
+                    ss << "\"int_" << k << "\":" << static_cast<int64_t>(rng());
+                    break;
+                case 1:
+                    ss << "\"double_" << k << "\":" << rng() / 1000.0;
+                    break;
+                case 2:
+                    ss << "\"str_" << k << "\":\"value_" << rng() % 1000 << "\"";
+                    break;
+                case 3:
+                    ss << "\"bool_" << k << "\":" << (rng() % 2 ? "true" : "false");
+                    break;
+                default:
+                    ss << "\"obj_" << k << "\":{\"id\":" << rng() % 100 << ",\"name\":\"n"
+                       << rng() % 100 << "\"}";
+                    break;
+                }
+            }
+            ss << "}";
+            _docs.push_back(ss.str());
+        }
+    }
+
+    void init() override { _column = vectorized::ColumnObject::create(true); }
+
+    void run() override {
+        for (const auto& doc : _docs) {
+            Status st;
+            if (_by_field) {
+                st = vectorized::parse_json_to_variant(*_column, StringRef(doc), &_field_parser);
+            } else {
+                st = _parser.parse(*_column, StringRef(doc));
+            }
+            CHECK(st.ok()) << st;
+        }
+    }
+
+    int64_t items_per_run() override { return _docs.size(); }
+
+private:
+    bool _by_field;
+    std::vector<std::string> _docs;
+    vectorized::MutableColumnPtr _column;
+    vectorized::JSONToVariantParser _parser;
+    vectorized::JSONDataParser<vectorized::SimdJSONParser> _field_parser;
+};
+
+// Sort a block by (int, bigint desc, string), items per second is rows per second.
+// `by_normalized_key` sorts with radix sort on normalized keys, otherwise column by column
+// with comparators.
+class SortBlockBenchmark : public BaseBenchmark {
+public:
+    SortBlockBenchmark(const std::string& name, int iterations, int rows_num,
+                       bool by_normalized_key)
+            : BaseBenchmark(name, iterations), _by_normalized_key(by_normalized_key) {
+        std::mt19937 rng(rows_num);
+        auto int_column = vectorized::ColumnVector<vectorized::Int32>::create();
+        auto bigint_column = vectorized::ColumnVector<vectorized::Int64>::create();
+        auto string_column = vectorized::ColumnString::create();
+        for (int i = 0; i < rows_num; ++i) {
+            int_column->insert_value(rng() % 1000);
+            bigint_column->insert_value(static_cast<int64_t>(rng()));
+            std::string str = "order_" + std::to_string(rng() % 100000);
+            string_column->insert_data(str.data(), str.size());
+        }
+        _block.insert({std::move(int_column), std::make_shared<vectorized::DataTypeInt32>(),
+                       "int"});
+        _block.insert({std::move(bigint_column), std::make_shared<vectorized::DataTypeInt64>(),
+                       "bigint"});
+        _block.insert({std::move(string_column), std::make_shared<vectorized::DataTypeString>(),
+                       "string"});
+        _description.emplace_back(0, 1, 1);
+        _description.emplace_back(1, -1, -1);
+        _description.emplace_back(2, 1, 1);
+    }
+
+    void init() override { config::enable_normalized_key_sort = _by_normalized_key; }
+
+    void run() override {
+        vectorized::Block sorted_block = _block.clone_empty();
+        vectorized::sort_block(_block, sorted_block, _description);
+    }
+
+    int64_t items_per_run() override { return _block.rows(); }
+
+private:
+    bool _by_normalized_key;
+    vectorized::Block _block;
+    vectorized::SortDescription _description;
+};
+
+// Start and finish `fragments_num` fragments on all cores, like FragmentMgr registers them:
+// register the fragment and its query, look up the fragment as a runtime filter does, then
+// remove both. Items per second is fragments per second. One shard is a single global lock.
+class FragmentRegistryBenchmark : public BaseBenchmark {
+public:
+    FragmentRegistryBenchmark(const std::string& name, int iterations, int fragments_num,
+                              size_t num_shards)
+            : BaseBenchmark(name, iterations),
+              _fragments_num(fragments_num),
+              _fragment_map(num_shards),
+              _query_ctx_map(num_shards) {}
+
+    void run() override {
+        int num_threads = std::max(std::thread::hardware_concurrency(), 2U);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([this, t, num_threads]() {
+                std::mt19937_64 rng(t);
+                for (int i = t; i < _fragments_num; i += num_threads) {
+                    TUniqueId query_id;
+                    query_id.__set_hi(rng());
+                    query_id.__set_lo(rng());
+                    TUniqueId fragment_id = query_id;
+                    fragment_id.__set_lo(query_id.lo + 1);
+                    auto value = std::make_shared<int>(i);
+                    _query_ctx_map.find_or_insert(query_id, value);
+                    _fragment_map.insert(fragment_id, value);
+                    std::shared_ptr<int> found;
+                    _fragment_map.find(fragment_id, &found);
+                    _fragment_map.erase(fragment_id);
+                    _query_ctx_map.erase(query_id);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    int64_t items_per_run() override { return _fragments_num; }
+
+private:
+    int _fragments_num;
+    ShardedMap<TUniqueId, std::shared_ptr<int>> _fragment_map;
+    ShardedMap<TUniqueId, std::shared_ptr<int>> _query_ctx_map;
+};
+
+// Fill PaddedPODArrays of 64K UInt64 from empty on all cores, like the columns of the blocks
+// of a wide scan, so that each array reallocates its buffer through ChunkAllocator at every
+// power of two size. The arrays grow by push_back, or by `batch_size` elements at a time if
+// it is not 0. Items per second is elements per second. `thread_cache_bytes` is set to
+// config::chunk_allocator_thread_cache_bytes, 0 disables the thread cache of ChunkAllocator.
+class PODArrayGrowthBenchmark : public BaseBenchmark {
+public:
+    static constexpr int ARRAY_SIZE = 65536;
+
+    PODArrayGrowthBenchmark(const std::string& name, int iterations, int elements_num,
+                            int batch_size, int64_t thread_cache_bytes)
+            : BaseBenchmark(name, iterations),
+              _elements_num(elements_num),
+              _batch_size(batch_size),
+              _thread_cache_bytes(thread_cache_bytes) {
+        CpuInfo::init();
+        ChunkAllocator::init_instance(1L << 30);
+    }
+
+    void init() override { config::chunk_allocator_thread_cache_bytes = _thread_cache_bytes; }
+
+    void run() override {
+        int num_threads = std::max(std::thread::hardware_concurrency(), 2U);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([this, num_threads]() {
+                for (int done = 0; done < _elements_num / num_threads; done += ARRAY_SIZE) {
+                    vectorized::PaddedPODArray<vectorized::UInt64> array;
+                    if (_batch_size == 0) {
+                        for (int i = 0; i < ARRAY_SIZE; ++i) {
+                            array.push_back(i);
+                        }
+                    } else {
+                        for (int i = 0; i < ARRAY_SIZE; i += _batch_size) {
+                            array.resize(std::min(i + _batch_size, ARRAY_SIZE));
+                        }
+                    }
+                    benchmark::DoNotOptimize(array.data());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    int64_t items_per_run() override { return _elements_num; }
+
+private:
+    int _elements_num;
+    int _batch_size;
+    int64_t _thread_cache_bytes;
+};
+
 // This is sample custom test. User can write custom test code at custom_init()&custom_run().
 // Call method: ./benchmark_tool --operation=Custom
 class CustomBenchmark : public BaseBenchmark {
@@ -566,6 +805,44 @@ public:
         } else if (equal_ignore_case(FLAGS_operation, "SegmentWriteByFile")) {
             benchmarks.emplace_back(new doris::SegmentWriteByFileBenchmark(
                     FLAGS_operation, std::stoi(FLAGS_iterations), FLAGS_input_file));
+        } else if (equal_ignore_case(FLAGS_operation, "JsonToVariant")) {
+            benchmarks.emplace_back(new doris::JsonToVariantBenchmark(
+                    "JsonToVariantByField", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), std::stoi(FLAGS_json_keys), true));
+            benchmarks.emplace_back(new doris::JsonToVariantBenchmark(
+                    "JsonToVariantOnDemand", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), std::stoi(FLAGS_json_keys), false));
+        } else if (equal_ignore_case(FLAGS_operation, "SortBlock")) {
+            benchmarks.emplace_back(new doris::SortBlockBenchmark(
+                    "SortBlockByComparator", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), false));
+            benchmarks.emplace_back(new doris::SortBlockBenchmark(
+                    "SortBlockByNormalizedKey", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), true));
+        } else if (equal_ignore_case(FLAGS_operation, "FragmentRegistry")) {
+            benchmarks.emplace_back(new doris::FragmentRegistryBenchmark(
+                    "FragmentRegistryGlobalLock", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), 1));
+            benchmarks.emplace_back(new doris::FragmentRegistryBenchmark(
+                    "FragmentRegistrySharded", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), ShardedMap<int, int>::kDefaultNumShards));
+        } else if (equal_ignore_case(FLAGS_operation, "PODArrayGrowth")) {
+            // the thread cache is disabled by default
+            int64_t thread_cache_bytes = config::chunk_allocator_thread_cache_bytes > 0
+                                                 ? config::chunk_allocator_thread_cache_bytes
+                                                 : 2L << 20;
+            benchmarks.emplace_back(new doris::PODArrayGrowthBenchmark(
+                    "PODArrayPushBack", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), 0, 0));
+            benchmarks.emplace_back(new doris::PODArrayGrowthBenchmark(
+                    "PODArrayPushBackWithThreadCache", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), 0, thread_cache_bytes));
+            benchmarks.emplace_back(new doris::PODArrayGrowthBenchmark(
+                    "PODArrayResizeByBatch", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), 4064, 0));
+            benchmarks.emplace_back(new doris::PODArrayGrowthBenchmark(
+                    "PODArrayResizeByBatchWithThreadCache", std::stoi(FLAGS_iterations),
+                    std::stoi(FLAGS_rows_number), 4064, thread_cache_bytes));
         } else {
             std::cout << "operation invalid!" << std::endl;
         }
@@ -52,4 +52,25 @@ TEST_F(ByteBufferTest, normal) {
     EXPECT_EQ(3, buf->remaining());
 }
 
+TEST_F(ByteBufferTest, release) {
+    auto buf = ByteBuffer::allocate(4);
+    char test[] = {1, 2, 3};
+    buf->put_bytes(test, 3);
+    buf->flip();
+    char* ptr = buf->ptr;
+
+    std::unique_ptr<uint8_t[]> data = buf->release();
+    EXPECT_EQ(reinterpret_cast<uint8_t*>(ptr), data.get());
+    EXPECT_EQ(nullptr, buf->ptr);
+    EXPECT_EQ(0, buf->pos);
+    EXPECT_EQ(0, buf->limit);
+    EXPECT_EQ(0, buf->capacity);
+    EXPECT_FALSE(buf->has_remaining());
+    EXPECT_EQ(1, data[0]);
+    EXPECT_EQ(3, data[2]);
+    // the buffer doesn't free the memory it released
+    buf.reset();
+    EXPECT_EQ(2, data[1]);
+}
+
 } // namespace doris
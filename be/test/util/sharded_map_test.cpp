@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/sharded_map.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+
+namespace doris {
+
+TEST(ShardedMapTest, Basic) {
+    ShardedMap<int, std::shared_ptr<int>> map(4);
+    EXPECT_TRUE(map.insert(1, std::make_shared<int>(10)));
+    EXPECT_FALSE(map.insert(1, std::make_shared<int>(11)));
+    EXPECT_TRUE(map.insert(2, std::make_shared<int>(20)));
+    EXPECT_EQ(2, map.size());
+
+    std::shared_ptr<int> value;
+    ASSERT_TRUE(map.find(1, &value));
+    EXPECT_EQ(10, *value);
+    EXPECT_FALSE(map.find(3, &value));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_FALSE(map.contains(3));
+
+    auto inserted = std::make_shared<int>(30);
+    EXPECT_EQ(inserted, map.find_or_insert(3, inserted));
+    EXPECT_EQ(10, *map.find_or_insert(1, std::make_shared<int>(12)));
+
+    EXPECT_TRUE(map.erase(2));
+    EXPECT_FALSE(map.erase(2));
+    EXPECT_EQ(2, map.size());
+
+    map.clear();
+    EXPECT_EQ(0, map.size());
+}
+
+TEST(ShardedMapTest, EraseIfAndForEach) {
+    ShardedMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.insert(i, i * 2);
+    }
+    map.erase_if([](int key, int value) { return key % 2 == 0; });
+    EXPECT_EQ(500, map.size());
+
+    int64_t sum = 0;
+    map.for_each([&](int key, int value) {
+        EXPECT_EQ(1, key % 2);
+        EXPECT_EQ(key * 2, value);
+        sum += key;
+    });
+    EXPECT_EQ(500 * 500, sum);
+}
+
+TEST(ShardedMapTest, Concurrent) {
+    ShardedMap<int, int> map(16);
+    const int num_threads = 8;
+    const int num_keys = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&map, t]() {
+            for (int i = t; i < num_keys; i += num_threads) {
+                EXPECT_TRUE(map.insert(i, i));
+                int value = 0;
+                EXPECT_TRUE(map.find(i, &value));
+                EXPECT_EQ(i, value);
+                if (i % 3 == 0) {
+                    EXPECT_TRUE(map.erase(i));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(num_keys - (num_keys + 2) / 3, map.size());
+}
+
+} // namespace doris
@@ -0,0 +1,137 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/hash_table/partitioned_hash_map.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "util/threadpool.h"
+#include "vec/common/hash_table/hash.h"
+#include "vec/core/types.h"
+
+namespace doris::vectorized {
+
+using TestPartitionedMap = PHPartitionedHashMap<UInt64, UInt64, HashMixWrapper<UInt64>>;
+
+static void fill(TestPartitionedMap& map, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        TestPartitionedMap::LookupResult it;
+        bool inserted = false;
+        UInt64 key = i;
+        map.emplace(key, it, inserted);
+        EXPECT_TRUE(inserted);
+        *lookup_result_get_mapped(it) = i * 2;
+    }
+}
+
+TEST(PartitionedHashMapTest, ConvertToPartitioned) {
+    TestPartitionedMap map;
+    map.set_partitioned_threshold(1024);
+
+    const size_t count = 100000;
+    fill(map, count);
+    EXPECT_EQ(map.size(), count);
+    EXPECT_GT(map.sizes().size(), 1);
+
+    for (size_t i = 0; i < count; ++i) {
+        UInt64 key = i;
+        auto* it = map.find(key);
+        ASSERT_NE(it, nullptr);
+        EXPECT_EQ(*lookup_result_get_mapped(it), i * 2);
+    }
+
+    size_t visited = 0;
+    map.for_each_mapped([&](auto& mapped) {
+        EXPECT_EQ(mapped % 2, 0);
+        ++visited;
+    });
+    EXPECT_EQ(visited, count);
+}
+
+TEST(PartitionedHashMapTest, ThresholdDisabled) {
+    TestPartitionedMap map;
+
+    const size_t count = 10000;
+    fill(map, count);
+    EXPECT_EQ(map.size(), count);
+    EXPECT_EQ(map.sizes().size(), 1);
+}
+
+// Rows are split by the sub table of their key and merged by several threads like the merge
+// aggregation does, the states of a key must only be updated by one task.
+TEST(PartitionedHashMapTest, ParallelMergeBySubTable) {
+    TestPartitionedMap map;
+    map.set_partitioned_threshold(1024);
+    EXPECT_FALSE(map.is_partitioned());
+
+    const size_t num_keys = 50000;
+    const size_t num_rows = num_keys * 4;
+    std::vector<UInt64> states(num_keys, 0);
+    std::vector<UInt64*> places(num_rows);
+    std::vector<size_t> hash_values(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        UInt64 key = (i * 7919) % num_keys;
+        hash_values[i] = map.hash(key);
+        TestPartitionedMap::LookupResult it;
+        bool inserted = false;
+        map.emplace(key, it, hash_values[i], inserted);
+        if (inserted) {
+            *lookup_result_get_mapped(it) = key;
+        }
+        places[i] = &states[*lookup_result_get_mapped(it)];
+    }
+    EXPECT_TRUE(map.is_partitioned());
+    EXPECT_EQ(map.size(), num_keys);
+    EXPECT_EQ(map.sizes().size(), TestPartitionedMap::get_sub_table_count());
+
+    const size_t num_tasks = 5;
+    std::vector<std::vector<size_t>> task_rows(num_tasks);
+    for (size_t i = 0; i < num_rows; ++i) {
+        task_rows[TestPartitionedMap::get_sub_table_idx(hash_values[i]) % num_tasks].push_back(i);
+    }
+
+    std::unique_ptr<ThreadPool> thread_pool;
+    ASSERT_TRUE(ThreadPoolBuilder("PartitionedHashMapTest")
+                        .set_min_threads(num_tasks)
+                        .set_max_threads(num_tasks)
+                        .build(&thread_pool)
+                        .ok());
+    auto token = thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    for (size_t task = 0; task < num_tasks; ++task) {
+        ASSERT_TRUE(token->submit_func([&, task]() {
+                             for (size_t row : task_rows[task]) {
+                                 // not atomic, a key merged by two tasks loses updates
+                                 *places[row] += row;
+                             }
+                         }).ok());
+    }
+    token->wait();
+
+    std::vector<UInt64> expected(num_keys, 0);
+    for (size_t i = 0; i < num_rows; ++i) {
+        expected[(i * 7919) % num_keys] += i;
+    }
+    EXPECT_EQ(states, expected);
+}
+
+} // namespace doris::vectorized
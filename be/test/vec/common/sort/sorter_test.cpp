@@ -0,0 +1,255 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/common/sort/sorter.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "io/fs/local_file_system.h"
+#include "olap/options.h"
+#include "runtime/block_spill_manager.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/memory/mem_reservation.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "util/threadpool.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class SorterTest : public testing::Test {
+public:
+    void SetUp() override {
+        ASSERT_TRUE(_state.init_mem_trackers().ok());
+        ASSERT_TRUE(ThreadPoolBuilder("SorterTest")
+                            .set_min_threads(4)
+                            .set_max_threads(4)
+                            .build(&_thread_pool)
+                            .ok());
+        // sort by all columns, so serial and parallel sorts output the same rows
+        _description.emplace_back(0, 1, 1);
+        _description.emplace_back(1, -1, -1);
+    }
+
+    void TearDown() override { _thread_pool->shutdown(); }
+
+    static Block create_block(size_t rows, uint32_t seed) {
+        std::mt19937 rng(seed);
+        auto int_column = ColumnVector<Int32>::create();
+        auto string_column = ColumnString::create();
+        for (size_t i = 0; i < rows; ++i) {
+            int_column->insert_value(static_cast<Int32>(rng() % 100));
+            std::string str = "str_" + std::to_string(rng() % 1000);
+            string_column->insert_data(str.data(), str.size());
+        }
+        Block block;
+        block.insert({std::move(int_column), std::make_shared<DataTypeInt32>(), "int"});
+        block.insert({std::move(string_column), std::make_shared<DataTypeString>(), "string"});
+        return block;
+    }
+
+    // cut `block' into runs of adjacent rows like FullSorter does
+    static std::vector<Block> split(const Block& block, size_t num_runs) {
+        std::vector<Block> runs(num_runs);
+        size_t rows = block.rows();
+        size_t rows_per_run = (rows + num_runs - 1) / num_runs;
+        for (size_t i = 0; i < num_runs; ++i) {
+            size_t offset = i * rows_per_run;
+            size_t length = std::min(rows_per_run, rows - offset);
+            for (const auto& column : block) {
+                runs[i].insert({column.column->cut(offset, length), column.type, column.name});
+            }
+        }
+        return runs;
+    }
+
+    // merge the sorted runs like the sort node reads them
+    Block merge(std::vector<Block>& runs) {
+        RuntimeProfile profile("SorterTest");
+        MergeSorterState state(RowDescriptor(), 0, -1, &_state, &profile);
+        for (auto& run : runs) {
+            EXPECT_TRUE(state.add_sorted_block(run).ok());
+        }
+        EXPECT_TRUE(state.build_merge_tree(_description).ok());
+        EXPECT_FALSE(state.is_spilled());
+        return read_merged(state);
+    }
+
+    Block read_merged(MergeSorterState& state) {
+        MutableBlock merged;
+        bool eos = false;
+        while (!eos) {
+            Block block;
+            EXPECT_TRUE(state.merge_sort_read(&_state, &block, &eos).ok());
+            if (block.rows() > 0) {
+                if (merged.columns() == 0) {
+                    merged = MutableBlock(block.clone_empty());
+                }
+                merged.add_rows(&block, 0, block.rows());
+            }
+        }
+        return merged.to_block();
+    }
+
+    Block serial_sort(size_t rows, uint32_t seed) {
+        Block block = create_block(rows, seed);
+        sort_block(block, block, _description);
+        return block;
+    }
+
+    void check_sorted(const Block& block) {
+        auto columns = get_columns_with_sort_description(block, _description);
+        for (size_t row = 1; row < block.rows(); ++row) {
+            int res = 0;
+            for (size_t i = 0; i < columns.size() && res == 0; ++i) {
+                res = columns[i].first->compare_at(row - 1, row, *columns[i].first,
+                                                   columns[i].second.nulls_direction) *
+                      columns[i].second.direction;
+            }
+            ASSERT_LE(res, 0) << "row " << row;
+        }
+    }
+
+    static void check_equal(const Block& expected, const Block& actual) {
+        ASSERT_EQ(expected.rows(), actual.rows());
+        ASSERT_EQ(expected.columns(), actual.columns());
+        for (size_t i = 0; i < expected.columns(); ++i) {
+            const auto& expected_column = *expected.get_by_position(i).column;
+            const auto& actual_column = *actual.get_by_position(i).column;
+            for (size_t row = 0; row < expected.rows(); ++row) {
+                ASSERT_EQ(0, expected_column.compare_at(row, row, actual_column, 1))
+                        << "column " << i << " row " << row;
+            }
+        }
+    }
+
+protected:
+    RuntimeState _state;
+    std::unique_ptr<ThreadPool> _thread_pool;
+    SortDescription _description;
+};
+
+TEST_F(SorterTest, ParallelSortMatchesSerialSort) {
+    const size_t rows = 10000;
+    std::vector<Block> runs = split(create_block(rows, 1), 4);
+    ASSERT_TRUE(sort_runs_in_parallel(_thread_pool.get(), &_state, _description, &runs).ok());
+    for (const auto& run : runs) {
+        check_sorted(run);
+    }
+
+    Block merged = merge(runs);
+    check_sorted(merged);
+    check_equal(serial_sort(rows, 1), merged);
+}
+
+// Runs of several buffered blocks, i.e. several parallel sorts, are merged together
+TEST_F(SorterTest, MergeRunsOfSeveralParallelSorts) {
+    const size_t rows = 3000;
+    Block first = create_block(rows, 2);
+    Block second = create_block(rows, 3);
+
+    std::vector<Block> runs = split(first, 3);
+    ASSERT_TRUE(sort_runs_in_parallel(_thread_pool.get(), &_state, _description, &runs).ok());
+    std::vector<Block> second_runs = split(second, 5);
+    ASSERT_TRUE(
+            sort_runs_in_parallel(_thread_pool.get(), &_state, _description, &second_runs).ok());
+    for (auto& run : second_runs) {
+        runs.emplace_back(std::move(run));
+    }
+    Block merged = merge(runs);
+
+    MutableBlock all(create_block(rows, 2));
+    Block second_copy = create_block(rows, 3);
+    all.add_rows(&second_copy, 0, rows);
+    Block expected = all.to_block();
+    sort_block(expected, expected, _description);
+    check_sorted(merged);
+    check_equal(expected, merged);
+}
+
+// Runs are sorted by the calling thread once the pool is shut down
+TEST_F(SorterTest, SortRunsWithoutPool) {
+    const size_t rows = 2000;
+    std::vector<Block> runs = split(create_block(rows, 4), 4);
+    _thread_pool->shutdown();
+    ASSERT_TRUE(sort_runs_in_parallel(_thread_pool.get(), &_state, _description, &runs).ok());
+    for (const auto& run : runs) {
+        check_sorted(run);
+    }
+    check_equal(serial_sort(rows, 4), merge(runs));
+}
+
+// The sorted blocks are spilled once the memory for them can not be reserved
+TEST_F(SorterTest, SpillWhenReservationDenied) {
+    char buffer[1024];
+    ASSERT_NE(getcwd(buffer, sizeof(buffer)), nullptr);
+    std::string spill_dir = std::string(buffer) + "/sorter_test_spill";
+    ASSERT_TRUE(io::global_local_filesystem()->delete_and_create_directory(spill_dir).ok());
+    std::vector<StorePath> paths;
+    paths.emplace_back(spill_dir, -1);
+    BlockSpillManager spill_mgr(paths);
+    ASSERT_TRUE(spill_mgr.init().ok());
+    auto* env = ExecEnv::GetInstance();
+    auto* old_spill_mgr = env->_block_spill_mgr;
+    env->_block_spill_mgr = &spill_mgr;
+
+    const size_t rows = 4000;
+    std::vector<Block> runs = split(create_block(rows, 5), 4);
+    ASSERT_TRUE(sort_runs_in_parallel(_thread_pool.get(), &_state, _description, &runs).ok());
+    // only the first run fits into the reservation
+    auto reservation =
+            std::make_shared<MemReservation>("SorterTest", runs[0].allocated_bytes(), nullptr);
+    {
+        RuntimeProfile profile("SorterTest");
+        MergeSorterState state(RowDescriptor(), 0, -1, &_state, &profile);
+        state.mem_reservation_.init(reservation, &profile);
+        EXPECT_TRUE(state.add_sorted_block(runs[0]).ok());
+        EXPECT_FALSE(state.is_spilled());
+        for (size_t i = 1; i < runs.size(); ++i) {
+            EXPECT_TRUE(state.add_sorted_block(runs[i]).ok());
+        }
+        EXPECT_TRUE(state.is_spilled());
+        EXPECT_EQ(1, profile.get_counter("MemReservationDenied")->value());
+        EXPECT_EQ(3, state.spilled_block_count_->value());
+
+        ASSERT_TRUE(state.build_merge_tree(_description).ok());
+        Block merged = read_merged(state);
+        check_sorted(merged);
+        check_equal(serial_sort(rows, 5), merged);
+    }
+    EXPECT_EQ(0, reservation->reserved());
+
+    env->_block_spill_mgr = old_spill_mgr;
+    static_cast<void>(io::global_local_filesystem()->delete_directory(spill_dir));
+}
+
+} // namespace doris::vectorized
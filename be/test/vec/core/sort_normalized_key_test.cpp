@@ -0,0 +1,144 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/core/sort_normalized_key.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <random>
+#include <string>
+
+#include "gtest/gtest_pred_impl.h"
+#include "vec/columns/column_nullable.h"
+#include "vec/columns/column_string.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/sort_block.h"
+#include "vec/data_types/data_type_nullable.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/data_types/data_type_string.h"
+
+namespace doris::vectorized {
+
+class NormalizedSortKeysTest : public testing::Test {
+public:
+    // nullable int32 with small values, int64 and strings with long common prefixes
+    static Block create_block(size_t rows) {
+        std::mt19937 rng(rows);
+        auto int_column = ColumnVector<Int32>::create();
+        auto null_map = ColumnUInt8::create();
+        auto bigint_column = ColumnVector<Int64>::create();
+        auto string_column = ColumnString::create();
+        for (size_t i = 0; i < rows; ++i) {
+            int_column->insert_value(static_cast<Int32>(rng() % 10) - 5);
+            null_map->insert_value(rng() % 7 == 0);
+            bigint_column->insert_value(static_cast<Int64>(rng() % 4) - 2);
+            std::string str = "common_prefix_" + std::to_string(rng() % 100);
+            string_column->insert_data(str.data(), str.size());
+        }
+        Block block;
+        block.insert({ColumnNullable::create(std::move(int_column), std::move(null_map)),
+                      make_nullable(std::make_shared<DataTypeInt32>()), "int"});
+        block.insert({std::move(bigint_column), std::make_shared<DataTypeInt64>(), "bigint"});
+        block.insert({std::move(string_column), std::make_shared<DataTypeString>(), "string"});
+        return block;
+    }
+
+    static SortDescription create_description(std::vector<std::pair<bool, bool>> asc_nulls_first) {
+        SortDescription description;
+        for (size_t i = 0; i < asc_nulls_first.size(); ++i) {
+            int direction = asc_nulls_first[i].first ? 1 : -1;
+            int nulls_direction = asc_nulls_first[i].second ? -direction : direction;
+            description.emplace_back(i, direction, nulls_direction);
+        }
+        return description;
+    }
+
+    static void check_sorted(const Block& block, const SortDescription& description,
+                             const IColumn::Permutation& perm) {
+        ASSERT_EQ(block.rows(), perm.size());
+        std::vector<bool> seen(perm.size(), false);
+        for (size_t i = 0; i < perm.size(); ++i) {
+            ASSERT_FALSE(seen[perm[i]]);
+            seen[perm[i]] = true;
+        }
+        auto columns = get_columns_with_sort_description(block, description);
+        for (size_t i = 1; i < perm.size(); ++i) {
+            for (const auto& [column, desc] : columns) {
+                int res = desc.direction *
+                          column->compare_at(perm[i - 1], perm[i], *column, desc.nulls_direction);
+                ASSERT_LE(res, 0) << "row " << i;
+                if (res < 0) {
+                    break;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(NormalizedSortKeysTest, CompleteKeys) {
+    Block block = create_block(1000);
+    auto description = create_description({{true, true}, {false, false}});
+    NormalizedSortKeys keys;
+    ASSERT_TRUE(keys.init(block, description));
+    // null byte + int32 + int64
+    EXPECT_EQ(13, keys.key_bytes());
+    EXPECT_EQ(2, keys.num_complete_columns());
+    IColumn::Permutation perm;
+    keys.get_permutation(perm);
+    check_sorted(block, description, perm);
+}
+
+TEST_F(NormalizedSortKeysTest, StringPrefixWithTieBreak) {
+    Block block = create_block(1000);
+    for (auto asc : {true, false}) {
+        for (auto nulls_first : {true, false}) {
+            auto description = create_description({{asc, nulls_first}, {asc, false}, {!asc, true}});
+            NormalizedSortKeys keys;
+            ASSERT_TRUE(keys.init(block, description));
+            EXPECT_EQ(13 + NormalizedSortKeys::STRING_PREFIX_BYTES, keys.key_bytes());
+            EXPECT_EQ(2, keys.num_complete_columns());
+            IColumn::Permutation perm;
+            keys.get_permutation(perm);
+            check_sorted(block, description, perm);
+        }
+    }
+}
+
+TEST_F(NormalizedSortKeysTest, SortBlock) {
+    Block block = create_block(5000);
+    auto description = create_description({{false, true}, {true, true}, {true, true}});
+    Block sorted_block = block.clone_empty();
+    sort_block(block, sorted_block, description);
+    IColumn::Permutation perm(sorted_block.rows());
+    for (size_t i = 0; i < perm.size(); ++i) {
+        perm[i] = i;
+    }
+    check_sorted(sorted_block, description, perm);
+}
+
+TEST_F(NormalizedSortKeysTest, UnsupportedLeadingColumn) {
+    Block block;
+    auto double_column = ColumnVector<Float64>::create();
+    double_column->insert_value(1.0);
+    block.insert({std::move(double_column), std::make_shared<DataTypeFloat64>(), "double"});
+    auto description = create_description({{true, true}});
+    NormalizedSortKeys keys;
+    EXPECT_FALSE(keys.init(block, description));
+}
+
+} // namespace doris::vectorized
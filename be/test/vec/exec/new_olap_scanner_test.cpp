@@ -0,0 +1,217 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/scan/new_olap_scanner.h"
+
+#include <gen_cpp/Descriptors_types.h>
+#include <gen_cpp/PlanNodes_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <memory>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "gtest/gtest_pred_impl.h"
+#include "olap/rowset/rowset_factory.h"
+#include "olap/rowset/rowset_meta.h"
+#include "olap/tablet_meta.h"
+#include "runtime/cache/intermediate_result_cache.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+#include "vec/columns/column_vector.h"
+#include "vec/core/block.h"
+#include "vec/data_types/data_type_number.h"
+#include "vec/exec/scan/new_olap_scan_node.h"
+
+namespace doris::vectorized {
+
+static constexpr int64_t DIGEST = 2023;
+
+class NewOlapScannerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        if (IntermediateResultCache::instance() == nullptr) {
+            IntermediateResultCache::create_global_cache(1024 * 1024);
+        }
+
+        TDescriptorTableBuilder dtb;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(
+                TSlotDescriptorBuilder().type(TYPE_INT).column_name("k1").column_pos(0).build());
+        tuple_builder.build(&dtb);
+        EXPECT_TRUE(DescriptorTbl::create(&_pool, dtb.desc_tbl(), &_desc_tbl).ok());
+
+        TPlanNode tnode;
+        tnode.__set_node_id(0);
+        tnode.__set_node_type(TPlanNodeType::OLAP_SCAN_NODE);
+        tnode.__set_num_children(0);
+        tnode.__set_limit(-1);
+        tnode.__set_row_tuples({0});
+        tnode.__set_nullable_tuples({false});
+        tnode.olap_scan_node.__set_tuple_id(0);
+        tnode.olap_scan_node.__set_is_preaggregation(true);
+        tnode.olap_scan_node.__set_result_cache_digest(DIGEST);
+        tnode.__isset.olap_scan_node = true;
+        _scan_node = std::make_unique<NewOlapScanNode>(&_pool, tnode, *_desc_tbl);
+        _scan_node->_output_tuple_desc = _desc_tbl->get_tuple_descriptor(0);
+        _scan_node->_result_cache_hit_counter = ADD_COUNTER(&_profile, "HitCount", TUnit::UNIT);
+        _scan_node->_result_cache_miss_counter = ADD_COUNTER(&_profile, "MissCount", TUnit::UNIT);
+
+        for (int i = 0; i < 2; ++i) {
+            RowsetId rowset_id;
+            rowset_id.init(2, DIGEST + i, 0, 0);
+            auto rs_meta = std::make_shared<RowsetMeta>();
+            rs_meta->set_rowset_type(BETA_ROWSET);
+            rs_meta->set_rowset_id(rowset_id);
+            rs_meta->set_version({i, i});
+            RowsetSharedPtr rowset;
+            EXPECT_TRUE(RowsetFactory::create_rowset(std::make_shared<TabletSchema>(), "", rs_meta,
+                                                     &rowset)
+                                .ok());
+            RowsetReaderSharedPtr rs_reader;
+            EXPECT_TRUE(rowset->create_reader(&rs_reader).ok());
+            _rs_readers.push_back(rs_reader);
+        }
+        _scanner = std::make_unique<NewOlapScanner>(&_state, _scan_node.get(), -1, false,
+                                                    _scan_range, std::vector<OlapScanRange*>(),
+                                                    _rs_readers, std::vector<std::pair<int, int>>(),
+                                                    false, &_profile);
+        _scanner->_tablet_reader_params.direct_mode = true;
+    }
+
+    void TearDown() override {
+        _scanner.reset();
+        _rs_readers.clear();
+        _scan_node.reset();
+    }
+
+    static Block create_block(int rows) {
+        auto column = ColumnVector<Int32>::create();
+        for (int i = 0; i < rows; ++i) {
+            column->insert_value(i);
+        }
+        Block block;
+        block.insert({std::move(column), std::make_shared<DataTypeInt32>(), "k1"});
+        return block;
+    }
+
+    void cache_rowset(int idx, int rows) {
+        IntermediateResultCache::Blocks blocks;
+        blocks.push_back(create_block(rows));
+        IntermediateResultCache::instance()->insert(
+                {DIGEST, _rs_readers[idx]->rowset()->rowset_id()}, std::move(blocks));
+    }
+
+    // decide whether to use the cache as NewOlapScanner::init() does
+    void init_result_cache() {
+        _scanner->_use_result_cache = _scanner->_can_use_result_cache();
+        _scanner->_cache_result_by_rowset =
+                _scanner->_use_result_cache && _scanner->_can_cache_result_by_rowset();
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    RuntimeProfile _profile {"NewOlapScannerTest"};
+    RuntimeState _state {TQueryGlobals()};
+    TPaloScanRange _scan_range;
+    std::unique_ptr<NewOlapScanNode> _scan_node;
+    std::vector<RowsetReaderSharedPtr> _rs_readers;
+    std::unique_ptr<NewOlapScanner> _scanner;
+};
+
+// all rowsets are cached, the scanner replays them without reading the tablet
+TEST_F(NewOlapScannerTest, ResultCacheHit) {
+    cache_rowset(0, 10);
+    cache_rowset(1, 5);
+    init_result_cache();
+    ASSERT_TRUE(_scanner->_use_result_cache);
+    ASSERT_TRUE(_scanner->_cache_result_by_rowset);
+
+    EXPECT_TRUE(_scanner->open(&_state).ok());
+    EXPECT_FALSE(_scanner->_tablet_reader_opened);
+    EXPECT_TRUE(_scanner->_rs_readers_to_read.empty());
+    EXPECT_EQ(2, _scan_node->_result_cache_hit_counter->value());
+    EXPECT_EQ(0, _scan_node->_result_cache_miss_counter->value());
+
+    std::vector<size_t> rows;
+    bool eof = false;
+    while (true) {
+        Block block = create_block(0);
+        EXPECT_TRUE(_scanner->_get_block_impl(&_state, &block, &eof).ok());
+        if (eof) {
+            break;
+        }
+        rows.push_back(block.rows());
+    }
+    EXPECT_EQ(std::vector<size_t>({10, 5}), rows);
+}
+
+// only the rowsets which are not cached are read
+TEST_F(NewOlapScannerTest, ResultCacheMiss) {
+    _scan_node->_olap_scan_node.result_cache_digest = DIGEST + 1;
+    IntermediateResultCache::Blocks blocks;
+    blocks.push_back(create_block(10));
+    IntermediateResultCache::instance()->insert(
+            {DIGEST + 1, _rs_readers[0]->rowset()->rowset_id()}, std::move(blocks));
+    init_result_cache();
+    ASSERT_TRUE(_scanner->_cache_result_by_rowset);
+
+    EXPECT_TRUE(_scanner->_lookup_result_cache());
+    ASSERT_EQ(1, _scanner->_rs_readers_to_read.size());
+    EXPECT_EQ(_rs_readers[1], _scanner->_rs_readers_to_read.front());
+    EXPECT_EQ(1, _scan_node->_result_cache_hit_counter->value());
+    EXPECT_EQ(1, _scan_node->_result_cache_miss_counter->value());
+}
+
+// rows of a rowset may be deleted by later versions, so the output is not cached by rowset
+TEST_F(NewOlapScannerTest, NoResultCacheByRowsetWithDeletes) {
+    init_result_cache();
+    EXPECT_TRUE(_scanner->_cache_result_by_rowset);
+
+    _scanner->_tablet_reader_params.delete_predicates.push_back(std::make_shared<RowsetMeta>());
+    init_result_cache();
+    EXPECT_TRUE(_scanner->_use_result_cache);
+    EXPECT_FALSE(_scanner->_cache_result_by_rowset);
+    _scanner->_tablet_reader_params.delete_predicates.clear();
+
+    DeleteBitmap delete_bitmap(0);
+    _scanner->_tablet_reader_params.delete_bitmap = &delete_bitmap;
+    init_result_cache();
+    EXPECT_TRUE(_scanner->_use_result_cache);
+    EXPECT_FALSE(_scanner->_cache_result_by_rowset);
+    _scanner->_tablet_reader_params.delete_bitmap = nullptr;
+
+    // the output differs from a normal scan if deletes are skipped
+    _state._query_options.__set_skip_delete_bitmap(true);
+    init_result_cache();
+    EXPECT_FALSE(_scanner->_use_result_cache);
+    _state._query_options.__set_skip_delete_bitmap(false);
+    _state._query_options.__set_skip_delete_predicate(true);
+    init_result_cache();
+    EXPECT_FALSE(_scanner->_use_result_cache);
+    _state._query_options.__set_skip_delete_predicate(false);
+
+    // no digest from FE
+    _scan_node->_olap_scan_node.__isset.result_cache_digest = false;
+    init_result_cache();
+    EXPECT_FALSE(_scanner->_use_result_cache);
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,123 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/exec/streaming_preagg_pass_through.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <algorithm>
+
+#include "gtest/gtest_pred_impl.h"
+
+namespace doris::vectorized {
+
+static constexpr int64_t SAMPLE_ROWS = StreamingPreaggPassThrough::SAMPLE_ROWS;
+static constexpr size_t L3_HT_MEM = 2 * 1024 * 1024;
+static constexpr size_t MEMORY_HT_MEM = 32 * 1024 * 1024;
+
+// Passes `rows` rows through in batches, returns false if the pass-through stopped before.
+static bool pass_through_rows(StreamingPreaggPassThrough& pass_through, int64_t rows) {
+    for (int64_t passed = 0; passed < rows; passed += 4096) {
+        if (!pass_through.should_pass_through(4096)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(StreamingPreaggPassThroughTest, CacheLevel) {
+    EXPECT_EQ(streaming_ht_cache_level(0), 0);
+    EXPECT_EQ(streaming_ht_cache_level(1024 * 1024 - 1), 0);
+    EXPECT_EQ(streaming_ht_cache_level(L3_HT_MEM), 1);
+    EXPECT_EQ(streaming_ht_cache_level(MEMORY_HT_MEM), 2);
+}
+
+TEST(StreamingPreaggPassThroughTest, WaitForFullSample) {
+    StreamingPreaggPassThrough pass_through;
+    EXPECT_FALSE(pass_through.update(SAMPLE_ROWS / 2, SAMPLE_ROWS / 2, 1000, MEMORY_HT_MEM));
+    EXPECT_FALSE(pass_through.is_passing_through());
+    EXPECT_TRUE(pass_through.update(SAMPLE_ROWS / 2, SAMPLE_ROWS / 2, 1000, MEMORY_HT_MEM));
+    EXPECT_DOUBLE_EQ(pass_through.reduction(), 1.0);
+    EXPECT_TRUE(pass_through.is_passing_through());
+}
+
+TEST(StreamingPreaggPassThroughTest, KeepAggregatingWithGoodReduction) {
+    StreamingPreaggPassThrough pass_through;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(pass_through.update(SAMPLE_ROWS, SAMPLE_ROWS / 10, 1000, MEMORY_HT_MEM));
+        EXPECT_FALSE(pass_through.should_pass_through(4096));
+    }
+    EXPECT_DOUBLE_EQ(pass_through.reduction(), 10.0);
+    EXPECT_EQ(pass_through.switch_count(), 0);
+}
+
+TEST(StreamingPreaggPassThroughTest, SmallHashTableAlwaysAggregates) {
+    StreamingPreaggPassThrough pass_through;
+    EXPECT_TRUE(pass_through.update(SAMPLE_ROWS, SAMPLE_ROWS, 1000, 64 * 1024));
+    EXPECT_FALSE(pass_through.is_passing_through());
+}
+
+TEST(StreamingPreaggPassThroughTest, PassThroughAndProbeBack) {
+    StreamingPreaggPassThrough pass_through;
+    EXPECT_TRUE(pass_through.update(SAMPLE_ROWS, SAMPLE_ROWS, 1000, L3_HT_MEM));
+    EXPECT_TRUE(pass_through.is_passing_through());
+    EXPECT_EQ(pass_through.switch_count(), 1);
+    EXPECT_EQ(pass_through.pass_through_interval(),
+              StreamingPreaggPassThrough::MIN_PASS_THROUGH_ROWS);
+
+    EXPECT_TRUE(pass_through_rows(pass_through, StreamingPreaggPassThrough::MIN_PASS_THROUGH_ROWS));
+    // the interval is used up, the next sample is aggregated
+    EXPECT_FALSE(pass_through.should_pass_through(4096));
+    EXPECT_EQ(pass_through.probe_back_count(), 1);
+
+    // the reduction improved, keep aggregating
+    EXPECT_TRUE(pass_through.update(SAMPLE_ROWS, SAMPLE_ROWS / 4, 1000, L3_HT_MEM));
+    EXPECT_FALSE(pass_through.is_passing_through());
+    EXPECT_EQ(pass_through.pass_through_interval(), 0);
+}
+
+TEST(StreamingPreaggPassThroughTest, IntervalDoublesOnConfirmedProbe) {
+    StreamingPreaggPassThrough pass_through;
+    int64_t expected_interval = StreamingPreaggPassThrough::MIN_PASS_THROUGH_ROWS;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(pass_through.update(SAMPLE_ROWS, SAMPLE_ROWS, 1000, L3_HT_MEM));
+        EXPECT_EQ(pass_through.pass_through_interval(), expected_interval);
+        EXPECT_TRUE(pass_through_rows(pass_through, expected_interval));
+        EXPECT_FALSE(pass_through.should_pass_through(4096));
+        expected_interval = std::min(expected_interval * 2,
+                                     StreamingPreaggPassThrough::MAX_PASS_THROUGH_ROWS);
+    }
+    EXPECT_EQ(pass_through.pass_through_interval(),
+              StreamingPreaggPassThrough::MAX_PASS_THROUGH_ROWS);
+    EXPECT_EQ(pass_through.switch_count(), 10);
+    EXPECT_EQ(pass_through.probe_back_count(), 10);
+}
+
+TEST(StreamingPreaggPassThroughTest, SlowLookupsRequireMoreReduction) {
+    StreamingPreaggPassThrough pass_through;
+    // a reduction of 1.5 is enough while the hash table fits in the L3 cache
+    EXPECT_TRUE(pass_through.update(SAMPLE_ROWS, SAMPLE_ROWS * 2 / 3, SAMPLE_ROWS * 10, L3_HT_MEM));
+    EXPECT_FALSE(pass_through.is_passing_through());
+    EXPECT_DOUBLE_EQ(pass_through.probe_ns_per_row(), 10.0);
+
+    // the lookups got three times slower, the reduction needed for main memory applies
+    EXPECT_TRUE(pass_through.update(SAMPLE_ROWS, SAMPLE_ROWS * 2 / 3, SAMPLE_ROWS * 30, L3_HT_MEM));
+    EXPECT_TRUE(pass_through.is_passing_through());
+}
+
+} // namespace doris::vectorized
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/json/parse2column.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+#include "vec/columns/column_object.h"
+#include "vec/json/json_parser.h"
+#include "vec/json/simd_json_parser.h"
+
+namespace doris::vectorized {
+
+TEST(JSONToVariantParserTest, SameAsFieldPath) {
+    // type widening, nested objects, nulls, missing keys, and arrays which fall back
+    std::vector<std::string> docs = {
+            R"({"a": 1, "b": "x", "c": {"d": 1.5, "e": true}})",
+            R"({"a": 2, "b": "y", "c": {"d": 2, "e": false}, "f": null})",
+            R"({"a": 1.5, "c": {"d": 3.5}, "f": "z"})",
+            R"({"a": "s", "b": 10, "g": [1, 2, 3]})",
+            R"({"a": true, "f": 7})",
+            R"({})",
+            ""};
+
+    auto column = ColumnObject::create(true);
+    auto expected = ColumnObject::create(true);
+    JSONToVariantParser parser;
+    JSONDataParser<SimdJSONParser> field_parser;
+    for (const auto& doc : docs) {
+        EXPECT_TRUE(parser.parse(*column, StringRef(doc)).ok());
+        EXPECT_TRUE(parse_json_to_variant(*expected, StringRef(doc), &field_parser).ok());
+    }
+    column->finalize();
+    expected->finalize();
+
+    ASSERT_EQ(expected->size(), column->size());
+    ASSERT_EQ(expected->get_keys_str(), column->get_keys_str());
+    for (const auto& path : expected->getKeys()) {
+        const auto* expected_subcolumn = expected->get_subcolumn(path);
+        const auto* subcolumn = column->get_subcolumn(path);
+        ASSERT_NE(subcolumn, nullptr);
+        EXPECT_TRUE(expected_subcolumn->get_least_common_type()->equals(
+                *subcolumn->get_least_common_type()));
+        const auto& expected_data = expected_subcolumn->get_finalized_column();
+        const auto& data = subcolumn->get_finalized_column();
+        for (size_t i = 0; i < expected->size(); ++i) {
+            EXPECT_EQ(expected_data[i], data[i]) << path.get_path() << ", row " << i;
+        }
+    }
+}
+
+TEST(JSONToVariantParserTest, InvalidDocument) {
+    auto column = ColumnObject::create(true);
+    JSONToVariantParser parser;
+    EXPECT_TRUE(parser.parse(*column, StringRef(std::string(R"({"a": 1})"))).ok());
+    std::string invalid = R"({"a": )";
+    EXPECT_FALSE(parser.parse(*column, StringRef(invalid)).ok());
+    std::string ambiguous = R"({"a": 1, "a": 2})";
+    EXPECT_FALSE(parser.parse(*column, StringRef(ambiguous)).ok());
+}
+
+} // namespace doris::vectorized
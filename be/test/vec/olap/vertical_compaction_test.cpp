@@ -36,6 +36,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gtest/gtest_pred_impl.h"
 #include "gutil/stringprintf.h"
@@ -61,6 +62,7 @@
 #include "olap/tablet_meta.h"
 #include "olap/tablet_schema.h"
 #include "olap/utils.h"
+#include "util/threadpool.h"
 #include "util/uid_util.h"
 #include "vec/columns/column.h"
 #include "vec/core/block.h"
@@ -387,6 +389,60 @@ protected:
         }
     }
 
+    // dup key schema of key column c1 and `num_value_columns` INT value columns
+    TabletSchemaSPtr create_wide_schema(int num_value_columns) {
+        TabletSchemaSPtr tablet_schema = std::make_shared<TabletSchema>();
+        TabletSchemaPB tablet_schema_pb;
+        tablet_schema_pb.set_keys_type(DUP_KEYS);
+        tablet_schema_pb.set_num_short_key_columns(1);
+        tablet_schema_pb.set_num_rows_per_row_block(1024);
+        tablet_schema_pb.set_compress_kind(COMPRESS_NONE);
+        tablet_schema_pb.set_next_column_unique_id(num_value_columns + 2);
+
+        for (int i = 0; i <= num_value_columns; ++i) {
+            ColumnPB* column = tablet_schema_pb.add_column();
+            column->set_unique_id(i + 1);
+            column->set_name("c" + std::to_string(i + 1));
+            column->set_type("INT");
+            column->set_is_key(i == 0);
+            column->set_length(4);
+            column->set_index_length(4);
+            column->set_is_nullable(false);
+            column->set_is_bf_column(false);
+        }
+
+        tablet_schema->init_from_pb(tablet_schema_pb);
+        return tablet_schema;
+    }
+
+    // value column k of a row (c1, c2) is c2 * k
+    RowsetSharedPtr create_wide_rowset(
+            TabletSchemaSPtr tablet_schema, const SegmentsOverlapPB& overlap,
+            const std::vector<std::vector<std::tuple<int64_t, int64_t>>>& rowset_data) {
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(tablet_schema, overlap, UINT32_MAX, &writer_context);
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(writer_context, false, &rowset_writer).ok());
+
+        for (const auto& segment_data : rowset_data) {
+            vectorized::Block block = tablet_schema->create_block();
+            auto columns = block.mutate_columns();
+            for (const auto& row : segment_data) {
+                int32_t c1 = std::get<0>(row);
+                columns[0]->insert_data((const char*)&c1, sizeof(c1));
+                for (size_t k = 1; k < columns.size(); ++k) {
+                    int32_t value = static_cast<int32_t>(std::get<1>(row) * k);
+                    columns[k]->insert_data((const char*)&value, sizeof(value));
+                }
+            }
+            EXPECT_TRUE(rowset_writer->add_block(&block).ok());
+            EXPECT_TRUE(rowset_writer->flush().ok());
+        }
+        RowsetSharedPtr rowset = rowset_writer->build();
+        EXPECT_TRUE(rowset != nullptr);
+        return rowset;
+    }
+
 private:
     const std::string kTestDir = "/ut_dir/vertical_compaction_test";
     string absolute_dir;
@@ -449,6 +505,51 @@ TEST_F(VerticalCompactionTest, TestRowSourcesBuffer) {
     }
 }
 
+TEST_F(VerticalCompactionTest, TestRowSourcesBufferCloneForRead) {
+    std::vector<RowSource> tmp_row_source;
+    for (uint16_t i = 0; i < 6; ++i) {
+        tmp_row_source.emplace_back(i / 2, false);
+    }
+    // test both in memory buffer and spilled buffer file
+    auto ori_memory_mb = config::vertical_compaction_max_row_source_memory_mb;
+    for (int32_t memory_mb : {ori_memory_mb, 0}) {
+        config::vertical_compaction_max_row_source_memory_mb = memory_mb;
+        RowSourcesBuffer buffer(102, absolute_dir, READER_CUMULATIVE_COMPACTION);
+        EXPECT_TRUE(buffer.append(tmp_row_source).ok());
+        EXPECT_TRUE(buffer.append(tmp_row_source).ok());
+        EXPECT_TRUE(buffer.flush().ok());
+        EXPECT_TRUE(buffer.seek_to_begin().ok());
+
+        std::unique_ptr<RowSourcesBuffer> reader1;
+        std::unique_ptr<RowSourcesBuffer> reader2;
+        EXPECT_TRUE(buffer.clone_for_read(&reader1).ok());
+        EXPECT_TRUE(buffer.clone_for_read(&reader2).ok());
+        EXPECT_EQ(reader1->total_size(), 12);
+
+        // interleaved reads from the clones don't affect each other
+        std::vector<uint16_t> sources1;
+        std::vector<uint16_t> sources2;
+        while (reader1->has_remaining().ok()) {
+            sources1.push_back(reader1->current().get_source_num());
+            reader1->advance();
+            if (reader2->has_remaining().ok()) {
+                sources2.push_back(reader2->current().get_source_num());
+                reader2->advance();
+            }
+        }
+        while (reader2->has_remaining().ok()) {
+            sources2.push_back(reader2->current().get_source_num());
+            reader2->advance();
+        }
+        EXPECT_EQ(sources1.size(), 12);
+        EXPECT_EQ(sources1, sources2);
+        for (size_t i = 0; i < sources1.size(); ++i) {
+            EXPECT_EQ(sources1[i], (i % 6) / 2);
+        }
+    }
+    config::vertical_compaction_max_row_source_memory_mb = ori_memory_mb;
+}
+
 TEST_F(VerticalCompactionTest, TestDupKeyVerticalMerge) {
     auto num_input_rowset = 2;
     auto num_segments = 2;
@@ -853,5 +954,98 @@ TEST_F(VerticalCompactionTest, TestAggKeyVerticalMerge) {
     }
 }
 
+TEST_F(VerticalCompactionTest, TestParallelValueGroupMerge) {
+    auto num_input_rowset = 3;
+    auto num_segments = 2;
+    auto rows_per_segment = 100;
+    auto num_value_columns = 4;
+    SegmentsOverlapPB overlap = OVERLAPPING;
+    std::vector<std::vector<std::vector<std::tuple<int64_t, int64_t>>>> input_data;
+    generate_input_data(num_input_rowset, num_segments, rows_per_segment, overlap, input_data);
+
+    TabletSchemaSPtr tablet_schema = create_wide_schema(num_value_columns);
+    vector<RowsetSharedPtr> input_rowsets;
+    for (auto i = 0; i < num_input_rowset; i++) {
+        input_rowsets.push_back(create_wide_rowset(tablet_schema, overlap, input_data[i]));
+    }
+
+    auto ori_columns_per_group = config::vertical_compaction_num_columns_per_group;
+    auto ori_max_parallel_groups = config::vertical_compaction_max_parallel_groups;
+    // one column per group, so there are a key group and 4 value groups
+    config::vertical_compaction_num_columns_per_group = 1;
+    EXPECT_TRUE(ThreadPoolBuilder("VerticalCompactionGroupThreadPool")
+                        .set_min_threads(2)
+                        .set_max_threads(2)
+                        .build(&k_engine->_vertical_compaction_thread_pool)
+                        .ok());
+
+    auto merge = [&](int max_parallel_groups) {
+        config::vertical_compaction_max_parallel_groups = max_parallel_groups;
+        vector<RowsetReaderSharedPtr> input_rs_readers;
+        for (auto& rowset : input_rowsets) {
+            RowsetReaderSharedPtr rs_reader;
+            EXPECT_TRUE(rowset->create_reader(&rs_reader).ok());
+            input_rs_readers.push_back(std::move(rs_reader));
+        }
+        RowsetWriterContext writer_context;
+        create_rowset_writer_context(tablet_schema, NONOVERLAPPING, 3456, &writer_context);
+        std::unique_ptr<RowsetWriter> output_rs_writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(writer_context, true, &output_rs_writer)
+                            .ok());
+        TabletSharedPtr tablet =
+                create_tablet(*tablet_schema, false, output_rs_writer->version().first - 1, false);
+        Merger::Statistics stats;
+        RowIdConversion rowid_conversion;
+        stats.rowid_conversion = &rowid_conversion;
+        EXPECT_TRUE(Merger::vertical_merge_rowsets(tablet, READER_BASE_COMPACTION, tablet_schema,
+                                                   input_rs_readers, output_rs_writer.get(), 100,
+                                                   &stats)
+                            .ok());
+        RowsetSharedPtr out_rowset = output_rs_writer->build();
+
+        RowsetReaderContext reader_context;
+        reader_context.tablet_schema = tablet_schema;
+        reader_context.need_ordered_result = false;
+        std::vector<uint32_t> return_columns;
+        for (int i = 0; i <= num_value_columns; ++i) {
+            return_columns.push_back(i);
+        }
+        reader_context.return_columns = &return_columns;
+        RowsetReaderSharedPtr output_rs_reader;
+        create_and_init_rowset_reader(out_rowset.get(), reader_context, &output_rs_reader);
+
+        std::vector<std::vector<int64_t>> output_data;
+        vectorized::Block output_block;
+        Status s;
+        do {
+            block_create(tablet_schema, &output_block);
+            s = output_rs_reader->next_block(&output_block);
+            auto columns = output_block.get_columns_with_type_and_name();
+            for (auto i = 0; i < output_block.rows(); i++) {
+                std::vector<int64_t> row;
+                for (auto& column : columns) {
+                    row.push_back(column.column->get_int(i));
+                }
+                output_data.push_back(std::move(row));
+            }
+        } while (s == Status::OK());
+        EXPECT_EQ(Status::Error<END_OF_FILE>(), s);
+        return output_data;
+    };
+
+    auto serial_output = merge(1);
+    auto parallel_output = merge(3);
+    config::vertical_compaction_num_columns_per_group = ori_columns_per_group;
+    config::vertical_compaction_max_parallel_groups = ori_max_parallel_groups;
+
+    EXPECT_EQ(serial_output.size(), num_input_rowset * num_segments * rows_per_segment);
+    EXPECT_EQ(serial_output, parallel_output);
+    for (auto& row : parallel_output) {
+        for (size_t k = 1; k < row.size(); ++k) {
+            EXPECT_EQ(row[k], (row[0] + 1) * static_cast<int64_t>(k));
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace doris
@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/runtime/shared_hash_table_controller.h"
+
+#include <gen_cpp/Types_types.h>
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest_pred_impl.h"
+#include "runtime/runtime_state.h"
+
+namespace doris::vectorized {
+
+static TUniqueId instance_id(int64_t lo) {
+    TUniqueId id;
+    id.__set_hi(1);
+    id.__set_lo(lo);
+    return id;
+}
+
+// The first instance of a broadcast join over the build size threshold builds the hash table,
+// the instances which cross the threshold before it's built wait for it.
+TEST(SharedHashTableControllerTest, ShareHashTableAtRuntime) {
+    SharedHashTableController controller;
+    const int node_id = 3;
+
+    SharedHashTableContextPtr builder_context;
+    EXPECT_TRUE(controller.share_hash_table_at_runtime(instance_id(1), node_id, &builder_context));
+    ASSERT_NE(builder_context, nullptr);
+    EXPECT_EQ(instance_id(1), controller.get_builder_fragment_instance_id(node_id));
+
+    SharedHashTableContextPtr consumer_context;
+    EXPECT_FALSE(
+            controller.share_hash_table_at_runtime(instance_id(2), node_id, &consumer_context));
+    EXPECT_EQ(builder_context, consumer_context);
+
+    // other join nodes are not affected
+    SharedHashTableContextPtr other_context;
+    EXPECT_TRUE(controller.share_hash_table_at_runtime(instance_id(2), node_id + 1,
+                                                       &other_context));
+    EXPECT_NE(other_context, builder_context);
+
+    std::thread builder([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        builder_context->status = Status::OK();
+        controller.signal(node_id);
+    });
+    RuntimeState state;
+    EXPECT_TRUE(controller.wait_for_signal(&state, consumer_context).ok());
+    EXPECT_TRUE(consumer_context->signaled);
+    builder.join();
+
+    // the hash table is built already, a late instance builds its own
+    SharedHashTableContextPtr late_context;
+    EXPECT_TRUE(controller.share_hash_table_at_runtime(instance_id(3), node_id, &late_context));
+    EXPECT_EQ(late_context, nullptr);
+}
+
+// Consumers fail with the status of the builder
+TEST(SharedHashTableControllerTest, ShareHashTableAtRuntimeBuilderFailed) {
+    SharedHashTableController controller;
+    const int node_id = 5;
+
+    SharedHashTableContextPtr builder_context;
+    EXPECT_TRUE(controller.share_hash_table_at_runtime(instance_id(1), node_id, &builder_context));
+    SharedHashTableContextPtr consumer_context;
+    EXPECT_FALSE(
+            controller.share_hash_table_at_runtime(instance_id(2), node_id, &consumer_context));
+
+    controller.signal(node_id, Status::Cancelled("builder cancelled"));
+    RuntimeState state;
+    EXPECT_TRUE(controller.wait_for_signal(&state, consumer_context).is<ErrorCode::CANCELLED>());
+}
+
+} // namespace doris::vectorized
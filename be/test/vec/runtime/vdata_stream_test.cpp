@@ -21,6 +21,7 @@
 #include <gen_cpp/PaloInternalService_types.h>
 #include <gen_cpp/Partitions_types.h>
 #include <gen_cpp/Types_types.h>
+#include <gen_cpp/segment_v2.pb.h>
 #include <glog/logging.h>
 #include <gtest/gtest-message.h>
 #include <gtest/gtest-test-part.h>
@@ -32,6 +33,7 @@
 #include <utility>
 #include <vector>
 
+#include "agent/be_exec_version_manager.h"
 #include "common/global_types.h"
 #include "common/object_pool.h"
 #include "common/status.h"
@@ -48,6 +50,7 @@
 #include "util/proto_util.h"
 #include "util/runtime_profile.h"
 #include "util/uid_util.h"
+#include "vec/common/assert_cast.h"
 #include "vec/columns/column_vector.h"
 #include "vec/core/block.h"
 #include "vec/core/column_with_type_and_name.h"
@@ -220,4 +223,50 @@ TEST_F(VDataStreamTest, BasicTest) {
     sender.close(&runtime_stat, exec_status);
     recv->close();
 }
+
+// The pipeline engine sends the column values of a broadcasted block as brpc attachment,
+// which is shared by the requests to all channels, and the receiver restores the block.
+TEST_F(VDataStreamTest, BroadcastBlockAttachmentRoundTrip) {
+    auto vec = vectorized::ColumnVector<Int32>::create();
+    auto& data = vec->get_data();
+    for (int i = 0; i < 1024; ++i) {
+        data.push_back(i);
+    }
+    vectorized::DataTypePtr data_type(std::make_shared<vectorized::DataTypeInt32>());
+    vectorized::ColumnWithTypeAndName type_and_name(vec->get_ptr(), data_type, "test_int");
+    vectorized::Block block({type_and_name});
+
+    BroadcastPBlockHolder holder;
+    size_t uncompressed_bytes = 0;
+    size_t compressed_bytes = 0;
+    EXPECT_TRUE(block.serialize(BeExecVersionManager::get_newest_version(), holder.get_block(),
+                                &uncompressed_bytes, &compressed_bytes,
+                                segment_v2::CompressionTypePB::SNAPPY)
+                        .ok());
+    holder.move_column_values_to_attachment();
+    EXPECT_TRUE(holder.get_block()->column_values().empty());
+    EXPECT_EQ(compressed_bytes, holder.column_values_attachment().size());
+
+    for (int channel = 0; channel < 2; ++channel) {
+        PTransmitDataParams request;
+        request.mutable_block()->CopyFrom(*holder.get_block());
+        request.set_transfer_by_attachment(true);
+        brpc::Controller cntl;
+        cntl.request_attachment().append(holder.column_values_attachment());
+        // the request references the blocks of the holder's attachment instead of a copy
+        EXPECT_EQ(holder.column_values_attachment().backing_block(0).data(),
+                  cntl.request_attachment().backing_block(0).data());
+
+        attachment_transfer_request_block<PTransmitDataParams>(&request, &cntl);
+        vectorized::Block received(request.block());
+        EXPECT_EQ(1024, received.rows());
+        const auto& received_data =
+                assert_cast<const vectorized::ColumnVector<Int32>&>(
+                        *received.get_by_position(0).column)
+                        .get_data();
+        for (int i = 0; i < 1024; ++i) {
+            EXPECT_EQ(i, received_data[i]);
+        }
+    }
+}
 } // namespace doris::vectorized
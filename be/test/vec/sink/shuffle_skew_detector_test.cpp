@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "vec/sink/shuffle_skew_detector.h"
+
+#include <gtest/gtest-message.h>
+#include <gtest/gtest-test-part.h>
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest_pred_impl.h"
+
+namespace doris::vectorized {
+
+TEST(ShuffleSkewDetectorTest, FindHotKeys) {
+    std::mt19937_64 rng(42);
+    // 30% of rows have key 1, 15% have key 2, the others are distinct keys
+    std::vector<uint64_t> hashes(100000);
+    for (auto& hash : hashes) {
+        auto r = rng() % 100;
+        hash = r < 30 ? 1 : (r < 45 ? 2 : rng() | 0x100);
+    }
+    ShuffleSkewDetector detector(64, 4);
+    // feed in blocks whose sizes are not multiples of the sample interval
+    for (size_t begin = 0; begin < hashes.size(); begin += 4093) {
+        detector.add(hashes.data() + begin, std::min<size_t>(4093, hashes.size() - begin));
+    }
+    EXPECT_EQ(25000, detector.num_sampled_rows());
+
+    auto hot_keys = detector.heavy_hitters(0.1);
+    ASSERT_EQ(2, hot_keys.size());
+    EXPECT_EQ(1, hot_keys[0].hash);
+    EXPECT_NEAR(0.3, hot_keys[0].fraction, 0.03);
+    EXPECT_EQ(2, hot_keys[1].hash);
+    EXPECT_NEAR(0.15, hot_keys[1].fraction, 0.03);
+}
+
+TEST(ShuffleSkewDetectorTest, NoSkew) {
+    std::vector<uint64_t> hashes(10000);
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        hashes[i] = i;
+    }
+    ShuffleSkewDetector detector(64, 1);
+    EXPECT_TRUE(detector.heavy_hitters(0.1).empty());
+    detector.add(hashes.data(), hashes.size());
+    EXPECT_EQ(10000, detector.num_sampled_rows());
+    EXPECT_TRUE(detector.heavy_hitters(0.1).empty());
+}
+
+} // namespace doris::vectorized
@@ -1548,6 +1548,14 @@ public class Config extends ConfigBase {
     @ConfField(mutable = true)
     public static long remote_fragment_exec_timeout_ms = 5000; // 5 sec
 
+    /**
+     * If set true, the coordinator sends the digest of the descriptor table of a query with its fragments,
+     * so that backends reuse the descriptor table built for an earlier query with the same digest.
+     * Computing the digest serializes the descriptor table of every query once more.
+     */
+    @ConfField(mutable = true)
+    public static boolean enable_desc_tbl_digest = false;
+
     /**
      * Max data version of backends serialize block.
      */
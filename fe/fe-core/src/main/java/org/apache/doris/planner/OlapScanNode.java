@@ -75,6 +75,7 @@ import org.apache.doris.thrift.TPlanNode;
 import org.apache.doris.thrift.TPlanNodeType;
 import org.apache.doris.thrift.TPrimitiveType;
 import org.apache.doris.thrift.TPushAggOp;
+import org.apache.doris.thrift.TQueryOptions;
 import org.apache.doris.thrift.TScanRange;
 import org.apache.doris.thrift.TScanRangeLocation;
 import org.apache.doris.thrift.TScanRangeLocations;
@@ -88,9 +89,14 @@ import com.google.common.collect.ArrayListMultimap;
 import com.google.common.collect.Lists;
 import com.google.common.collect.Maps;
 import com.google.common.collect.Sets;
+import com.google.common.hash.Hasher;
+import com.google.common.hash.Hashing;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
+import org.apache.thrift.TException;
+import org.apache.thrift.TSerializer;
 
+import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
 import java.util.Collection;
 import java.util.Collections;
@@ -1309,6 +1315,67 @@ public class OlapScanNode extends ScanNode {
         }
     }
 
+    /**
+     * Set the digest of the scan, BE caches the output of the scan on a tablet with the digest, the tablet and
+     * the version. The digest covers the scan node with everything pushed down into it, the layout of its
+     * tuples, the time zone and the query options which change the output, which are all the output depends
+     * on besides the tablet. BE doesn't use the cache if runtime filters may be applied to the scan.
+     */
+    public void setResultCacheDigest(TPlanNode msg) {
+        ConnectContext context = ConnectContext.get();
+        if (context == null || !context.getSessionVariable().isEnableIntermediateResultCache()
+                || msg.isSetRuntimeFilters()) {
+            return;
+        }
+        try {
+            TSerializer serializer = new TSerializer();
+            Hasher hasher = Hashing.murmur3_128().newHasher();
+            hasher.putBytes(serializer.serialize(msg));
+            List<TupleDescriptor> tuples = Lists.newArrayList(desc);
+            if (outputTupleDesc != null) {
+                tuples.add(outputTupleDesc);
+            }
+            for (TupleDescriptor tuple : tuples) {
+                hasher.putBytes(serializer.serialize(tuple.toThrift()));
+                for (SlotDescriptor slot : tuple.getSlots()) {
+                    if (slot.isMaterialized()) {
+                        hasher.putBytes(serializer.serialize(slot.toThrift()));
+                    }
+                }
+            }
+            hasher.putString(context.getSessionVariable().getTimeZone(), StandardCharsets.UTF_8);
+            hasher.putBytes(serializer.serialize(
+                    getResultCacheQueryOptions(context.getSessionVariable().toThrift())));
+            // how the rows of a rowset are merged by the storage, which the output cached per rowset depends on
+            MaterializedIndexMeta indexMeta = olapTable.getIndexMetaByIndexId(selectedIndexId);
+            if (indexMeta != null) {
+                hasher.putInt(indexMeta.getSchemaVersion());
+            }
+            hasher.putBoolean(olapTable.getEnableUniqueKeyMergeOnWrite());
+            msg.olap_scan_node.setResultCacheDigest(hasher.hash().asLong());
+        } catch (TException e) {
+            LOG.warn("failed to compute the result cache digest of scan node {}, {}", id, e.getMessage());
+        }
+    }
+
+    // The query options which change the output of the scan, a new option of this kind must be added here.
+    // The other options, e.g. resources and timeouts, don't change the output, so the cache is shared by the
+    // queries which differ in them.
+    private static TQueryOptions getResultCacheQueryOptions(TQueryOptions queryOptions) {
+        TQueryOptions options = new TQueryOptions();
+        // the format of the blocks and the behavior of the functions evaluated by the scan
+        options.setBeExecVersion(queryOptions.getBeExecVersion());
+        options.setReturnObjectDataAsBinary(queryOptions.isReturnObjectDataAsBinary());
+        options.setCheckOverflowForDecimal(queryOptions.isCheckOverflowForDecimal());
+        options.setEnableFunctionPushdown(queryOptions.isEnableFunctionPushdown());
+        options.setEnableCommonExprPushdown(queryOptions.isEnableCommonExprPushdown());
+        // whether the rows are merged by the storage, BE doesn't use the cache if any of them is set
+        options.setSkipStorageEngineMerge(queryOptions.isSkipStorageEngineMerge());
+        options.setSkipDeletePredicate(queryOptions.isSkipDeletePredicate());
+        options.setSkipDeleteBitmap(queryOptions.isSkipDeleteBitmap());
+        return options;
+    }
+
     // export some tablets
     public static OlapScanNode createOlapScanNodeByLocation(
             PlanNodeId id, TupleDescriptor desc, String planNodeName, List<TScanRangeLocations> locationsList) {
@@ -608,6 +608,10 @@ public abstract class PlanNode extends TreeNode<PlanNode> implements PlanStats {
         if (outputTupleDesc != null) {
             msg.setOutputTupleId(outputTupleDesc.getId().asInt());
         }
+        if (this instanceof OlapScanNode) {
+            // the digest covers the conjuncts and projections set above
+            ((OlapScanNode) this).setResultCacheDigest(msg);
+        }
         if (this instanceof ExchangeNode) {
             msg.num_children = 0;
             return;
@@ -123,6 +123,7 @@ import org.apache.commons.lang3.tuple.Triple;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
 import org.apache.thrift.TException;
+import org.apache.thrift.TSerializer;
 import org.jetbrains.annotations.NotNull;
 
 import java.nio.charset.StandardCharsets;
@@ -170,6 +171,8 @@ public class Coordinator {
 
     // copied from TQueryExecRequest; constant across all fragments
     private final TDescriptorTable descTable;
+    // digest of descTable, null if not computed
+    private final Long descTblDigest;
 
     // Why do we use query global?
     // When `NOW()` function is in sql, we need only one now(),
@@ -323,6 +326,7 @@ public class Coordinator {
         } else {
             this.descTable = planner.getDescTable().toThrift();
         }
+        this.descTblDigest = computeDescTblDigest(descTable);
 
         this.returnedAllResults = false;
         this.enableShareHashTableForBroadcastJoin = context.getSessionVariable().enableShareHashTableForBroadcastJoin;
@@ -357,6 +361,7 @@ public class Coordinator {
         this.jobId = jobId;
         this.queryId = queryId;
         this.descTable = descTable.toThrift();
+        this.descTblDigest = computeDescTblDigest(this.descTable);
         this.fragments = fragments;
         this.scanNodes = scanNodes;
         this.queryOptions = new TQueryOptions();
@@ -372,6 +377,20 @@ public class Coordinator {
         this.executionProfile = new ExecutionProfile(queryId, fragments.size());
     }
 
+    // Backends build the descriptor table once for the queries with the same digest. They only
+    // check the numbers of descriptors on a hit, so the digest must be a strong hash of the table.
+    private static Long computeDescTblDigest(TDescriptorTable descTable) {
+        if (!Config.enable_desc_tbl_digest) {
+            return null;
+        }
+        try {
+            return Hashing.murmur3_128().hashBytes(new TSerializer().serialize(descTable)).asLong();
+        } catch (TException e) {
+            LOG.warn("failed to serialize descriptor table, {}", e.getMessage());
+            return null;
+        }
+    }
+
     private void setFromUserProperty(ConnectContext connectContext) {
         String qualifiedUser = connectContext.getQualifiedUser();
         // set cpu resource limit
@@ -2546,6 +2565,7 @@ public class Coordinator {
          */
         public void unsetFields() {
             this.rpcParams.unsetDescTbl();
+            this.rpcParams.unsetDescTblDigest();
             this.rpcParams.unsetCoord();
             this.rpcParams.unsetQueryGlobals();
             this.rpcParams.unsetResourceInfo();
@@ -2694,6 +2714,7 @@ public class Coordinator {
          */
         public void unsetFields() {
             this.rpcParams.unsetDescTbl();
+            this.rpcParams.unsetDescTblDigest();
             this.rpcParams.unsetCoord();
             this.rpcParams.unsetQueryGlobals();
             this.rpcParams.unsetResourceInfo();
@@ -3028,6 +3049,9 @@ public class Coordinator {
                 params.setProtocolVersion(PaloInternalServiceVersion.V1);
                 params.setFragment(fragment.toThrift());
                 params.setDescTbl(descTable);
+                if (descTblDigest != null) {
+                    params.setDescTblDigest(descTblDigest);
+                }
                 params.setParams(new TPlanFragmentExecParams());
                 params.setBuildHashTableForBroadcastJoin(instanceExecParam.buildHashTableForBroadcastJoin);
                 params.params.setQueryId(queryId);
@@ -3104,6 +3128,9 @@ public class Coordinator {
                     // Set global param
                     params.setProtocolVersion(PaloInternalServiceVersion.V1);
                     params.setDescTbl(descTable);
+                    if (descTblDigest != null) {
+                        params.setDescTblDigest(descTblDigest);
+                    }
                     params.setQueryId(queryId);
                     params.setPerExchNumSenders(perExchNumSenders);
                     params.setDestinations(destinations);
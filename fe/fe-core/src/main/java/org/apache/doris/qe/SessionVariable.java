@@ -271,6 +271,8 @@ public class SessionVariable implements Serializable, Writable {
     public static final String ENABLE_SHARE_HASH_TABLE_FOR_BROADCAST_JOIN
             = "enable_share_hash_table_for_broadcast_join";
 
+    public static final String ENABLE_INTERMEDIATE_RESULT_CACHE = "enable_intermediate_result_cache";
+
     // support unicode in label, table, column, common name check
     public static final String ENABLE_UNICODE_NAME_SUPPORT = "enable_unicode_name_support";
 
@@ -741,9 +743,9 @@ public class SessionVariable implements Serializable, Writable {
     @VariableMgr.VarAttr(name = PARTITIONED_HASH_JOIN_ROWS_THRESHOLD, fuzzy = true)
     public int partitionedHashJoinRowsThreshold = 0;
 
-    // Use partitioned hash join if build side row count >= the threshold . 0 - the threshold is not set.
+    // Use partitioned hash table in merge aggregation if group count >= the threshold. 0 - not set.
     @VariableMgr.VarAttr(name = PARTITIONED_HASH_AGG_ROWS_THRESHOLD, fuzzy = true)
-    public int partitionedHashAggRowsThreshold = 0;
+    public int partitionedHashAggRowsThreshold = 1048576;
 
     @VariableMgr.VarAttr(name = PARTITION_PRUNING_EXPAND_THRESHOLD, fuzzy = true)
     public int partitionPruningExpandThreshold = 10;
@@ -751,6 +753,11 @@ public class SessionVariable implements Serializable, Writable {
     @VariableMgr.VarAttr(name = ENABLE_SHARE_HASH_TABLE_FOR_BROADCAST_JOIN, fuzzy = true)
     public boolean enableShareHashTableForBroadcastJoin = true;
 
+    // If set true, olap scan nodes carry a digest of their plan, so that BE caches the output of the
+    // scans per tablet and version, see BE config intermediate_result_cache_mem_limit.
+    @VariableMgr.VarAttr(name = ENABLE_INTERMEDIATE_RESULT_CACHE)
+    public boolean enableIntermediateResultCache = false;
+
     @VariableMgr.VarAttr(name = ENABLE_UNICODE_NAME_SUPPORT)
     public boolean enableUnicodeNameSupport = false;
 
@@ -1608,6 +1615,10 @@ public class SessionVariable implements Serializable, Writable {
         return enableUnicodeNameSupport;
     }
 
+    public boolean isEnableIntermediateResultCache() {
+        return enableIntermediateResultCache;
+    }
+
     public void setEnableUnicodeNameSupport(boolean enableUnicodeNameSupport) {
         this.enableUnicodeNameSupport = enableUnicodeNameSupport;
     }
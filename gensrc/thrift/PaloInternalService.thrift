@@ -193,7 +193,7 @@ struct TQueryOptions {
   59: optional i64 external_sort_bytes_threshold = 0
 
   // deprecated
-  60: optional i32 partitioned_hash_agg_rows_threshold = 0
+  60: optional i32 partitioned_hash_agg_rows_threshold = 1048576
 
   61: optional bool enable_file_cache = true
   
@@ -419,6 +419,10 @@ struct TExecPlanFragmentParams {
   21: optional bool build_hash_table_for_broadcast_join = false;
 
   22: optional list<Types.TUniqueId> instances_sharing_hash_table;
+
+  // Digest of desc_tbl. If set, BE caches the descriptor table built from desc_tbl
+  // and shares it with the later queries with the same digest.
+  23: optional i64 desc_tbl_digest
 }
 
 struct TExecPlanFragmentParamsList {
@@ -629,6 +633,8 @@ struct TPipelineFragmentParams {
   23: optional Planner.TPlanFragment fragment
   24: list<TPipelineInstanceParams> local_params
   26: optional list<TPipelineResourceGroup> resource_groups
+  // Digest of desc_tbl, see TExecPlanFragmentParams.desc_tbl_digest
+  27: optional i64 desc_tbl_digest
 }
 
 struct TPipelineFragmentParamsList {
@@ -582,6 +582,9 @@ struct TOlapScanNode {
   14: optional list<Descriptors.TOlapTableIndex> indexes_desc
   15: optional set<i32> output_column_unique_ids
   16: optional list<i32> distribute_column_ids
+  // digest of the scan and everything pushed down into it, if set, the output of the scan
+  // on one tablet is cached by BE with the digest, the tablet and the version
+  17: optional i64 result_cache_digest
 }
 
 struct TEqJoinCondition {